@@ -0,0 +1,295 @@
+/**
+ * @file arena.h
+ *
+ * A monotonic memory resource and the allocator adaptor containers use to draw from it.
+ */
+
+#pragma once
+
+// Used for ::operator new and ::operator delete.
+#include <new>
+
+// Used for std::forward().
+#include <utility>
+
+// Used for uintptr_t.
+#include <cstdint>
+
+// ptrdiff_t and size_t definitions.
+#include <cstddef>
+
+/**
+ * @class Arena
+ *
+ * @brief Monotonic resource handing out memory by bumping a pointer through large chunks
+ *
+ * Memory is never given back one block at a time: reset() releases everything allocated
+ * so far at once, at a cost proportional to the number of chunks rather than the number
+ * of allocations. Chunks grow geometrically, so a busy arena ends up with few of them.
+ *
+ * Containers drawing from an Arena must be destroyed (or never used again) before reset().
+ */
+class Arena {
+    private:
+        /** @brief Header placed at the start of every chunk */
+        struct Chunk {
+            Chunk* previous;
+            size_t size;
+        };
+
+        /** @brief The chunk being carved, linked to the older ones */
+        Chunk* current;
+
+        /** @brief Next free byte and end of the current chunk */
+        char* position;
+        char* end;
+
+        /** @brief Size of the next chunk to be requested */
+        size_t next_size;
+
+        /** @brief Size of the first chunk, the one reset() keeps */
+        size_t initial_size;
+
+        void add_chunk(size_t bytes, size_t alignment);
+
+    public:
+        /**
+         * @param initial_size size in bytes of the first chunk, later ones double
+         */
+        explicit Arena(size_t initial_size = 4096);
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /** @brief Releases every chunk */
+        ~Arena();
+
+        /**
+         * @brief Returns @b bytes of memory aligned to @b alignment
+         *
+         * @throw std::bad_alloc if a new chunk can not be allocated
+         */
+        void* allocate(size_t bytes, size_t alignment);
+
+        /**
+         * @brief Grows or shrinks the most recent allocation in place
+         *
+         * @return
+         *      @b block if it was the last block handed out and the chunk has room
+         *
+         *      nullptr otherwise, in which case nothing changes
+         */
+        void* reallocate(void* block, size_t bytes, size_t new_bytes);
+
+        /**
+         * @brief Releases everything allocated from the arena
+         *
+         * The first chunk is kept and reused, the rest are freed.
+         */
+        void reset();
+};
+
+inline Arena::Arena(size_t initial_size) {
+    this->current = nullptr;
+
+    this->position = nullptr;
+    this->end = nullptr;
+
+    this->initial_size = (initial_size > sizeof(Chunk)) ? initial_size : 2 * sizeof(Chunk);
+    this->next_size = this->initial_size;
+}
+
+inline Arena::~Arena() {
+    while (this->current != nullptr) {
+        Chunk* previous = this->current->previous;
+
+        ::operator delete(this->current);
+
+        this->current = previous;
+    }
+}
+
+inline void Arena::add_chunk(size_t bytes, size_t alignment) {
+    size_t size = this->next_size;
+
+    // Requests larger than a chunk get one of their own, sized to fit.
+    if (size - sizeof(Chunk) < bytes + alignment)
+        size = sizeof(Chunk) + bytes + alignment;
+
+    Chunk* chunk = static_cast<Chunk*>(::operator new(size));
+
+    chunk->previous = this->current;
+    chunk->size = size;
+
+    this->current = chunk;
+
+    this->position = reinterpret_cast<char*>(chunk + 1);
+    this->end = reinterpret_cast<char*>(chunk) + size;
+
+    this->next_size *= 2;
+}
+
+inline void* Arena::allocate(size_t bytes, size_t alignment) {
+    if (bytes > size_t(-1) / 4)
+        throw std::bad_alloc();
+
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(this->position) + alignment - 1) & ~(alignment - 1);
+
+    if (this->current == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(this->end)) {
+        this->add_chunk(bytes, alignment);
+
+        aligned = (reinterpret_cast<uintptr_t>(this->position) + alignment - 1) & ~(alignment - 1);
+    }
+
+    this->position = reinterpret_cast<char*>(aligned + bytes);
+
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void* Arena::reallocate(void* block, size_t bytes, size_t new_bytes) {
+    char* start = static_cast<char*>(block);
+
+    if (start + bytes != this->position || new_bytes > static_cast<size_t>(this->end - start))
+        return nullptr;
+
+    this->position = start + new_bytes;
+
+    return block;
+}
+
+inline void Arena::reset() {
+    if (this->current == nullptr)
+        return;
+
+    while (this->current->previous != nullptr) {
+        Chunk* previous = this->current->previous;
+
+        ::operator delete(this->current);
+
+        this->current = previous;
+    }
+
+    this->position = reinterpret_cast<char*>(this->current + 1);
+    this->end = reinterpret_cast<char*>(this->current) + this->current->size;
+
+    this->next_size = 2 * this->current->size;
+}
+
+/**
+ * @tparam ItemType the type of item the allocated blocks hold
+ */
+template <typename ItemType>
+/**
+ * @class ArenaAllocator
+ *
+ * @brief Allocator adaptor drawing every block from an Arena
+ *
+ * deallocate() is a no-op, the memory comes back with Arena::reset(). A Vector whose block
+ * was the last one handed out grows in place through reallocate().
+ */
+class ArenaAllocator {
+    template <typename OtherType>
+    friend class ArenaAllocator;
+
+    private:
+        Arena* arena;
+
+    public:
+        typedef ItemType            value_type;
+        typedef ItemType*           pointer;
+        typedef const ItemType*     const_pointer;
+        typedef ItemType&           reference;
+        typedef const ItemType&     const_reference;
+
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+
+        template <typename OtherType>
+        struct rebind {
+            typedef ArenaAllocator<OtherType> other;
+        };
+
+        /**
+         * @brief Builds an allocator drawing from @b arena, which has to outlive it
+         */
+        ArenaAllocator(Arena& arena);
+
+        template <typename OtherType>
+        ArenaAllocator(const ArenaAllocator<OtherType>& other);
+
+        /**
+         * @throw std::bad_alloc if the arena can not grow
+         */
+        pointer allocate(size_type size);
+
+        /** @brief Does nothing, the arena releases its memory on reset() */
+        void deallocate(pointer start, size_type size);
+
+        /**
+         * @brief Resizes the block at @b start in place if it is the arena's last one
+         *
+         * @return @b start, or nullptr if the block could not be resized
+         */
+        pointer reallocate(pointer start, size_type size, size_type new_size);
+
+        template <typename OtherType, typename... Args>
+        void construct(OtherType* position, Args&&... args);
+
+        template <typename OtherType>
+        void destroy(OtherType* position);
+
+        bool operator==(const ArenaAllocator& other) const;
+        bool operator!=(const ArenaAllocator& other) const;
+};
+
+template <typename ItemType>
+ArenaAllocator<ItemType>::ArenaAllocator(Arena& arena) {
+    this->arena = &arena;
+}
+
+template <typename ItemType>
+template <typename OtherType>
+ArenaAllocator<ItemType>::ArenaAllocator(const ArenaAllocator<OtherType>& other) {
+    this->arena = other.arena;
+}
+
+template <typename ItemType>
+typename ArenaAllocator<ItemType>::pointer ArenaAllocator<ItemType>::allocate(size_type size) {
+    if (size > size_type(-1) / 4 / sizeof(ItemType))
+        throw std::bad_alloc();
+
+    return static_cast<pointer>(this->arena->allocate(size * sizeof(ItemType), alignof(ItemType)));
+}
+
+template <typename ItemType>
+void ArenaAllocator<ItemType>::deallocate(pointer, size_type) {}
+
+template <typename ItemType>
+typename ArenaAllocator<ItemType>::pointer ArenaAllocator<ItemType>::reallocate(pointer start, size_type size, size_type new_size) {
+    if (new_size > size_type(-1) / 4 / sizeof(ItemType))
+        return nullptr;
+
+    return static_cast<pointer>(this->arena->reallocate(start, size * sizeof(ItemType), new_size * sizeof(ItemType)));
+}
+
+template <typename ItemType>
+template <typename OtherType, typename... Args>
+void ArenaAllocator<ItemType>::construct(OtherType* position, Args&&... args) {
+    ::new (static_cast<void*>(position)) OtherType(std::forward<Args>(args)...);
+}
+
+template <typename ItemType>
+template <typename OtherType>
+void ArenaAllocator<ItemType>::destroy(OtherType* position) {
+    position->~OtherType();
+}
+
+template <typename ItemType>
+bool ArenaAllocator<ItemType>::operator==(const ArenaAllocator& other) const {
+    return this->arena == other.arena;
+}
+
+template <typename ItemType>
+bool ArenaAllocator<ItemType>::operator!=(const ArenaAllocator& other) const {
+    return this->arena != other.arena;
+}
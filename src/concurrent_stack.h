@@ -0,0 +1,346 @@
+/**
+ * @file concurrent_stack.h
+ *
+ * A lock-free LIFO stack many threads can push to and pop from at once.
+ */
+
+#pragma once
+
+// Contains
+//      ConcurrentVector, the pool the nodes are drawn from
+#include "concurrent_vector.h"
+
+// Contains
+//      CACHE_LINE_SIZE
+#include "mem_tools.h"
+
+// Used for std::atomic.
+#include <atomic>
+
+// Used for uint32_t and uint64_t.
+#include <cstdint>
+
+// Used for std::move() and std::forward().
+#include <utility>
+
+// Used for std::length_error.
+#include <stdexcept>
+
+/**
+ * @tparam ItemType the type of item the stack will contain
+ */
+template <typename ItemType>
+/**
+ * @class ConcurrentStack
+ *
+ * @brief Treiber stack: a linked list of nodes whose top is swung with compare_exchange
+ *
+ * Nodes come from a ConcurrentVector and are never freed while the stack lives: a popped
+ * node goes to a free list, itself a Treiber stack, and is reused by a later push. Links
+ * are 32 bit node indices, so the top of each list packs an index and a tag into one 64 bit
+ * word; the tag changes on every update, which defeats ABA (a node popped and pushed back
+ * between another thread's read of the top and its compare_exchange) without 128 bit
+ * atomics. A thread reading a node that was just popped reads stale but valid memory, and
+ * its compare_exchange then fails.
+ *
+ * push_range() links a whole sequence privately and publishes it with one compare_exchange,
+ * pop_all() takes the whole list with one.
+ *
+ * top() is only safe while no other thread pops. At most 2^32 - 2 nodes can exist.
+ */
+class ConcurrentStack {
+    private:
+        struct Node {
+            alignas(ItemType) unsigned char storage[sizeof(ItemType)];
+
+            /** @brief Index of the next node plus one, 0 at the bottom */
+            std::atomic<uint32_t> next;
+
+            Node() : next(0) {}
+
+            ItemType* item() {
+                return reinterpret_cast<ItemType*>(this->storage);
+            }
+        };
+
+        /** @brief The items, top first, and the free nodes, as tagged tops */
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head;
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> free_head;
+
+        ConcurrentVector<Node> nodes;
+
+        static uint64_t pack(uint32_t link, uint64_t tagged);
+        static uint32_t link_of(uint64_t tagged);
+
+        Node& node(uint32_t link);
+
+        /** @brief Links [first, ..., last], already chained through next, on top of @b top */
+        void push_chain(std::atomic<uint64_t>& top, uint32_t first, uint32_t last);
+
+        /** @brief Unlinks the top node of @b top, returns its link or 0 if the list is empty */
+        uint32_t pop_node(std::atomic<uint64_t>& top);
+
+        /** @brief Takes a free node, or a new one from the pool */
+        uint32_t allocate_node();
+
+        template <typename... Args>
+        uint32_t make_node(Args&&... args);
+
+    public:
+        ConcurrentStack();
+
+        ConcurrentStack(const ConcurrentStack&) = delete;
+        ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+        /** @brief Destroys the remaining items, no thread may be using the stack */
+        ~ConcurrentStack();
+
+        bool empty() const;
+
+        void push(const ItemType& value);
+        void push(ItemType&& value);
+
+        template <typename... Args>
+        void emplace(Args&&... args);
+
+        /**
+         * @brief Pushes every item of [first, last) at once, the last one ends on top
+         */
+        template <typename InputIterator>
+        void push_range(InputIterator first, InputIterator last);
+
+        /**
+         * @brief Moves the top item into @b value and removes it
+         *
+         * @return false if the stack was empty
+         */
+        bool pop(ItemType& value);
+
+        /**
+         * @brief Removes the top item
+         *
+         * @return false if the stack was empty
+         */
+        bool pop();
+
+        /**
+         * @brief Empties the stack at once, moving its items to @b out from top to bottom
+         *
+         * @return the end of the output range
+         */
+        template <typename OutputIterator>
+        OutputIterator pop_all(OutputIterator out);
+
+        /**
+         * @brief The top item, the stack must not be empty nor popped concurrently
+         */
+        ItemType& top();
+};
+
+template <typename ItemType>
+ConcurrentStack<ItemType>::ConcurrentStack() {
+    this->head.store(0, std::memory_order_relaxed);
+    this->free_head.store(0, std::memory_order_relaxed);
+}
+
+template <typename ItemType>
+ConcurrentStack<ItemType>::~ConcurrentStack() {
+    for (uint32_t link = link_of(this->head.load(std::memory_order_acquire)); link != 0; ) {
+        Node& current = this->node(link);
+
+        current.item()->~ItemType();
+
+        link = current.next.load(std::memory_order_relaxed);
+    }
+}
+
+template <typename ItemType>
+uint64_t ConcurrentStack<ItemType>::pack(uint32_t link, uint64_t tagged) {
+    return (((tagged >> 32) + 1) << 32) | link;
+}
+
+template <typename ItemType>
+uint32_t ConcurrentStack<ItemType>::link_of(uint64_t tagged) {
+    return static_cast<uint32_t>(tagged);
+}
+
+template <typename ItemType>
+typename ConcurrentStack<ItemType>::Node& ConcurrentStack<ItemType>::node(uint32_t link) {
+    return this->nodes[link - 1];
+}
+
+template <typename ItemType>
+void ConcurrentStack<ItemType>::push_chain(std::atomic<uint64_t>& top, uint32_t first, uint32_t last) {
+    uint64_t current = top.load(std::memory_order_relaxed);
+
+    do {
+        this->node(last).next.store(link_of(current), std::memory_order_relaxed);
+    } while (!top.compare_exchange_weak(current, pack(first, current), std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename ItemType>
+uint32_t ConcurrentStack<ItemType>::pop_node(std::atomic<uint64_t>& top) {
+    uint64_t current = top.load(std::memory_order_acquire);
+
+    while (link_of(current) != 0) {
+        uint32_t next = this->node(link_of(current)).next.load(std::memory_order_relaxed);
+
+        if (top.compare_exchange_weak(current, pack(next, current), std::memory_order_acquire, std::memory_order_acquire))
+            return link_of(current);
+    }
+
+    return 0;
+}
+
+template <typename ItemType>
+uint32_t ConcurrentStack<ItemType>::allocate_node() {
+    uint32_t link = this->pop_node(this->free_head);
+
+    if (link != 0)
+        return link;
+
+    size_t index = this->nodes.emplace_back();
+
+    if (index >= uint32_t(-2))
+        throw std::length_error("ConcurrentStack exceeds 2^32 - 2 nodes");
+
+    return static_cast<uint32_t>(index + 1);
+}
+
+template <typename ItemType>
+template <typename... Args>
+uint32_t ConcurrentStack<ItemType>::make_node(Args&&... args) {
+    uint32_t link = this->allocate_node();
+
+    try {
+        ::new (static_cast<void*>(this->node(link).item())) ItemType(std::forward<Args>(args)...);
+    } catch (...) {
+        this->push_chain(this->free_head, link, link);
+
+        throw;
+    }
+
+    return link;
+}
+
+template <typename ItemType>
+bool ConcurrentStack<ItemType>::empty() const {
+    return link_of(this->head.load(std::memory_order_acquire)) == 0;
+}
+
+template <typename ItemType>
+void ConcurrentStack<ItemType>::push(const ItemType& value) {
+    this->emplace(value);
+}
+
+template <typename ItemType>
+void ConcurrentStack<ItemType>::push(ItemType&& value) {
+    this->emplace(std::move(value));
+}
+
+template <typename ItemType>
+template <typename... Args>
+void ConcurrentStack<ItemType>::emplace(Args&&... args) {
+    uint32_t link = this->make_node(std::forward<Args>(args)...);
+
+    this->push_chain(this->head, link, link);
+}
+
+template <typename ItemType>
+template <typename InputIterator>
+void ConcurrentStack<ItemType>::push_range(InputIterator first, InputIterator last) {
+    uint32_t chain_top = 0;
+    uint32_t chain_bottom = 0;
+
+    try {
+        for ( ; first != last; first++) {
+            uint32_t link = this->make_node(*first);
+
+            this->node(link).next.store(chain_top, std::memory_order_relaxed);
+
+            chain_top = link;
+
+            if (chain_bottom == 0)
+                chain_bottom = link;
+        }
+    } catch (...) {
+        for (uint32_t link = chain_top; link != 0; ) {
+            uint32_t next = this->node(link).next.load(std::memory_order_relaxed);
+
+            this->node(link).item()->~ItemType();
+            this->push_chain(this->free_head, link, link);
+
+            link = next;
+        }
+
+        throw;
+    }
+
+    if (chain_top != 0)
+        this->push_chain(this->head, chain_top, chain_bottom);
+}
+
+template <typename ItemType>
+bool ConcurrentStack<ItemType>::pop(ItemType& value) {
+    uint32_t link = this->pop_node(this->head);
+
+    if (link == 0)
+        return false;
+
+    // The node belongs to this thread alone from here.
+    ItemType* item = this->node(link).item();
+
+    value = std::move(*item);
+    item->~ItemType();
+
+    this->push_chain(this->free_head, link, link);
+
+    return true;
+}
+
+template <typename ItemType>
+bool ConcurrentStack<ItemType>::pop() {
+    uint32_t link = this->pop_node(this->head);
+
+    if (link == 0)
+        return false;
+
+    this->node(link).item()->~ItemType();
+
+    this->push_chain(this->free_head, link, link);
+
+    return true;
+}
+
+template <typename ItemType>
+template <typename OutputIterator>
+OutputIterator ConcurrentStack<ItemType>::pop_all(OutputIterator out) {
+    uint64_t current = this->head.load(std::memory_order_relaxed);
+
+    while (!this->head.compare_exchange_weak(current, pack(0, current), std::memory_order_acquire, std::memory_order_relaxed));
+
+    uint32_t first = link_of(current);
+    uint32_t last = 0;
+
+    for (uint32_t link = first; link != 0; link = this->node(link).next.load(std::memory_order_relaxed)) {
+        ItemType* item = this->node(link).item();
+
+        *out = std::move(*item);
+        out++;
+
+        item->~ItemType();
+
+        last = link;
+    }
+
+    // The nodes are still chained, they go back to the free list in one step.
+    if (first != 0)
+        this->push_chain(this->free_head, first, last);
+
+    return out;
+}
+
+template <typename ItemType>
+ItemType& ConcurrentStack<ItemType>::top() {
+    return *this->node(link_of(this->head.load(std::memory_order_acquire))).item();
+}
@@ -0,0 +1,523 @@
+/**
+ * @file concurrent_vector.h
+ *
+ * An append-only vector many threads can push to at once, without locks.
+ */
+
+#pragma once
+
+// Contains
+//      IndexIterator
+#include "iterator.h"
+
+#include "pair.h"
+
+// Used for std::atomic.
+#include <atomic>
+
+// Used for std::allocator.
+#include <memory>
+
+// Used for std::forward().
+#include <utility>
+
+// Used for std::is_default_constructible and std::is_nothrow_constructible.
+#include <type_traits>
+
+// Used for std::out_of_range.
+#include <stdexcept>
+
+// ptrdiff_t and size_t definitions.
+#include <cstddef>
+
+/**
+ * @brief log2 of the size of the first bucket of a ConcurrentVector
+ */
+constexpr size_t CONCURRENT_VECTOR_FIRST_BITS = 5;
+
+/**
+ * @brief Number of buckets of a ConcurrentVector, enough to cover every size_t index
+ */
+constexpr size_t CONCURRENT_VECTOR_BUCKETS = 8 * sizeof(size_t) - CONCURRENT_VECTOR_FIRST_BITS;
+
+/**
+ * @tparam ItemType the type of item stored
+ * @tparam Allocator the allocator of the buckets
+ */
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
+/**
+ * @class ConcurrentVector
+ *
+ * @brief Vector whose push_back(), emplace_back() and grow_by() may run from many threads at once
+ *
+ * Items live in buckets of 32, 64, 128, ... items, allocated when first needed and never
+ * moved, so references and iterators stay valid as the vector grows. Appending claims
+ * indices with a single fetch_add(); the thread that first needs a bucket allocates it and
+ * installs it with one compare_exchange, a thread losing that race frees its own copy and
+ * uses the winner's. No thread ever waits for another, so appends never block.
+ *
+ * Every slot has a ready flag, set once its item is constructed. size() is the published
+ * watermark: the number of leading items all constructed, advanced past ready slots by
+ * whichever appender finds them, so at(), size() and the iterators only ever see built
+ * items while appends are running. operator[] is unchecked: reading an item beyond size()
+ * is safe once its append happened before the read, for instance through the index handed
+ * over by a queue.
+ *
+ * clear() and the destructor must not run concurrently with anything else. Claimed indices
+ * can not be given back, so if the constructor of an item throws, that item and the rest of
+ * its grow_by() range are default constructed before the exception propagates; the default
+ * constructor must not throw. Items without a default constructor must be nothrow
+ * constructible from the arguments they are appended with.
+ */
+class ConcurrentVector {
+    private:
+        typedef ConcurrentVector<ItemType, Allocator>   vector_type;
+
+        typedef std::atomic<bool>                                   Flag;
+        typedef typename Allocator::template rebind<Flag>::other    FlagAllocator;
+
+        Allocator allocator;
+        FlagAllocator flag_allocator;
+
+        std::atomic<ItemType*> buckets[CONCURRENT_VECTOR_BUCKETS];
+
+        /** @brief The ready flags, in buckets of the same sizes as the items */
+        std::atomic<Flag*> flags[CONCURRENT_VECTOR_BUCKETS];
+
+        /** @brief Indices claimed so far */
+        std::atomic<size_t> claimed;
+
+        /** @brief Number of leading items all constructed */
+        std::atomic<size_t> published;
+
+        static size_t bucket_of(size_t index);
+        static size_t bucket_start(size_t bucket);
+        static size_t bucket_size(size_t bucket);
+
+        /** @brief Returns the bucket, allocating it and its flags if no thread has yet */
+        ItemType* bucket_storage(size_t bucket);
+        Flag* flag_storage(size_t bucket);
+
+        ItemType* slot(size_t index);
+
+        bool is_ready(size_t index) const;
+
+        /** @brief Flags the item at @b index as constructed and advances the watermark past ready items */
+        void publish(size_t index);
+
+        template <typename... Args>
+        void construct_at(size_t index, Args&&... args);
+
+        template <typename... Args>
+        void construct_at(size_t index, std::true_type, Args&&... args);
+
+        template <typename... Args>
+        void construct_at(size_t index, std::false_type, Args&&... args);
+
+        void release();
+
+    public:
+        typedef ItemType                value_type;
+        typedef ItemType*               pointer;
+        typedef const ItemType*         const_pointer;
+        typedef ItemType&               reference;
+        typedef const ItemType&         const_reference;
+
+        typedef size_t                  size_type;
+        typedef ptrdiff_t               difference_type;
+
+        typedef Allocator               allocator_type;
+
+        typedef IndexIterator<vector_type, ItemType>                iterator;
+        typedef IndexIterator<const vector_type, const ItemType>    const_iterator;
+
+        explicit ConcurrentVector(const allocator_type& allocator = allocator_type());
+
+        ConcurrentVector(const ConcurrentVector&) = delete;
+        ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+        ~ConcurrentVector();
+
+        allocator_type get_allocator() const;
+
+        /**
+         * @brief Appends a copy of @b value
+         *
+         * @return the index of the new item
+         */
+        size_type push_back(const value_type& value);
+        size_type push_back(value_type&& value);
+
+        /**
+         * @brief Appends an item constructed from @b args
+         *
+         * @return the index of the new item
+         */
+        template <typename... Args>
+        size_type emplace_back(Args&&... args);
+
+        /**
+         * @brief Appends @b count default constructed items at consecutive indices
+         *
+         * @return the range of the new items, for the caller to fill
+         */
+        Pair<iterator, iterator> grow_by(size_type count);
+
+        /**
+         * @brief Appends @b count copies of @b value at consecutive indices
+         */
+        Pair<iterator, iterator> grow_by(size_type count, const value_type& value);
+
+        /**
+         * @brief Allocates the buckets needed to hold @b capacity items, so appends up to it allocate nothing
+         */
+        void reserve(size_type capacity);
+
+        /**
+         * @brief Destroys every item and frees the buckets. Not thread safe.
+         */
+        void clear();
+
+        reference operator[](size_type offset);
+        const_reference operator[](size_type offset) const;
+
+        /**
+         * @throw std::out_of_range if @b offset is not below size()
+         */
+        reference at(size_type offset);
+        const_reference at(size_type offset) const;
+
+        /**
+         * @brief Number of leading items whose construction is complete, a snapshot while appends run
+         */
+        size_type size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+};
+
+template <typename ItemType, typename Allocator>
+ConcurrentVector<ItemType, Allocator>::ConcurrentVector(const allocator_type& allocator) : allocator(allocator), flag_allocator(allocator) {
+    for (size_t bucket = 0; bucket < CONCURRENT_VECTOR_BUCKETS; bucket++) {
+        this->buckets[bucket].store(nullptr, std::memory_order_relaxed);
+        this->flags[bucket].store(nullptr, std::memory_order_relaxed);
+    }
+
+    this->claimed.store(0, std::memory_order_relaxed);
+    this->published.store(0, std::memory_order_relaxed);
+}
+
+template <typename ItemType, typename Allocator>
+ConcurrentVector<ItemType, Allocator>::~ConcurrentVector() {
+    this->release();
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::allocator_type ConcurrentVector<ItemType, Allocator>::get_allocator() const {
+    return this->allocator;
+}
+
+template <typename ItemType, typename Allocator>
+size_t ConcurrentVector<ItemType, Allocator>::bucket_of(size_t index) {
+    size_t shifted = index + (size_t(1) << CONCURRENT_VECTOR_FIRST_BITS);
+
+    return 8 * sizeof(unsigned long long) - 1 - __builtin_clzll(shifted) - CONCURRENT_VECTOR_FIRST_BITS;
+}
+
+template <typename ItemType, typename Allocator>
+size_t ConcurrentVector<ItemType, Allocator>::bucket_start(size_t bucket) {
+    return (size_t(1) << (bucket + CONCURRENT_VECTOR_FIRST_BITS)) - (size_t(1) << CONCURRENT_VECTOR_FIRST_BITS);
+}
+
+template <typename ItemType, typename Allocator>
+size_t ConcurrentVector<ItemType, Allocator>::bucket_size(size_t bucket) {
+    return size_t(1) << (bucket + CONCURRENT_VECTOR_FIRST_BITS);
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* ConcurrentVector<ItemType, Allocator>::bucket_storage(size_t bucket) {
+    ItemType* storage = this->buckets[bucket].load(std::memory_order_acquire);
+
+    if (storage != nullptr)
+        return storage;
+
+    // The flags go first, a bucket of items is never without them.
+    this->flag_storage(bucket);
+
+    ItemType* fresh = this->allocator.allocate(bucket_size(bucket));
+
+    if (this->buckets[bucket].compare_exchange_strong(storage, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+        return fresh;
+
+    // Another thread installed the bucket first, storage now holds its copy.
+    this->allocator.deallocate(fresh, bucket_size(bucket));
+
+    return storage;
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::Flag* ConcurrentVector<ItemType, Allocator>::flag_storage(size_t bucket) {
+    Flag* storage = this->flags[bucket].load(std::memory_order_acquire);
+
+    if (storage != nullptr)
+        return storage;
+
+    Flag* fresh = this->flag_allocator.allocate(bucket_size(bucket));
+
+    for (size_t index = 0; index < bucket_size(bucket); index++)
+        ::new (static_cast<void*>(fresh + index)) Flag(false);
+
+    if (this->flags[bucket].compare_exchange_strong(storage, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+        return fresh;
+
+    this->flag_allocator.deallocate(fresh, bucket_size(bucket));
+
+    return storage;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* ConcurrentVector<ItemType, Allocator>::slot(size_t index) {
+    size_t bucket = bucket_of(index);
+
+    return this->bucket_storage(bucket) + (index - bucket_start(bucket));
+}
+
+template <typename ItemType, typename Allocator>
+bool ConcurrentVector<ItemType, Allocator>::is_ready(size_t index) const {
+    size_t bucket = bucket_of(index);
+    Flag* storage = this->flags[bucket].load(std::memory_order_acquire);
+
+    return storage != nullptr && storage[index - bucket_start(bucket)].load(std::memory_order_seq_cst);
+}
+
+/*
+ * The flags and the watermark are sequentially consistent: a thread flagging index i + 1
+ * then finding i not ready, and the thread flagging i then checking i + 1, can not both
+ * miss the other's flag, so the watermark never stops short of a run of ready items.
+ */
+template <typename ItemType, typename Allocator>
+void ConcurrentVector<ItemType, Allocator>::publish(size_t index) {
+    size_t bucket = bucket_of(index);
+
+    this->flags[bucket].load(std::memory_order_acquire)[index - bucket_start(bucket)].store(true, std::memory_order_seq_cst);
+
+    size_t current = this->published.load(std::memory_order_seq_cst);
+
+    while (this->is_ready(current))
+        this->published.compare_exchange_weak(current, current + 1, std::memory_order_seq_cst, std::memory_order_seq_cst);
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+void ConcurrentVector<ItemType, Allocator>::construct_at(size_t index, Args&&... args) {
+    this->construct_at(index, typename std::is_default_constructible<ItemType>::type(), std::forward<Args>(args)...);
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+void ConcurrentVector<ItemType, Allocator>::construct_at(size_t index, std::true_type, Args&&... args) {
+    ItemType* position = this->slot(index);
+
+    try {
+        this->allocator.construct(position, std::forward<Args>(args)...);
+    } catch (...) {
+        // The index is claimed, it has to hold an item.
+        this->allocator.construct(position);
+        this->publish(index);
+
+        throw;
+    }
+
+    this->publish(index);
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+void ConcurrentVector<ItemType, Allocator>::construct_at(size_t index, std::false_type, Args&&... args) {
+    static_assert(std::is_nothrow_constructible<ItemType, Args&&...>::value,
+        "ConcurrentVector needs items default constructible or nothrow constructible from the arguments");
+
+    this->allocator.construct(this->slot(index), std::forward<Args>(args)...);
+
+    this->publish(index);
+}
+
+template <typename ItemType, typename Allocator>
+void ConcurrentVector<ItemType, Allocator>::release() {
+    size_t size = this->claimed.load(std::memory_order_relaxed);
+
+    for (size_t bucket = 0; bucket < CONCURRENT_VECTOR_BUCKETS; bucket++) {
+        ItemType* storage = this->buckets[bucket].load(std::memory_order_relaxed);
+
+        if (storage == nullptr)
+            continue;
+
+        size_t start = bucket_start(bucket);
+
+        for (size_t index = start; index < size && index < start + bucket_size(bucket); index++)
+            this->allocator.destroy(storage + (index - start));
+
+        this->allocator.deallocate(storage, bucket_size(bucket));
+
+        this->buckets[bucket].store(nullptr, std::memory_order_relaxed);
+    }
+
+    // Flag buckets may exist without their item bucket, when the thread installing it lost the race.
+    for (size_t bucket = 0; bucket < CONCURRENT_VECTOR_BUCKETS; bucket++) {
+        Flag* storage = this->flags[bucket].load(std::memory_order_relaxed);
+
+        if (storage == nullptr)
+            continue;
+
+        this->flag_allocator.deallocate(storage, bucket_size(bucket));
+
+        this->flags[bucket].store(nullptr, std::memory_order_relaxed);
+    }
+
+    this->claimed.store(0, std::memory_order_relaxed);
+    this->published.store(0, std::memory_order_relaxed);
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::size_type ConcurrentVector<ItemType, Allocator>::push_back(const value_type& value) {
+    return this->emplace_back(value);
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::size_type ConcurrentVector<ItemType, Allocator>::push_back(value_type&& value) {
+    return this->emplace_back(std::move(value));
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+typename ConcurrentVector<ItemType, Allocator>::size_type ConcurrentVector<ItemType, Allocator>::emplace_back(Args&&... args) {
+    size_t index = this->claimed.fetch_add(1, std::memory_order_relaxed);
+
+    this->construct_at(index, std::forward<Args>(args)...);
+
+    return index;
+}
+
+template <typename ItemType, typename Allocator>
+Pair<typename ConcurrentVector<ItemType, Allocator>::iterator, typename ConcurrentVector<ItemType, Allocator>::iterator>
+ConcurrentVector<ItemType, Allocator>::grow_by(size_type count) {
+    size_t first = this->claimed.fetch_add(count, std::memory_order_relaxed);
+
+    for (size_t index = first; index < first + count; index++)
+        this->construct_at(index);
+
+    return Pair<iterator, iterator>(iterator(this, first), iterator(this, first + count));
+}
+
+template <typename ItemType, typename Allocator>
+Pair<typename ConcurrentVector<ItemType, Allocator>::iterator, typename ConcurrentVector<ItemType, Allocator>::iterator>
+ConcurrentVector<ItemType, Allocator>::grow_by(size_type count, const value_type& value) {
+    size_t first = this->claimed.fetch_add(count, std::memory_order_relaxed);
+    size_t index = first;
+
+    try {
+        for ( ; index < first + count; index++)
+            this->construct_at(index, value);
+    } catch (...) {
+        for (index++; index < first + count; index++)
+            this->construct_at(index);
+
+        throw;
+    }
+
+    return Pair<iterator, iterator>(iterator(this, first), iterator(this, first + count));
+}
+
+template <typename ItemType, typename Allocator>
+void ConcurrentVector<ItemType, Allocator>::reserve(size_type capacity) {
+    if (capacity == 0)
+        return;
+
+    for (size_t bucket = 0; bucket <= bucket_of(capacity - 1); bucket++)
+        this->bucket_storage(bucket);
+}
+
+template <typename ItemType, typename Allocator>
+void ConcurrentVector<ItemType, Allocator>::clear() {
+    this->release();
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::reference ConcurrentVector<ItemType, Allocator>::operator[](size_type offset) {
+    size_t bucket = bucket_of(offset);
+
+    return this->buckets[bucket].load(std::memory_order_acquire)[offset - bucket_start(bucket)];
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::const_reference ConcurrentVector<ItemType, Allocator>::operator[](size_type offset) const {
+    size_t bucket = bucket_of(offset);
+
+    return this->buckets[bucket].load(std::memory_order_acquire)[offset - bucket_start(bucket)];
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::reference ConcurrentVector<ItemType, Allocator>::at(size_type offset) {
+    if (offset >= this->size())
+        throw std::out_of_range("std::out_of_range in ConcurrentVector::at(size_type offset)");
+
+    return (*this)[offset];
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::const_reference ConcurrentVector<ItemType, Allocator>::at(size_type offset) const {
+    if (offset >= this->size())
+        throw std::out_of_range("std::out_of_range in ConcurrentVector::at(size_type offset) const");
+
+    return (*this)[offset];
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::size_type ConcurrentVector<ItemType, Allocator>::size() const {
+    return this->published.load(std::memory_order_acquire);
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::size_type ConcurrentVector<ItemType, Allocator>::capacity() const {
+    size_t capacity = 0;
+
+    for (size_t bucket = 0; bucket < CONCURRENT_VECTOR_BUCKETS; bucket++) {
+        if (this->buckets[bucket].load(std::memory_order_acquire) == nullptr)
+            break;
+
+        capacity = bucket_start(bucket) + bucket_size(bucket);
+    }
+
+    return capacity;
+}
+
+template <typename ItemType, typename Allocator>
+bool ConcurrentVector<ItemType, Allocator>::empty() const {
+    return this->size() == 0;
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::iterator ConcurrentVector<ItemType, Allocator>::begin() {
+    return iterator(this, 0);
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::const_iterator ConcurrentVector<ItemType, Allocator>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::iterator ConcurrentVector<ItemType, Allocator>::end() {
+    return iterator(this, this->size());
+}
+
+template <typename ItemType, typename Allocator>
+typename ConcurrentVector<ItemType, Allocator>::const_iterator ConcurrentVector<ItemType, Allocator>::end() const {
+    return const_iterator(this, this->size());
+}
@@ -0,0 +1,525 @@
+/**
+ * @file deque.h
+ *
+ * A double-ended queue stored in fixed-size blocks.
+ */
+
+#pragma once
+
+// Contains
+//      IndexIterator
+#include "iterator.h"
+
+// Contains
+//      block_items()
+#include "mem_tools.h"
+
+// Used for std::allocator.
+#include <memory>
+
+// Used for std::move(), std::forward() and std::swap().
+#include <utility>
+
+// Used for std::out_of_range.
+#include <stdexcept>
+
+/**
+ * @brief Size in bytes a Deque block aims for
+ */
+constexpr size_t DEQUE_BLOCK_BYTES = 4096;
+
+/**
+ * @tparam ItemType the type of item stored
+ * @tparam BlockItems the number of items per block, a power of two
+ * @tparam Allocator the allocator of the blocks
+ */
+template <typename ItemType, size_t BlockItems = block_items(sizeof(ItemType), DEQUE_BLOCK_BYTES), typename Allocator = std::allocator<ItemType>>
+/**
+ * @class Deque
+ *
+ * @brief Sequence with constant time insertion and removal at both ends
+ *
+ * Items live in blocks of BlockItems, whose pointers sit in a circular map. Pushing at either
+ * end fills the first or last block, or adds a block to the map; popping empties them. Items
+ * never move, so references stay valid until their item is popped. Only the map is ever
+ * reallocated, one pointer per block. A single emptied block is kept aside, so pushing and
+ * popping around a block boundary does not allocate every time.
+ *
+ * Usable as the container of a Stack or a Queue.
+ */
+class Deque {
+    static_assert(BlockItems > 0 && (BlockItems & (BlockItems - 1)) == 0, "Deque needs a power of two block size");
+
+    private:
+        typedef Deque<ItemType, BlockItems, Allocator>                  deque_type;
+        typedef typename Allocator::template rebind<ItemType*>::other   MapAllocator;
+
+        Allocator allocator;
+        MapAllocator map_allocator;
+
+        /** @brief Circular array of block pointers, map_capacity is 0 or a power of two */
+        ItemType** map;
+        size_t map_capacity;
+
+        /** @brief Map slot of the first block and number of blocks in use from there */
+        size_t first_block;
+        size_t blocks;
+
+        /** @brief Offset of the first item in the first block */
+        size_t head;
+
+        size_t count;
+
+        /** @brief Emptied block kept for the next push, or nullptr */
+        ItemType* spare;
+
+        /** @brief Address of the item at @b position, counted from the start of the first block */
+        ItemType* position_slot(size_t position) const;
+
+        ItemType* slot(size_t index) const;
+
+        ItemType* take_block();
+        void give_block(ItemType* block);
+
+        /** @brief Doubles the map if every slot holds a block */
+        void reserve_map_slot();
+
+        void add_back_block();
+        void add_front_block();
+
+        void release();
+
+    public:
+        typedef ItemType                value_type;
+        typedef ItemType*               pointer;
+        typedef const ItemType*         const_pointer;
+        typedef ItemType&               reference;
+        typedef const ItemType&         const_reference;
+
+        typedef size_t                  size_type;
+        typedef ptrdiff_t               difference_type;
+
+        typedef Allocator               allocator_type;
+
+        typedef IndexIterator<deque_type, ItemType>                 iterator;
+        typedef IndexIterator<const deque_type, const ItemType>     const_iterator;
+
+        explicit Deque(const allocator_type& allocator = allocator_type());
+
+        Deque(const Deque& other);
+        Deque(Deque&& other) noexcept;
+
+        ~Deque();
+
+        Deque& operator=(const Deque& other);
+        Deque& operator=(Deque&& other) noexcept;
+
+        allocator_type get_allocator() const;
+
+        reference operator[](size_type offset);
+        const_reference operator[](size_type offset) const;
+
+        /**
+         * @throw std::out_of_range if @b offset is not below size()
+         */
+        reference at(size_type offset);
+        const_reference at(size_type offset) const;
+
+        reference front();
+        const_reference front() const;
+
+        reference back();
+        const_reference back() const;
+
+        size_type size() const;
+        bool empty() const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+        void push_back(const value_type& value);
+        void push_back(value_type&& value);
+
+        void push_front(const value_type& value);
+        void push_front(value_type&& value);
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
+
+        template <typename... Args>
+        reference emplace_front(Args&&... args);
+
+        void pop_back();
+        void pop_front();
+
+        /** @brief Destroys every item and frees every block */
+        void clear();
+
+        void swap(Deque& other) noexcept;
+
+        bool operator==(const Deque& other) const;
+        bool operator!=(const Deque& other) const;
+};
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+Deque<ItemType, BlockItems, Allocator>::Deque(const allocator_type& allocator) : allocator(allocator), map_allocator(allocator) {
+    this->map = nullptr;
+    this->map_capacity = 0;
+
+    this->first_block = 0;
+    this->blocks = 0;
+
+    this->head = 0;
+    this->count = 0;
+
+    this->spare = nullptr;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+Deque<ItemType, BlockItems, Allocator>::Deque(const Deque& other) : Deque(other.allocator) {
+    try {
+        for (size_t index = 0; index < other.count; index++)
+            this->push_back(other[index]);
+    } catch (...) {
+        this->release();
+
+        throw;
+    }
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+Deque<ItemType, BlockItems, Allocator>::Deque(Deque&& other) noexcept : Deque(other.allocator) {
+    this->swap(other);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+Deque<ItemType, BlockItems, Allocator>::~Deque() {
+    this->release();
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+Deque<ItemType, BlockItems, Allocator>& Deque<ItemType, BlockItems, Allocator>::operator=(const Deque& other) {
+    if (this != &other) {
+        Deque copy(other);
+
+        this->swap(copy);
+    }
+
+    return *this;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+Deque<ItemType, BlockItems, Allocator>& Deque<ItemType, BlockItems, Allocator>::operator=(Deque&& other) noexcept {
+    if (this != &other) {
+        Deque temp(std::move(other));
+
+        this->swap(temp);
+    }
+
+    return *this;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+ItemType* Deque<ItemType, BlockItems, Allocator>::position_slot(size_t position) const {
+    return this->map[(this->first_block + position / BlockItems) & (this->map_capacity - 1)] + (position & (BlockItems - 1));
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+ItemType* Deque<ItemType, BlockItems, Allocator>::slot(size_t index) const {
+    return this->position_slot(this->head + index);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+ItemType* Deque<ItemType, BlockItems, Allocator>::take_block() {
+    if (this->spare == nullptr)
+        return this->allocator.allocate(BlockItems);
+
+    ItemType* block = this->spare;
+
+    this->spare = nullptr;
+
+    return block;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::give_block(ItemType* block) {
+    if (this->spare == nullptr)
+        this->spare = block;
+    else
+        this->allocator.deallocate(block, BlockItems);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::reserve_map_slot() {
+    if (this->blocks < this->map_capacity)
+        return;
+
+    size_t capacity = (this->map_capacity == 0) ? 8 : 2 * this->map_capacity;
+    ItemType** map = this->map_allocator.allocate(capacity);
+
+    // The blocks in use are laid out from slot 0 of the new map.
+    for (size_t block = 0; block < this->blocks; block++)
+        map[block] = this->map[(this->first_block + block) & (this->map_capacity - 1)];
+
+    if (this->map != nullptr)
+        this->map_allocator.deallocate(this->map, this->map_capacity);
+
+    this->map = map;
+    this->map_capacity = capacity;
+    this->first_block = 0;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::add_back_block() {
+    this->reserve_map_slot();
+
+    this->map[(this->first_block + this->blocks) & (this->map_capacity - 1)] = this->take_block();
+    this->blocks++;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::add_front_block() {
+    this->reserve_map_slot();
+
+    ItemType* block = this->take_block();
+
+    this->first_block = (this->first_block - 1) & (this->map_capacity - 1);
+    this->map[this->first_block] = block;
+    this->blocks++;
+
+    this->head += BlockItems;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::release() {
+    this->clear();
+
+    if (this->spare != nullptr)
+        this->allocator.deallocate(this->spare, BlockItems);
+
+    if (this->map != nullptr)
+        this->map_allocator.deallocate(this->map, this->map_capacity);
+
+    this->spare = nullptr;
+    this->map = nullptr;
+    this->map_capacity = 0;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::allocator_type Deque<ItemType, BlockItems, Allocator>::get_allocator() const {
+    return this->allocator;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::reference Deque<ItemType, BlockItems, Allocator>::operator[](size_type offset) {
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::const_reference Deque<ItemType, BlockItems, Allocator>::operator[](size_type offset) const {
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::reference Deque<ItemType, BlockItems, Allocator>::at(size_type offset) {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in Deque::at(size_type offset)");
+
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::const_reference Deque<ItemType, BlockItems, Allocator>::at(size_type offset) const {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in Deque::at(size_type offset) const");
+
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::reference Deque<ItemType, BlockItems, Allocator>::front() {
+    return *this->slot(0);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::const_reference Deque<ItemType, BlockItems, Allocator>::front() const {
+    return *this->slot(0);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::reference Deque<ItemType, BlockItems, Allocator>::back() {
+    return *this->slot(this->count - 1);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::const_reference Deque<ItemType, BlockItems, Allocator>::back() const {
+    return *this->slot(this->count - 1);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::size_type Deque<ItemType, BlockItems, Allocator>::size() const {
+    return this->count;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+bool Deque<ItemType, BlockItems, Allocator>::empty() const {
+    return this->count == 0;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::iterator Deque<ItemType, BlockItems, Allocator>::begin() {
+    return iterator(this, 0);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::const_iterator Deque<ItemType, BlockItems, Allocator>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::iterator Deque<ItemType, BlockItems, Allocator>::end() {
+    return iterator(this, this->count);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+typename Deque<ItemType, BlockItems, Allocator>::const_iterator Deque<ItemType, BlockItems, Allocator>::end() const {
+    return const_iterator(this, this->count);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::push_back(const value_type& value) {
+    this->emplace_back(value);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::push_back(value_type&& value) {
+    this->emplace_back(std::move(value));
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::push_front(const value_type& value) {
+    this->emplace_front(value);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::push_front(value_type&& value) {
+    this->emplace_front(std::move(value));
+}
+
+/*
+ * A block added for an item whose constructor throws is left in place, empty, and used by
+ * the next push at the same end.
+ */
+template <typename ItemType, size_t BlockItems, typename Allocator>
+template <typename... Args>
+typename Deque<ItemType, BlockItems, Allocator>::reference Deque<ItemType, BlockItems, Allocator>::emplace_back(Args&&... args) {
+    if (this->head + this->count == this->blocks * BlockItems)
+        this->add_back_block();
+
+    ItemType* position = this->slot(this->count);
+
+    this->allocator.construct(position, std::forward<Args>(args)...);
+
+    this->count++;
+
+    return *position;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+template <typename... Args>
+typename Deque<ItemType, BlockItems, Allocator>::reference Deque<ItemType, BlockItems, Allocator>::emplace_front(Args&&... args) {
+    if (this->head == 0)
+        this->add_front_block();
+
+    ItemType* position = this->position_slot(this->head - 1);
+
+    this->allocator.construct(position, std::forward<Args>(args)...);
+
+    this->head--;
+    this->count++;
+
+    return *position;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::pop_back() {
+    this->count--;
+
+    this->allocator.destroy(this->slot(this->count));
+
+    // Give back the last block once nothing is left in it.
+    if (this->head + this->count <= (this->blocks - 1) * BlockItems) {
+        this->blocks--;
+
+        this->give_block(this->map[(this->first_block + this->blocks) & (this->map_capacity - 1)]);
+    }
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::pop_front() {
+    this->allocator.destroy(this->slot(0));
+
+    this->head++;
+    this->count--;
+
+    if (this->head >= BlockItems) {
+        this->give_block(this->map[this->first_block]);
+
+        this->first_block = (this->first_block + 1) & (this->map_capacity - 1);
+        this->blocks--;
+
+        this->head -= BlockItems;
+    }
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::clear() {
+    for (size_t index = 0; index < this->count; index++)
+        this->allocator.destroy(this->slot(index));
+
+    for (size_t block = 0; block < this->blocks; block++)
+        this->allocator.deallocate(this->map[(this->first_block + block) & (this->map_capacity - 1)], BlockItems);
+
+    this->first_block = 0;
+    this->blocks = 0;
+
+    this->head = 0;
+    this->count = 0;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+void Deque<ItemType, BlockItems, Allocator>::swap(Deque& other) noexcept {
+    std::swap(this->allocator, other.allocator);
+    std::swap(this->map_allocator, other.map_allocator);
+
+    std::swap(this->map, other.map);
+    std::swap(this->map_capacity, other.map_capacity);
+
+    std::swap(this->first_block, other.first_block);
+    std::swap(this->blocks, other.blocks);
+
+    std::swap(this->head, other.head);
+    std::swap(this->count, other.count);
+
+    std::swap(this->spare, other.spare);
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+bool Deque<ItemType, BlockItems, Allocator>::operator==(const Deque& other) const {
+    if (this->count != other.count)
+        return false;
+
+    for (size_t index = 0; index < this->count; index++)
+        if (!((*this)[index] == other[index]))
+            return false;
+
+    return true;
+}
+
+template <typename ItemType, size_t BlockItems, typename Allocator>
+bool Deque<ItemType, BlockItems, Allocator>::operator!=(const Deque& other) const {
+    return !(*this == other);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+// size_t definition.
+#include <cstddef>
+
+/*
+ * Growth policies decide how much storage a Vector asks for.
+ *
+ * A policy provides two static functions:
+ *
+ *      size_t grow(size_t capacity, size_t item_size)
+ *          the capacity to reallocate to when a Vector of the given capacity is full
+ *
+ *      size_t round(size_t capacity, size_t item_size)
+ *          the capacity actually allocated when at least capacity items are requested,
+ *          so that memory the allocator hands out anyway is not wasted
+ */
+
+/*
+ * Multiplies the capacity by Numerator / Denominator on every growth.
+ */
+template <size_t Numerator, size_t Denominator>
+struct FactorGrowth {
+    static_assert(Numerator > Denominator, "FactorGrowth has to increase the capacity");
+
+    static size_t grow(size_t capacity, size_t) {
+        size_t next = capacity / Denominator * Numerator + capacity % Denominator * Numerator / Denominator;
+
+        return (next > capacity) ? next : capacity + 1;
+    }
+
+    static size_t round(size_t capacity, size_t) {
+        return capacity;
+    }
+};
+
+/*
+ * Default policy, doubles the capacity (1, 2, 4, 8, ...).
+ */
+typedef FactorGrowth<2, 1> DoublingGrowth;
+
+/*
+ * Grows by 1.5x. The sum of the previously freed blocks eventually exceeds the next request,
+ * so the allocator can reuse them, which never happens with 2x growth.
+ */
+typedef FactorGrowth<3, 2> OneAndHalfGrowth;
+
+/*
+ * Meant for very large vectors.
+ *
+ * Doubles until the storage reaches LargeSize bytes, then grows by 1/8 of the capacity,
+ * which bounds the unused tail to 12.5% instead of up to 50%. Every block of at least
+ * one page is rounded up to a whole number of pages, since that is what the kernel maps.
+ */
+template <size_t PageSize = 4096, size_t LargeSize = (size_t(1) << 26)>
+struct PageGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageGrowth needs a power of two page size");
+
+    static size_t grow(size_t capacity, size_t item_size) {
+        size_t next;
+
+        if (capacity * item_size < LargeSize)
+            next = (capacity == 0) ? 1 : capacity * 2;
+        else
+            next = capacity + capacity / 8;
+
+        return round(next, item_size);
+    }
+
+    static size_t round(size_t capacity, size_t item_size) {
+        size_t bytes = capacity * item_size;
+
+        if (bytes < PageSize)
+            return capacity;
+
+        bytes = (bytes + PageSize - 1) & ~(PageSize - 1);
+
+        return bytes / item_size;
+    }
+};
+
+/*
+ * Doubles the capacity and rounds every block up to the size class a jemalloc-style
+ * allocator would serve the request from: multiples of 16 bytes up to 128 bytes, then
+ * four classes per power of two (160, 192, 224, 256, 320, ...). The rounded-up tail is
+ * memory the allocator reserves for the block anyway.
+ */
+struct SizeClassGrowth {
+    static size_t size_class(size_t bytes) {
+        if (bytes <= 128)
+            return (bytes + 15) & ~size_t(15);
+
+        size_t power = 1;
+
+        while ((power << 1) <= bytes - 1)
+            power <<= 1;
+
+        size_t spacing = power / 4;
+
+        return (bytes + spacing - 1) & ~(spacing - 1);
+    }
+
+    static size_t grow(size_t capacity, size_t item_size) {
+        return round((capacity == 0) ? 1 : capacity * 2, item_size);
+    }
+
+    static size_t round(size_t capacity, size_t item_size) {
+        if (capacity == 0)
+            return 0;
+
+        return size_class(capacity * item_size) / item_size;
+    }
+};
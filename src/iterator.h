@@ -3,6 +3,12 @@
 // ptrdiff_t and size_t definitions.
 #include <cstddef>
 
+// Used for the standard library iterator tags.
+#include <iterator>
+
+// Used for std::enable_if and std::is_convertible.
+#include <type_traits>
+
 class input_iterator_tag {};
 class output_iterator_tag {};
 class forward_iterator_tag : public input_iterator_tag {};
@@ -53,6 +59,74 @@ struct IteratorTraits<const Type *> {
     typedef random_access_iterator_tag  iterator_category;
 };
 
+/*
+ * Maps an iterator category to the tags above, so that iterators of the standard library
+ * containers dispatch the same way as the ones defined here.
+ */
+template <typename Category>
+struct CategoryTag {
+    typedef Category type;
+};
+
+template <>
+struct CategoryTag<std::input_iterator_tag> {
+    typedef input_iterator_tag type;
+};
+
+template <>
+struct CategoryTag<std::output_iterator_tag> {
+    typedef output_iterator_tag type;
+};
+
+template <>
+struct CategoryTag<std::forward_iterator_tag> {
+    typedef forward_iterator_tag type;
+};
+
+template <>
+struct CategoryTag<std::bidirectional_iterator_tag> {
+    typedef bidirectional_iterator_tag type;
+};
+
+template <>
+struct CategoryTag<std::random_access_iterator_tag> {
+    typedef random_access_iterator_tag type;
+};
+
+#if __cplusplus > 201703L
+template <>
+struct CategoryTag<std::contiguous_iterator_tag> {
+    typedef random_access_iterator_tag type;
+};
+#endif
+
+template <typename Iterator>
+struct IteratorCategory {
+    typedef typename CategoryTag<typename IteratorTraits<Iterator>::iterator_category>::type type;
+};
+
+/*
+ * Number of increments from first to last, constant time for random access iterators.
+ */
+template <typename IteratorType>
+ptrdiff_t iterator_distance(IteratorType first, IteratorType last, input_iterator_tag) {
+    ptrdiff_t distance = 0;
+
+    for ( ; first != last; first++, distance++);
+
+    return distance;
+}
+
+template <typename IteratorType>
+ptrdiff_t iterator_distance(IteratorType first, IteratorType last, random_access_iterator_tag) {
+    return last - first;
+}
+
+template <typename IteratorType>
+ptrdiff_t iterator_distance(IteratorType first, IteratorType last) {
+    return iterator_distance(first, last, typename IteratorCategory<IteratorType>::type());
+}
+
 template <typename Type, typename Distance> 
 class InputIterator {
     typedef input_iterator_tag          iterator_category;
@@ -115,101 +189,211 @@ class NormalIterator {
 
         typedef NormalIterator Self;
 
-        constexpr NormalIterator() {
-            this->current(Iterator());
-        }
+        constexpr NormalIterator() : current(Iterator()) {}
 
-        NormalIterator(const Iterator& iterator) {
-            this->current = iterator;
-        }
+        constexpr NormalIterator(const Iterator& iterator) : current(iterator) {}
 
-        reference operator*() const {
+        // Converts an iterator to a constant one.
+        template <typename OtherIterator, typename = typename std::enable_if<std::is_convertible<OtherIterator, Iterator>::value>::type>
+        constexpr NormalIterator(const NormalIterator<OtherIterator, Container>& other) : current(other.base()) {}
+
+        constexpr reference operator*() const {
             return *this->current;
         }
 
-        pointer operator->() const {
+        constexpr pointer operator->() const {
             return this->current;
         }
 
-        Self& operator++() {
+        constexpr Self& operator++() {
             ++this->current;
 
             return *this;
         }
 
-        Self operator++(int) {
+        constexpr Self operator++(int) {
             return Self(this->current++);
         }
 
-        Self& operator--() {
+        constexpr Self& operator--() {
             --this->current;
 
             return *this;
         }
 
-        Self operator--(int) {
+        constexpr Self operator--(int) {
             return Self(this->current--);
         }
 
-        reference operator[](difference_type offset) const {
+        constexpr reference operator[](difference_type offset) const {
             return this->current[offset];
         }
 
-        Self& operator+=(difference_type x) {
+        constexpr Self& operator+=(difference_type x) {
             this->current += x;
 
             return *this;
         }
 
-        Self operator+(difference_type x) const {
+        constexpr Self operator+(difference_type x) const {
             return Self(this->current + x);
         }
 
-        Self& operator-=(difference_type x) {
+        constexpr Self& operator-=(difference_type x) {
             this->current -= x;
 
             return *this;
         }
 
-        Self operator-(difference_type x) const {
+        constexpr Self operator-(difference_type x) const {
             return Self(this->current - x);
         }
 
-        difference_type operator-(const Self& other) {
+        constexpr difference_type operator-(const Self& other) {
             return this->current - other.current;
         }
 
-        const Iterator& base() const {
+        constexpr const Iterator& base() const {
             return this->current;
         }
 
         template <typename IteratorOther>
-        bool operator==(const NormalIterator<IteratorOther, Container> &other) {
+        constexpr bool operator==(const NormalIterator<IteratorOther, Container> &other) {
             return this->base() == other.base();
         }
 
         template <typename IteratorOther>
-        bool operator!=(const NormalIterator<IteratorOther, Container> &other) {
+        constexpr bool operator!=(const NormalIterator<IteratorOther, Container> &other) {
             return this->base() != other.base();
         }
 
         template <typename IteratorOther>
-        bool operator<(const NormalIterator<IteratorOther, Container> &other) {
+        constexpr bool operator<(const NormalIterator<IteratorOther, Container> &other) {
             return this->base() < other.base();
         }
 
         template <typename IteratorOther>
-        bool operator>(const NormalIterator<IteratorOther, Container> &other) {
+        constexpr bool operator>(const NormalIterator<IteratorOther, Container> &other) {
             return this->base() > other.base();
         }
 
         template <typename IteratorOther>
-        bool operator<=(const NormalIterator<IteratorOther, Container> &other) {
+        constexpr bool operator<=(const NormalIterator<IteratorOther, Container> &other) {
             return this->base() <= other.base();
         }
 
         template <typename IteratorOther>
-        bool operator>=(const NormalIterator<IteratorOther, Container> &other) {
+        constexpr bool operator>=(const NormalIterator<IteratorOther, Container> &other) {
             return this->base() >= other.base();
         }
 };
+
+/*
+ * Random access iterator over a container indexed with operator[], holding the index rather
+ * than a pointer, for containers whose items are not contiguous. ValueType is const for
+ * constant iterators. Reference is what operator[] returns, a proxy object for containers
+ * which do not store ValueType as such.
+ */
+template <typename Container, typename ValueType, typename Reference = ValueType&>
+class IndexIterator {
+    template <typename OtherContainer, typename OtherValue, typename OtherReference>
+    friend class IndexIterator;
+
+    private:
+        Container* container;
+        size_t index;
+
+    public:
+        typedef random_access_iterator_tag  iterator_category;
+        typedef ValueType                   value_type;
+        typedef ptrdiff_t                   difference_type;
+        typedef ValueType*                  pointer;
+        typedef Reference                   reference;
+
+        IndexIterator() : container(nullptr), index(0) {}
+        IndexIterator(Container* container, size_t index) : container(container), index(index) {}
+
+        // Converts an iterator to a constant one.
+        template <typename OtherContainer, typename OtherValue, typename OtherReference>
+        IndexIterator(const IndexIterator<OtherContainer, OtherValue, OtherReference>& other) : container(other.container), index(other.index) {}
+
+        reference operator*() const {
+            return (*this->container)[this->index];
+        }
+
+        pointer operator->() const {
+            return &(*this->container)[this->index];
+        }
+
+        reference operator[](difference_type offset) const {
+            return (*this->container)[this->index + offset];
+        }
+
+        IndexIterator& operator++() {
+            this->index++;
+
+            return *this;
+        }
+
+        IndexIterator operator++(int) {
+            return IndexIterator(this->container, this->index++);
+        }
+
+        IndexIterator& operator--() {
+            this->index--;
+
+            return *this;
+        }
+
+        IndexIterator operator--(int) {
+            return IndexIterator(this->container, this->index--);
+        }
+
+        IndexIterator& operator+=(difference_type offset) {
+            this->index += offset;
+
+            return *this;
+        }
+
+        IndexIterator& operator-=(difference_type offset) {
+            this->index -= offset;
+
+            return *this;
+        }
+
+        IndexIterator operator+(difference_type offset) const {
+            return IndexIterator(this->container, this->index + offset);
+        }
+
+        IndexIterator operator-(difference_type offset) const {
+            return IndexIterator(this->container, this->index - offset);
+        }
+
+        difference_type operator-(const IndexIterator& other) const {
+            return static_cast<difference_type>(this->index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const IndexIterator& other) const {
+            return this->index == other.index;
+        }
+
+        bool operator!=(const IndexIterator& other) const {
+            return this->index != other.index;
+        }
+
+        bool operator<(const IndexIterator& other) const {
+            return this->index < other.index;
+        }
+
+        bool operator>(const IndexIterator& other) const {
+            return this->index > other.index;
+        }
+
+        bool operator<=(const IndexIterator& other) const {
+            return this->index <= other.index;
+        }
+
+        bool operator>=(const IndexIterator& other) const {
+            return this->index >= other.index;
+        }
+};
@@ -3,9 +3,12 @@
 //      default Compare object
 #include "misc.h"
 
+// Used for std::allocator.
+#include <memory>
+
 #pragma once
 
-template <typename KeyType, typename ValueType, typename Compare = NodeCompare<KeyType>>
+template <typename KeyType, typename ValueType, typename Compare = NodeCompare<KeyType>, typename Allocator = std::allocator<ValueType>>
 class KeyTree {
     private:
         class Node {
@@ -23,9 +26,17 @@ class KeyTree {
                 Node(const KeyType& key, const ValueType& value, Node *parent);
         };
 
+        // Nodes are allocated through Allocator rebound to Node, so a Tree can live in an Arena.
+        typedef typename Allocator::template rebind<Node>::other NodeAllocator;
+
+        NodeAllocator node_allocator;
+
         Node *root;
         Compare compare;
 
+        Node *create_node(const KeyType& key, const ValueType& value, Node *parent);
+        void destroy_node(Node *node);
+
         void real_delete(Node *leaf);
 
         Node *real_insert(Node *leaf, Node *parent, const KeyType& key, const ValueType& value);
@@ -95,13 +106,17 @@ class KeyTree {
                 bool operator!=(const ConstIterator& iterator) const;
         };
 
-        KeyTree();
+        typedef Allocator allocator_type;
+
+        KeyTree(const allocator_type& allocator = allocator_type());
         KeyTree(const KeyTree& other);
         
         KeyTree& operator=(const KeyTree& other);
 
         ~KeyTree();
 
+        allocator_type get_allocator() const;
+
         void insert(const KeyType& key, const ValueType& value);
         void erase(const KeyType& key);
 
@@ -127,8 +142,8 @@ class KeyTree {
         bool operator>=(const KeyTree& other) const;
 };
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::Node::Node() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::Node::Node() {
     this->key = KeyType();
     this->value = ValueType();
 
@@ -138,8 +153,8 @@ KeyTree<KeyType, ValueType, Compare>::Node::Node() {
     this->right = nullptr;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::Node::Node(const KeyType& key, const ValueType& value) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::Node::Node(const KeyType& key, const ValueType& value) {
     this->key = key;
     this->value = value;
 
@@ -149,8 +164,8 @@ KeyTree<KeyType, ValueType, Compare>::Node::Node(const KeyType& key, const Value
     this->right = nullptr;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::Node::Node(const KeyType& key, const ValueType& value, Node* parent) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::Node::Node(const KeyType& key, const ValueType& value, Node* parent) {
     this->key = key;
     this->value = value;
 
@@ -160,13 +175,13 @@ KeyTree<KeyType, ValueType, Compare>::Node::Node(const KeyType& key, const Value
     this->right = nullptr;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::KeyTree() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::KeyTree(const allocator_type& allocator) : node_allocator(allocator) {
     this->root = nullptr;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::KeyTree(const KeyTree &other) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::KeyTree(const KeyTree &other) : node_allocator(other.node_allocator) {
     this->root = nullptr;
 
     for (auto it = other.cbegin(); it != other.cend(); it++)
@@ -174,35 +189,63 @@ KeyTree<KeyType, ValueType, Compare>::KeyTree(const KeyTree &other) {
 
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>& KeyTree<KeyType, ValueType, Compare>::operator=(const KeyTree &other) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>& KeyTree<KeyType, ValueType, Compare, Allocator>::operator=(const KeyTree &other) {
     this->real_delete(this->root);
 
     this->root = nullptr;
 
     for (auto it = other.cbegin(); it != other.cend(); it++)
         this->insert(it->key, it->value);
+
+    return *this;
+}
+
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::create_node(const KeyType& key, const ValueType& value, typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *parent) {
+    Node *node = this->node_allocator.allocate(1);
+
+    try {
+        this->node_allocator.construct(node, key, value, parent);
+    } catch (...) {
+        this->node_allocator.deallocate(node, 1);
+
+        throw;
+    }
+
+    return node;
+}
+
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::destroy_node(typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *node) {
+    this->node_allocator.destroy(node);
+    this->node_allocator.deallocate(node, 1);
+}
+
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::allocator_type KeyTree<KeyType, ValueType, Compare, Allocator>::get_allocator() const {
+    return allocator_type(this->node_allocator);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::real_delete(KeyTree<KeyType, ValueType, Compare>::Node *leaf) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::real_delete(KeyTree<KeyType, ValueType, Compare, Allocator>::Node *leaf) {
     if (leaf != nullptr) {
         this->real_delete(leaf->left);
         this->real_delete(leaf->right);
 
-        delete leaf;
+        this->destroy_node(leaf);
     }
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::~KeyTree() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::~KeyTree() {
     this->real_delete(this->root);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::real_insert(KeyTree<KeyType, ValueType, Compare>::Node *leaf, KeyTree<KeyType, ValueType, Compare>::Node *parent, const KeyType& key, const ValueType& value) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::real_insert(KeyTree<KeyType, ValueType, Compare, Allocator>::Node *leaf, KeyTree<KeyType, ValueType, Compare, Allocator>::Node *parent, const KeyType& key, const ValueType& value) {
     if (leaf == nullptr)
-        leaf = new Node(key, value, parent);
+        leaf = this->create_node(key, value, parent);
     else if (key < leaf->key)
         leaf->left = real_insert(leaf->left, leaf, key, value);
     else if (key > leaf->key)
@@ -211,13 +254,13 @@ typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType,
     return leaf;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::insert(const KeyType& key, const ValueType& value) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::insert(const KeyType& key, const ValueType& value) {
     this->root = this->real_insert(this->root, this->root, key, value);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::min_helper(typename KeyTree<KeyType, ValueType, Compare>::Node *leaf) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::min_helper(typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *leaf) const {
     if (leaf == nullptr)
         return nullptr;
     else if (leaf->left == nullptr)
@@ -226,8 +269,8 @@ typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType,
         return min_helper(leaf->left);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::max_helper(typename KeyTree<KeyType, ValueType, Compare>::Node *leaf) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::max_helper(typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *leaf) const {
     if (leaf == nullptr)
         return nullptr;
     else if (leaf->right == nullptr)
@@ -236,8 +279,8 @@ typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType,
         return max_helper(leaf->right);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::real_erase(KeyTree<KeyType, ValueType, Compare>::Node *leaf, const KeyType& key) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::real_erase(KeyTree<KeyType, ValueType, Compare, Allocator>::Node *leaf, const KeyType& key) {
     if (leaf == nullptr)
         return nullptr;
     else if (key < leaf->key)
@@ -245,14 +288,14 @@ typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType,
     else if (key > leaf->key)
         leaf->right = real_erase(leaf->right, key);
     else if (leaf->left == nullptr && leaf->right == nullptr) {
-        delete leaf;
+        this->destroy_node(leaf);
 
         leaf = nullptr;
     } else if (leaf->right == nullptr) {
         auto parent = leaf->parent;
         auto left = leaf->left;
 
-        delete leaf;
+        this->destroy_node(leaf);
 
         leaf = left;
         leaf->parent = parent;
@@ -260,7 +303,7 @@ typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType,
         auto parent = leaf->parent;
         auto right = leaf->right;
 
-        delete leaf;
+        this->destroy_node(leaf);
 
         leaf = right;
         leaf->parent = parent;
@@ -276,20 +319,20 @@ typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType,
         else
             leaf->left = temp->left;
 
-        delete temp;
+        this->destroy_node(temp);
         temp = nullptr;
     }
 
     return leaf;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::erase(const KeyType& key) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::erase(const KeyType& key) {
     this->root = this->real_erase(this->root, key);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::real_search(KeyTree<KeyType, ValueType, Compare>::Node *leaf, const KeyType& key) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::real_search(KeyTree<KeyType, ValueType, Compare, Allocator>::Node *leaf, const KeyType& key) const {
     if (leaf == nullptr || leaf->key == key)
         return leaf;
 
@@ -299,13 +342,13 @@ typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType,
     return real_search(leaf->right, key);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::search(const KeyType& key) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::search(const KeyType& key) const {
     return this->real_search(this->root, key);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::real_print(KeyTree<KeyType, ValueType, Compare>::Node *leaf) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::real_print(KeyTree<KeyType, ValueType, Compare, Allocator>::Node *leaf) const {
     if (leaf != nullptr) {
         real_print(leaf->left);
 
@@ -336,39 +379,39 @@ void KeyTree<KeyType, ValueType, Compare>::real_print(KeyTree<KeyType, ValueType
     }
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::print() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::print() const {
     this->real_print(root);
 
     std::cout << std::endl;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::Iterator::Iterator() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::Iterator() {
     this->current = nullptr;
     this->max = nullptr;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::Iterator::Iterator(typename KeyTree<KeyType, ValueType, Compare>::Node *node, typename KeyTree<KeyType, ValueType, Compare>::Node *max) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::Iterator(typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *node, typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *max) {
     this->current = node;
     this->max = max;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::Iterator::Iterator(const typename KeyTree<KeyType, ValueType, Compare>::Iterator &iterator) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::Iterator(const typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator &iterator) {
     this->current = iterator.current;
     this->max = iterator.max;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Iterator& KeyTree<KeyType, ValueType, Compare>::Iterator::operator=(const Iterator &iterator) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator& KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator=(const Iterator &iterator) {
     this->current = iterator.current;
     this->max = iterator.max;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::Iterator::increment() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::increment() {
     if (this->current->parent == nullptr && this->current->left == nullptr && this->current->right == nullptr)
         this->current = nullptr;
     else if (this->current->right != nullptr) {
@@ -390,15 +433,15 @@ void KeyTree<KeyType, ValueType, Compare>::Iterator::increment() {
     }
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueType, Compare>::Iterator::operator++() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator++() {
     this->increment();
 
     return *this;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueType, Compare>::Iterator::operator++(int) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator++(int) {
     auto iterator = *this;
 
     this->increment();
@@ -406,8 +449,8 @@ typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueTy
     return iterator;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::Iterator::decrement() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::decrement() {
     if (this->current == nullptr)
         this->current = this->max;
     else if (this->current->parent->parent == this->current)
@@ -431,15 +474,15 @@ void KeyTree<KeyType, ValueType, Compare>::Iterator::decrement() {
     }
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueType, Compare>::Iterator::operator--() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator--() {
     this->decrement();
 
     return *this;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueType, Compare>::Iterator::operator--(int) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator--(int) {
     auto iterator = *this;
 
     this->decrement();
@@ -447,62 +490,62 @@ typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueTy
     return iterator;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node& KeyTree<KeyType, ValueType, Compare>::Iterator::operator*() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node& KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator*() {
     return *this->current;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::Iterator::operator->() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator->() {
     return this->current;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::Iterator::operator==(const Iterator& iterator) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator==(const Iterator& iterator) const {
     return this->current == iterator.current;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::Iterator::operator!=(const Iterator& iterator) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator::operator!=(const Iterator& iterator) const {
     return this->current != iterator.current;;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueType, Compare>::begin() {
-    return KeyTree<KeyType, ValueType, Compare>::Iterator(this->min(), this->max());
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator KeyTree<KeyType, ValueType, Compare, Allocator>::begin() {
+    return KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator(this->min(), this->max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Iterator KeyTree<KeyType, ValueType, Compare>::end() {
-    return KeyTree<KeyType, ValueType, Compare>::Iterator(nullptr, this->max());
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator KeyTree<KeyType, ValueType, Compare, Allocator>::end() {
+    return KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator(nullptr, this->max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::ConstIterator::ConstIterator() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::ConstIterator() {
     this->current = nullptr;
     this->max = nullptr;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::ConstIterator::ConstIterator(typename KeyTree<KeyType, ValueType, Compare>::Node *node, typename KeyTree<KeyType, ValueType, Compare>::Node *max) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::ConstIterator(typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *node, typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node *max) {
     this->current = node;
     this->max = max;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-KeyTree<KeyType, ValueType, Compare>::ConstIterator::ConstIterator(const typename KeyTree<KeyType, ValueType, Compare>::ConstIterator &iterator) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::ConstIterator(const typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator &iterator) {
     this->current = iterator.current;
     this->max = iterator.max;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::ConstIterator& KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator=(const typename KeyTree<KeyType, ValueType, Compare>::ConstIterator &iterator) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator& KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator=(const typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator &iterator) {
     this->current = iterator.current;
     this->max = iterator.max;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::ConstIterator::increment() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::increment() {
     if (this->current->parent == nullptr && this->current->left == nullptr && this->current->right == nullptr)
         this->current = nullptr;
     else if (this->current->right != nullptr) {
@@ -524,15 +567,15 @@ void KeyTree<KeyType, ValueType, Compare>::ConstIterator::increment() {
     }
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator++() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator++() {
     this->increment();
 
     return *this;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator++(int) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator++(int) {
     auto iterator = *this;
 
     this->increment();
@@ -540,8 +583,8 @@ typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, Va
     return iterator;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void KeyTree<KeyType, ValueType, Compare>::ConstIterator::decrement() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::decrement() {
     if (this->current == nullptr)
         this->current = this->max;
     else if (this->current->parent->parent == this->current)
@@ -565,15 +608,15 @@ void KeyTree<KeyType, ValueType, Compare>::ConstIterator::decrement() {
     }
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator--() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator--() {
     this->decrement();
 
     return *this;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator--(int) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator--(int) {
     auto iterator = *this;
 
     this->decrement();
@@ -581,48 +624,48 @@ typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, Va
     return iterator;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-const typename KeyTree<KeyType, ValueType, Compare>::Node& KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator*() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+const typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node& KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator*() const {
     return *this->current;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-const typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator->() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+const typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator->() const {
     return this->current;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator==(const ConstIterator& iterator) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator==(const ConstIterator& iterator) const {
     return this->current == iterator.current;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::ConstIterator::operator!=(const ConstIterator& iterator) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator::operator!=(const ConstIterator& iterator) const {
     return this->current != iterator.current;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::min() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::min() const {
     return min_helper(this->root);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::Node* KeyTree<KeyType, ValueType, Compare>::max() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::Node* KeyTree<KeyType, ValueType, Compare, Allocator>::max() const {
     return max_helper(this->root);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, ValueType, Compare>::cbegin() const {
-    return KeyTree<KeyType, ValueType, Compare>::ConstIterator(this->min(), this->max());
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator KeyTree<KeyType, ValueType, Compare, Allocator>::cbegin() const {
+    return KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator(this->min(), this->max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename KeyTree<KeyType, ValueType, Compare>::ConstIterator KeyTree<KeyType, ValueType, Compare>::cend() const {
-    return KeyTree<KeyType, ValueType, Compare>::ConstIterator(nullptr, this->max());
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator KeyTree<KeyType, ValueType, Compare, Allocator>::cend() const {
+    return KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator(nullptr, this->max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::operator==(const KeyTree<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::operator==(const KeyTree<KeyType, ValueType, Compare, Allocator>& other) const {
     if (distance(this->cbegin(), this->cend()) != distance(other.cbegin(), other.cend()))
             return false;
 
@@ -633,37 +676,37 @@ bool KeyTree<KeyType, ValueType, Compare>::operator==(const KeyTree<KeyType, Val
     return true;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::operator!=(const KeyTree<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::operator!=(const KeyTree<KeyType, ValueType, Compare, Allocator>& other) const {
     return !(*this == other);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::operator<(const KeyTree<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::operator<(const KeyTree<KeyType, ValueType, Compare, Allocator>& other) const {
     if (Compare().execute(this->cbegin(), this->cend(), other.cbegin(), other.cend()) < 0)
         return true;
 
     return false;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::operator>(const KeyTree<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::operator>(const KeyTree<KeyType, ValueType, Compare, Allocator>& other) const {
     if (Compare().execute(this->cbegin(), this->cend(), other.cbegin(), other.cend()) > 0)
         return true;
 
     return false;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::operator<=(const KeyTree<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::operator<=(const KeyTree<KeyType, ValueType, Compare, Allocator>& other) const {
     if (Compare().execute(this->cbegin(), this->cend(), other.cbegin(), other.cend()) < 0)
         return true;
 
     return false;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool KeyTree<KeyType, ValueType, Compare>::operator>=(const KeyTree<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool KeyTree<KeyType, ValueType, Compare, Allocator>::operator>=(const KeyTree<KeyType, ValueType, Compare, Allocator>& other) const {
     if (Compare().execute(this->cbegin(), this->cend(), other.cbegin(), other.cend()) < 0)
         return true;
 
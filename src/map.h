@@ -4,20 +4,22 @@
 #include "key_tree.h"
 #include "misc.h"
 
-template <typename KeyType, typename ValueType, typename Compare = NodeCompare<KeyType>>
+template <typename KeyType, typename ValueType, typename Compare = NodeCompare<KeyType>, typename Allocator = std::allocator<Pair<KeyType, ValueType>>>
 class Map {
-    typedef typename KeyTree<KeyType, ValueType, Compare>::Iterator Iterator;
-    typedef typename KeyTree<KeyType, ValueType, Compare>::ConstIterator ConstIterator;
+    typedef typename KeyTree<KeyType, ValueType, Compare, Allocator>::Iterator Iterator;
+    typedef typename KeyTree<KeyType, ValueType, Compare, Allocator>::ConstIterator ConstIterator;
 
     private:
-        KeyTree<KeyType, ValueType, Compare> data;
+        KeyTree<KeyType, ValueType, Compare, Allocator> data;
 
     public:
-        Map();
+        typedef Allocator allocator_type;
+
+        Map(const allocator_type& allocator = allocator_type());
         Map(const Map& other);
 
         template <typename IteratorType>
-        Map(IteratorType first, IteratorType last);
+        Map(IteratorType first, IteratorType last, const allocator_type& allocator = allocator_type());
 
         ~Map();
 
@@ -51,7 +53,7 @@ class Map {
         template <typename IteratorType>
         void erase(IteratorType first, IteratorType last);
 
-        void swap(Map<KeyType, ValueType, Compare>& other);
+        void swap(Map<KeyType, ValueType, Compare, Allocator>& other);
 
         size_t count (const KeyType& key) const;
 
@@ -76,35 +78,31 @@ class Map {
         bool operator>=(const Map& other) const;
 };
 
-template <typename KeyType, typename ValueType, typename Compare>
-Map<KeyType, ValueType, Compare>::Map() {
-    this->data = KeyTree<KeyType, ValueType>();
-}
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+Map<KeyType, ValueType, Compare, Allocator>::Map(const allocator_type& allocator) : data(allocator) {}
 
-template <typename KeyType, typename ValueType, typename Compare>
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
 template <typename IteratorType>
-Map<KeyType, ValueType, Compare>::Map(IteratorType first, IteratorType last) {
-    this->data = KeyTree<KeyType, ValueType>();
-
+Map<KeyType, ValueType, Compare, Allocator>::Map(IteratorType first, IteratorType last, const allocator_type& allocator) : data(allocator) {
     for (auto it = first; it != last; it++)
-        this->data.insert(*it);
+        this->insert(*it);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-Map<KeyType, ValueType, Compare>::Map(const Map& other) {
-    this->data = other.data;
-}
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+Map<KeyType, ValueType, Compare, Allocator>::Map(const Map& other) : data(other.data) {}
 
-template <typename KeyType, typename ValueType, typename Compare>
-Map<KeyType, ValueType, Compare>::~Map() {}
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+Map<KeyType, ValueType, Compare, Allocator>::~Map() {}
 
-template <typename KeyType, typename ValueType, typename Compare>
-Map<KeyType, ValueType, Compare>& Map<KeyType, ValueType, Compare>::operator=(const Map& other) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+Map<KeyType, ValueType, Compare, Allocator>& Map<KeyType, ValueType, Compare, Allocator>::operator=(const Map& other) {
     this->data = other.data;
+
+    return *this;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-ValueType& Map<KeyType, ValueType, Compare>::at(const KeyType& key) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+ValueType& Map<KeyType, ValueType, Compare, Allocator>::at(const KeyType& key) {
     auto result = this->data.search(key);
 
     if (result == nullptr)
@@ -113,8 +111,8 @@ ValueType& Map<KeyType, ValueType, Compare>::at(const KeyType& key) {
     return result->value;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-const ValueType& Map<KeyType, ValueType, Compare>::at(const KeyType& key) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+const ValueType& Map<KeyType, ValueType, Compare, Allocator>::at(const KeyType& key) const {
     auto result = this->data.search(key);
 
     if (result == nullptr)
@@ -123,8 +121,8 @@ const ValueType& Map<KeyType, ValueType, Compare>::at(const KeyType& key) const
     return result->value;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-ValueType& Map<KeyType, ValueType, Compare>::operator[](const KeyType& key) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+ValueType& Map<KeyType, ValueType, Compare, Allocator>::operator[](const KeyType& key) {
     auto find = this->data.search(key);
 
     if (find == nullptr)
@@ -133,76 +131,76 @@ ValueType& Map<KeyType, ValueType, Compare>::operator[](const KeyType& key) {
     return find->value;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Compare>::begin() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::Iterator Map<KeyType, ValueType, Compare, Allocator>::begin() {
     return this->data.begin();
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Compare>::end() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::Iterator Map<KeyType, ValueType, Compare, Allocator>::end() {
     return this->data.end();
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::ConstIterator Map<KeyType, ValueType, Compare>::cbegin() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator Map<KeyType, ValueType, Compare, Allocator>::cbegin() const {
     return this->data.cbegin();
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::ConstIterator Map<KeyType, ValueType, Compare>::cend() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator Map<KeyType, ValueType, Compare, Allocator>::cend() const {
     return this->data.cend();
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool Map<KeyType, ValueType, Compare>::empty() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool Map<KeyType, ValueType, Compare, Allocator>::empty() const {
     return this->data.cbegin() == this->data.cend();
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-size_t Map<KeyType, ValueType, Compare>::size() const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+size_t Map<KeyType, ValueType, Compare, Allocator>::size() const {
     return distance(this->data.cbegin(), this->data.cend());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void Map<KeyType, ValueType, Compare>::clear() {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void Map<KeyType, ValueType, Compare, Allocator>::clear() {
     this->erase(this->begin(), this->end());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Compare>::insert(const Pair<KeyType, ValueType>& pair) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::Iterator Map<KeyType, ValueType, Compare, Allocator>::insert(const Pair<KeyType, ValueType>& pair) {
     this->data.insert(pair.first, pair.second);
 
-    return Map<KeyType, ValueType, Compare>::Iterator(this->data.search(pair.first), this->data.max());
+    return Map<KeyType, ValueType, Compare, Allocator>::Iterator(this->data.search(pair.first), this->data.max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Compare>::insert(const KeyType& key, const ValueType& value) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::Iterator Map<KeyType, ValueType, Compare, Allocator>::insert(const KeyType& key, const ValueType& value) {
     this->data.insert(key, value);
 
-    return Map<KeyType, ValueType, Compare>::Iterator(this->data.search(key), this->data.max());
+    return Map<KeyType, ValueType, Compare, Allocator>::Iterator(this->data.search(key), this->data.max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
 template <typename IteratorType>
-void Map<KeyType, ValueType, Compare>::insert(IteratorType first, IteratorType last) {
+void Map<KeyType, ValueType, Compare, Allocator>::insert(IteratorType first, IteratorType last) {
     for (auto it = first; it != last; it++)
         this->data.insert(it->key, it->value);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void Map<KeyType, ValueType, Compare>::erase(typename Map<KeyType, ValueType, Compare>::Iterator position) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void Map<KeyType, ValueType, Compare, Allocator>::erase(typename Map<KeyType, ValueType, Compare, Allocator>::Iterator position) {
     this->data.erase(position->key);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
 template <typename IteratorType>
-void Map<KeyType, ValueType, Compare>::erase(IteratorType first, IteratorType last) {
+void Map<KeyType, ValueType, Compare, Allocator>::erase(IteratorType first, IteratorType last) {
     for (auto it = first; it != last; it++)
         this->data.erase(it->key);
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-size_t Map<KeyType, ValueType, Compare>::erase(const KeyType& key) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+size_t Map<KeyType, ValueType, Compare, Allocator>::erase(const KeyType& key) {
     size_t count = 0;
 
     while (this->data.search(key) != nullptr) {
@@ -214,8 +212,8 @@ size_t Map<KeyType, ValueType, Compare>::erase(const KeyType& key) {
     return count;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-void Map<KeyType, ValueType, Compare>::swap(Map<KeyType, ValueType, Compare>& other) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+void Map<KeyType, ValueType, Compare, Allocator>::swap(Map<KeyType, ValueType, Compare, Allocator>& other) {
     auto temp = this->data;
 
     this->data = other.data;
@@ -223,23 +221,23 @@ void Map<KeyType, ValueType, Compare>::swap(Map<KeyType, ValueType, Compare>& ot
     other.data = temp;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-size_t Map<KeyType, ValueType, Compare>::count(const KeyType& key) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+size_t Map<KeyType, ValueType, Compare, Allocator>::count(const KeyType& key) const {
     return (this->data.search(key) != nullptr) ? 1 : 0;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Compare>::find(const KeyType& key) {
-    return Map<KeyType, ValueType, Compare>::Iterator(this->data.search(key), this->data.max());
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::Iterator Map<KeyType, ValueType, Compare, Allocator>::find(const KeyType& key) {
+    return Map<KeyType, ValueType, Compare, Allocator>::Iterator(this->data.search(key), this->data.max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::ConstIterator Map<KeyType, ValueType, Compare>::find(const KeyType& key) const {
-    return Map<KeyType, ValueType, Compare>::ConstIterator(this->data.search(key), this->data.max());
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator Map<KeyType, ValueType, Compare, Allocator>::find(const KeyType& key) const {
+    return Map<KeyType, ValueType, Compare, Allocator>::ConstIterator(this->data.search(key), this->data.max());
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Compare>::lower_bound(const KeyType& key) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::Iterator Map<KeyType, ValueType, Compare, Allocator>::lower_bound(const KeyType& key) {
     auto it = this->begin();
 
     for ( ; it != this->end() && !(key < it->key); it++);
@@ -247,8 +245,8 @@ typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Comp
     return it;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::ConstIterator Map<KeyType, ValueType, Compare>::lower_bound(const KeyType& key) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator Map<KeyType, ValueType, Compare, Allocator>::lower_bound(const KeyType& key) const {
     auto it = this->cbegin();
 
     for ( ; it != this->cend() && !(key < it->key); it++);
@@ -256,8 +254,8 @@ typename Map<KeyType, ValueType, Compare>::ConstIterator Map<KeyType, ValueType,
     return it;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Compare>::upper_bound(const KeyType& key) {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::Iterator Map<KeyType, ValueType, Compare, Allocator>::upper_bound(const KeyType& key) {
     auto it = this->begin();
 
     for ( ; it != this->end() && key > it->key ; it++);
@@ -265,8 +263,8 @@ typename Map<KeyType, ValueType, Compare>::Iterator Map<KeyType, ValueType, Comp
     return it;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-typename Map<KeyType, ValueType, Compare>::ConstIterator Map<KeyType, ValueType, Compare>::upper_bound(const KeyType& key) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator Map<KeyType, ValueType, Compare, Allocator>::upper_bound(const KeyType& key) const {
     auto it = this->cbegin();
 
     for ( ; it != this->cend() && key > it->key ; it++);
@@ -274,42 +272,42 @@ typename Map<KeyType, ValueType, Compare>::ConstIterator Map<KeyType, ValueType,
     return it;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-Pair<typename Map<KeyType, ValueType, Compare>::Iterator, typename Map<KeyType, ValueType, Compare>::Iterator> Map<KeyType, ValueType, Compare>::equal_range(const KeyType& key) {
-    return Pair<typename Map<KeyType, ValueType, Compare>::Iterator, typename Map<KeyType, ValueType, Compare>::Iterator>(this->lower_bound(key), this->upper_bound(key));
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+Pair<typename Map<KeyType, ValueType, Compare, Allocator>::Iterator, typename Map<KeyType, ValueType, Compare, Allocator>::Iterator> Map<KeyType, ValueType, Compare, Allocator>::equal_range(const KeyType& key) {
+    return Pair<typename Map<KeyType, ValueType, Compare, Allocator>::Iterator, typename Map<KeyType, ValueType, Compare, Allocator>::Iterator>(this->lower_bound(key), this->upper_bound(key));
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-Pair<typename Map<KeyType, ValueType, Compare>::ConstIterator, typename Map<KeyType, ValueType, Compare>::ConstIterator> Map<KeyType, ValueType, Compare>::equal_range(const KeyType& key) const {
-    return Pair<typename Map<KeyType, ValueType, Compare>::ConstIterator, typename Map<KeyType, ValueType, Compare>::ConstIterator>(this->lower_bound(key), this->upper_bound(key));
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+Pair<typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator, typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator> Map<KeyType, ValueType, Compare, Allocator>::equal_range(const KeyType& key) const {
+    return Pair<typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator, typename Map<KeyType, ValueType, Compare, Allocator>::ConstIterator>(this->lower_bound(key), this->upper_bound(key));
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool Map<KeyType, ValueType, Compare>::operator==(const Map<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool Map<KeyType, ValueType, Compare, Allocator>::operator==(const Map<KeyType, ValueType, Compare, Allocator>& other) const {
     return this->data == other.data;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool Map<KeyType, ValueType, Compare>::operator!=(const Map<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool Map<KeyType, ValueType, Compare, Allocator>::operator!=(const Map<KeyType, ValueType, Compare, Allocator>& other) const {
     return this->data != other.data;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool Map<KeyType, ValueType, Compare>::operator<(const Map<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool Map<KeyType, ValueType, Compare, Allocator>::operator<(const Map<KeyType, ValueType, Compare, Allocator>& other) const {
     return this->data < other.data;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool Map<KeyType, ValueType, Compare>::operator>(const Map<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool Map<KeyType, ValueType, Compare, Allocator>::operator>(const Map<KeyType, ValueType, Compare, Allocator>& other) const {
     return this->data > other.data;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool Map<KeyType, ValueType, Compare>::operator<=(const Map<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool Map<KeyType, ValueType, Compare, Allocator>::operator<=(const Map<KeyType, ValueType, Compare, Allocator>& other) const {
     return this->data < other.data;
 }
 
-template <typename KeyType, typename ValueType, typename Compare>
-bool Map<KeyType, ValueType, Compare>::operator>=(const Map<KeyType, ValueType, Compare>& other) const {
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+bool Map<KeyType, ValueType, Compare, Allocator>::operator>=(const Map<KeyType, ValueType, Compare, Allocator>& other) const {
     return this->data < other.data;
 }
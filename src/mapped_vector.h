@@ -0,0 +1,500 @@
+/**
+ * @file mapped_vector.h
+ *
+ * A vector of trivially copyable items living in a file mapped into memory.
+ * Linux only (mremap() is not portable).
+ */
+
+#pragma once
+
+#include "iterator.h"
+
+// Contains
+//      page_size() and round_to_pages()
+#include "mmap_allocator.h"
+
+// Used for open() and its flags.
+#include <fcntl.h>
+
+// Used for fstat().
+#include <sys/stat.h>
+
+// Used for ftruncate() and close().
+#include <unistd.h>
+
+// Used for errno.
+#include <cerrno>
+
+// Used for uint64_t.
+#include <cstdint>
+
+// Used for std::string.
+#include <string>
+
+// Used for std::system_error.
+#include <system_error>
+
+// Used for std::out_of_range and std::runtime_error.
+#include <stdexcept>
+
+// Used for is_trivially_copyable.
+#include <type_traits>
+
+/**
+ * @brief Header at the start of every MappedVector file, the items follow it
+ */
+struct MappedVectorHeader {
+    static constexpr uint64_t MAGIC = 0x3130764D4150414DULL;
+
+    /** @brief Size of the header, the items start at this offset */
+    static constexpr size_t SIZE = 64;
+
+    uint64_t magic;
+    uint64_t item_size;
+    uint64_t size;
+};
+
+/**
+ * @tparam ItemType the type of item stored, trivially copyable
+ */
+template <typename ItemType>
+/**
+ * @class MappedVector
+ *
+ * @brief Vector whose items are kept in a file, mapped with mmap(MAP_SHARED)
+ *
+ * Opening a file maps it and reads nothing, pages are faulted in when the items are
+ * touched and are shared through the page cache with every other process mapping the
+ * same file. Growth extends the file with ftruncate() and the mapping with mremap(),
+ * so the items are never copied.
+ *
+ * The file holds a MappedVectorHeader, then the items in the byte order of the machine.
+ * The size lives in the header, so every change is in the file as soon as the kernel
+ * writes the pages back; sync() forces that. The file is as large as the capacity.
+ *
+ * A read only MappedVector must not be modified, and does not see items appended by
+ * another process after it was opened.
+ */
+class MappedVector {
+    static_assert(std::is_trivially_copyable<ItemType>::value, "MappedVector needs trivially copyable items");
+    static_assert(alignof(ItemType) <= MappedVectorHeader::SIZE, "MappedVector items are aligned to at most the header size");
+
+    private:
+        typedef MappedVector<ItemType>  vector_type;
+
+        int descriptor;
+
+        char* mapping;
+        size_t mapping_bytes;
+
+        bool read_only;
+
+        MappedVectorHeader* header() const;
+        ItemType* items() const;
+
+        /** @brief Maps the file, creating the header if it is empty */
+        void map_file();
+
+        /** @brief Extends the file and the mapping to hold @b capacity items */
+        void remap(size_t capacity);
+
+        void release();
+
+    public:
+        typedef ItemType                value_type;
+        typedef ItemType*               pointer;
+        typedef const ItemType*         const_pointer;
+        typedef ItemType&               reference;
+        typedef const ItemType&         const_reference;
+
+        typedef size_t                  size_type;
+        typedef ptrdiff_t               difference_type;
+
+        typedef NormalIterator<pointer, vector_type>            iterator;
+        typedef NormalIterator<const_pointer, vector_type>      const_iterator;
+
+        /**
+         * @brief Maps the file at @b path, which is created if it does not exist and @b read_only is false
+         *
+         * @throw std::system_error if the file can not be opened, extended or mapped
+         *
+         *        std::runtime_error if the file was not written by a MappedVector of the same item size
+         */
+        explicit MappedVector(const std::string& path, bool read_only = false);
+
+        MappedVector(const MappedVector&) = delete;
+        MappedVector& operator=(const MappedVector&) = delete;
+
+        MappedVector(MappedVector&& other) noexcept;
+        MappedVector& operator=(MappedVector&& other) noexcept;
+
+        /** @brief Unmaps the file, without waiting for the kernel to write it back */
+        ~MappedVector();
+
+        reference operator[](size_type offset);
+        const_reference operator[](size_type offset) const;
+
+        /**
+         * @throw std::out_of_range if @b offset is not below size()
+         */
+        reference at(size_type offset);
+        const_reference at(size_type offset) const;
+
+        reference front();
+        const_reference front() const;
+
+        reference back();
+        const_reference back() const;
+
+        pointer data();
+        const_pointer data() const;
+
+        size_type size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+        /**
+         * @brief Extends the file to hold at least @b capacity items
+         *
+         * @throw std::system_error if the file or the mapping can not be extended
+         */
+        void reserve(size_type capacity);
+
+        /**
+         * @brief Truncates the file to the items it holds
+         */
+        void shrink_to_fit();
+
+        void push_back(const value_type& value);
+        void pop_back();
+
+        /**
+         * @brief Grows or shrinks to @b size items, the new ones are copies of @b value
+         */
+        void resize(size_type size, const value_type& value = value_type());
+
+        void clear();
+
+        /**
+         * @brief Checkpoints the items to the file with msync()
+         *
+         * @param wait whether to return only once the pages are written (MS_SYNC),
+         *        or as soon as the write back is scheduled (MS_ASYNC)
+         *
+         * @throw std::system_error if msync() fails
+         */
+        void sync(bool wait = true);
+};
+
+template <typename ItemType>
+MappedVector<ItemType>::MappedVector(const std::string& path, bool read_only) {
+    this->mapping = nullptr;
+    this->mapping_bytes = 0;
+
+    this->read_only = read_only;
+
+    this->descriptor = open(path.c_str(), read_only ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+
+    if (this->descriptor < 0)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not open " + path);
+
+    try {
+        this->map_file();
+    } catch (...) {
+        this->release();
+
+        throw;
+    }
+}
+
+template <typename ItemType>
+MappedVector<ItemType>::MappedVector(MappedVector&& other) noexcept {
+    this->descriptor = other.descriptor;
+    this->mapping = other.mapping;
+    this->mapping_bytes = other.mapping_bytes;
+    this->read_only = other.read_only;
+
+    other.descriptor = -1;
+    other.mapping = nullptr;
+    other.mapping_bytes = 0;
+}
+
+template <typename ItemType>
+MappedVector<ItemType>& MappedVector<ItemType>::operator=(MappedVector&& other) noexcept {
+    if (this != &other) {
+        this->release();
+
+        this->descriptor = other.descriptor;
+        this->mapping = other.mapping;
+        this->mapping_bytes = other.mapping_bytes;
+        this->read_only = other.read_only;
+
+        other.descriptor = -1;
+        other.mapping = nullptr;
+        other.mapping_bytes = 0;
+    }
+
+    return *this;
+}
+
+template <typename ItemType>
+MappedVector<ItemType>::~MappedVector() {
+    this->release();
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::release() {
+    if (this->mapping != nullptr)
+        munmap(this->mapping, this->mapping_bytes);
+
+    if (this->descriptor >= 0)
+        close(this->descriptor);
+
+    this->mapping = nullptr;
+    this->descriptor = -1;
+}
+
+template <typename ItemType>
+MappedVectorHeader* MappedVector<ItemType>::header() const {
+    return reinterpret_cast<MappedVectorHeader*>(this->mapping);
+}
+
+template <typename ItemType>
+ItemType* MappedVector<ItemType>::items() const {
+    return reinterpret_cast<ItemType*>(this->mapping + MappedVectorHeader::SIZE);
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::map_file() {
+    struct stat status;
+
+    if (fstat(this->descriptor, &status) != 0)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not stat its file");
+
+    size_t bytes = static_cast<size_t>(status.st_size);
+    bool created = (bytes == 0 && this->read_only == false);
+
+    if (created) {
+        bytes = round_to_pages(MappedVectorHeader::SIZE + sizeof(ItemType));
+
+        if (ftruncate(this->descriptor, static_cast<off_t>(bytes)) != 0)
+            throw std::system_error(errno, std::generic_category(), "MappedVector can not extend its file");
+    }
+
+    if (bytes < MappedVectorHeader::SIZE)
+        throw std::runtime_error("MappedVector file is too small to hold a header");
+
+    int protection = this->read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+    void* block = mmap(nullptr, bytes, protection, MAP_SHARED, this->descriptor, 0);
+
+    if (block == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not map its file");
+
+    this->mapping = static_cast<char*>(block);
+    this->mapping_bytes = bytes;
+
+    if (created) {
+        this->header()->magic = MappedVectorHeader::MAGIC;
+        this->header()->item_size = sizeof(ItemType);
+        this->header()->size = 0;
+    }
+
+    if (this->header()->magic != MappedVectorHeader::MAGIC || this->header()->item_size != sizeof(ItemType))
+        throw std::runtime_error("MappedVector file was not written with this item type");
+
+    if (this->header()->size > this->capacity())
+        throw std::runtime_error("MappedVector file is shorter than its size");
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::remap(size_t capacity) {
+    if (capacity > (size_t(-1) - MappedVectorHeader::SIZE - page_size()) / sizeof(ItemType))
+        throw std::length_error("MappedVector::reserve(size_type) exceeds the addressable size");
+
+    size_t bytes = round_to_pages(MappedVectorHeader::SIZE + capacity * sizeof(ItemType));
+
+    if (ftruncate(this->descriptor, static_cast<off_t>(bytes)) != 0)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not extend its file");
+
+    void* block = mremap(this->mapping, this->mapping_bytes, bytes, MREMAP_MAYMOVE);
+
+    if (block == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not extend its mapping");
+
+    this->mapping = static_cast<char*>(block);
+    this->mapping_bytes = bytes;
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::reference MappedVector<ItemType>::operator[](size_type offset) {
+    return this->items()[offset];
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::const_reference MappedVector<ItemType>::operator[](size_type offset) const {
+    return this->items()[offset];
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::reference MappedVector<ItemType>::at(size_type offset) {
+    if (offset >= this->size())
+        throw std::out_of_range("std::out_of_range in MappedVector::at(size_type offset)");
+
+    return this->items()[offset];
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::const_reference MappedVector<ItemType>::at(size_type offset) const {
+    if (offset >= this->size())
+        throw std::out_of_range("std::out_of_range in MappedVector::at(size_type offset) const");
+
+    return this->items()[offset];
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::reference MappedVector<ItemType>::front() {
+    return *this->begin();
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::const_reference MappedVector<ItemType>::front() const {
+    return *this->begin();
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::reference MappedVector<ItemType>::back() {
+    return *(this->end() - 1);
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::const_reference MappedVector<ItemType>::back() const {
+    return *(this->end() - 1);
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::pointer MappedVector<ItemType>::data() {
+    return this->items();
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::const_pointer MappedVector<ItemType>::data() const {
+    return this->items();
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::size_type MappedVector<ItemType>::size() const {
+    return static_cast<size_type>(this->header()->size);
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::size_type MappedVector<ItemType>::capacity() const {
+    return (this->mapping_bytes - MappedVectorHeader::SIZE) / sizeof(ItemType);
+}
+
+template <typename ItemType>
+bool MappedVector<ItemType>::empty() const {
+    return this->size() == 0;
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::iterator MappedVector<ItemType>::begin() {
+    return iterator(this->items());
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::const_iterator MappedVector<ItemType>::begin() const {
+    return const_iterator(this->items());
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::iterator MappedVector<ItemType>::end() {
+    return iterator(this->items() + this->size());
+}
+
+template <typename ItemType>
+typename MappedVector<ItemType>::const_iterator MappedVector<ItemType>::end() const {
+    return const_iterator(this->items() + this->size());
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::reserve(size_type capacity) {
+    if (capacity > this->capacity())
+        this->remap(capacity);
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::shrink_to_fit() {
+    size_t bytes = round_to_pages(MappedVectorHeader::SIZE + this->size() * sizeof(ItemType));
+
+    if (bytes >= this->mapping_bytes)
+        return;
+
+    void* block = mremap(this->mapping, this->mapping_bytes, bytes, 0);
+
+    if (block == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not shrink its mapping");
+
+    this->mapping_bytes = bytes;
+
+    if (ftruncate(this->descriptor, static_cast<off_t>(bytes)) != 0)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not truncate its file");
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::push_back(const value_type& value) {
+    size_type size = this->size();
+
+    if (size == this->capacity()) {
+        // value may be one of the items, the mapping can move.
+        value_type copy = value;
+
+        // The capacity is 0 for items larger than a page, doubling would not grow it.
+        this->remap((size > 0) ? 2 * size : 1);
+
+        this->items()[size] = copy;
+    } else {
+        this->items()[size] = value;
+    }
+
+    this->header()->size = size + 1;
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::pop_back() {
+    this->header()->size--;
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::resize(size_type size, const value_type& value) {
+    if (size > this->capacity()) {
+        value_type copy = value;
+
+        this->remap(size);
+
+        for (size_type index = this->size(); index < size; index++)
+            this->items()[index] = copy;
+    } else {
+        for (size_type index = this->size(); index < size; index++)
+            this->items()[index] = value;
+    }
+
+    this->header()->size = size;
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::clear() {
+    this->header()->size = 0;
+}
+
+template <typename ItemType>
+void MappedVector<ItemType>::sync(bool wait) {
+    if (msync(this->mapping, this->mapping_bytes, wait ? MS_SYNC : MS_ASYNC) != 0)
+        throw std::system_error(errno, std::generic_category(), "MappedVector can not sync its file");
+}
@@ -2,20 +2,278 @@
 
 #include "iterator.h"
 
+// Used for std::move_if_noexcept().
+#include <utility>
+
+// Used for std::is_trivially_copyable and std::is_trivially_default_constructible.
+#include <type_traits>
+
+// Used for memcpy().
+#include <cstring>
+
+// Used for placement new.
+#include <new>
+
+/*
+ * Size of a cache line. The atomics which different threads hammer in the lock-free
+ * containers are aligned to it, so that they do not share a line.
+ */
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/*
+ * The largest power of two number of items of item_size bytes fitting in block_bytes,
+ * at least 1. Used to size the blocks of the segmented containers.
+ */
+constexpr size_t block_items(size_t item_size, size_t block_bytes) {
+    size_t items = 1;
+
+    while (2 * items * item_size <= block_bytes)
+        items *= 2;
+
+    return items;
+}
+
+/*
+ * Tells whether an object can be moved to another address by copying its bytes,
+ * leaving nothing to destroy at the old address.
+ *
+ * Holds for every trivially copyable type. Specialize it for other types with that
+ * property (types which only own heap memory through a pointer, for example).
+ */
+template <typename ItemType>
+struct is_trivially_relocatable : public std::is_trivially_copyable<ItemType> {};
+
+/*
+ * Tells whether Allocator can grow a block, keeping its contents, through
+ *
+ *      ItemType* reallocate(ItemType* start, size_t size, size_t new_size)
+ *
+ * which returns the (possibly moved) block, or nullptr when it can not be grown.
+ * The contents are moved bytewise, so only trivially relocatable items may use it.
+ */
+template <typename Allocator, typename ItemType, typename = void>
+struct allocator_can_reallocate : public std::false_type {};
+
+template <typename Allocator, typename ItemType>
+struct allocator_can_reallocate<Allocator, ItemType,
+    decltype(void(std::declval<Allocator&>().reallocate(std::declval<ItemType*>(), size_t(), size_t())))> : public std::true_type {};
+
+template <typename ForwardIterator, typename Allocator>
+void destroy(ForwardIterator first, ForwardIterator last, const Allocator &allocator) {
+    auto temp_allocator(allocator);
+
+    for ( ; first != last; first++)
+        temp_allocator.destroy(first);
+}
+
+/*
+ * The uninitialized_* functions below construct items into raw memory. If a constructor
+ * throws, the items already built are destroyed before the exception propagates, so the
+ * memory is raw again and the caller only has to free it.
+ */
 template <typename ForwardIterator, typename Size, typename ItemType, typename Allocator>
 void uninitialized_fill(ForwardIterator first, Size size, const ItemType& value, const Allocator &allocator) {
     auto temp_allocator(allocator);
+    ForwardIterator start = first;
+
+    try {
+        for ( ; size--; first++)
+            temp_allocator.construct(first, typename IteratorTraits<ForwardIterator>::value_type(value));
+    } catch (...) {
+        destroy(start, first, allocator);
+
+        throw;
+    }
+}
 
+/*
+ * Tag asking for default-initialization (no zero fill for trivial types) instead of
+ * value-initialization, as in Vector::resize(size, default_init).
+ */
+struct default_init_t {};
+
+constexpr default_init_t default_init = default_init_t();
+
+/*
+ * Default-initializes size items starting at first. Trivially default constructible
+ * items are left as they are, so the memory is not touched at all.
+ */
+template <typename ItemType>
+void uninitialized_default_fill(ItemType*, size_t, std::true_type) {}
+
+template <typename ItemType>
+void uninitialized_default_fill(ItemType* first, size_t size, std::false_type) {
     for ( ; size--; first++)
-        temp_allocator.construct(first, typename IteratorTraits<ForwardIterator>::value_type(value));
+        ::new (static_cast<void*>(first)) ItemType;
+}
+
+template <typename ItemType>
+void uninitialized_default_fill(ItemType* first, size_t size) {
+    uninitialized_default_fill(first, size, std::is_trivially_default_constructible<ItemType>());
 }
 
 template <typename InputIterator, typename ForwardIterator, typename Allocator>
 ForwardIterator uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator to_first, const Allocator &allocator) {
     auto temp_allocator(allocator);
+    ForwardIterator start = to_first;
+
+    try {
+        for ( ; first != last; first++, to_first++)
+            temp_allocator.construct(to_first, typename IteratorTraits<ForwardIterator>::value_type(*first));
+    } catch (...) {
+        destroy(start, to_first, allocator);
+
+        throw;
+    }
+
+    return to_first;
+}
+
+/*
+ * Move-constructs [first, last) into the uninitialized memory starting at to_first.
+ *
+ * Falls back to copying when the move constructor of the type may throw, so that
+ * the source range stays intact if relocation fails halfway.
+ */
+template <typename InputIterator, typename ForwardIterator, typename Allocator>
+ForwardIterator uninitialized_move(InputIterator first, InputIterator last, ForwardIterator to_first, const Allocator &allocator) {
+    auto temp_allocator(allocator);
+    ForwardIterator start = to_first;
+
+    try {
+        for ( ; first != last; first++, to_first++)
+            temp_allocator.construct(to_first, std::move_if_noexcept(*first));
+    } catch (...) {
+        destroy(start, to_first, allocator);
+
+        throw;
+    }
+
+    return to_first;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* relocate(ItemType* first, ItemType* last, ItemType* to_first, const Allocator &, std::true_type) {
+    if (first != last)
+        memcpy(static_cast<void*>(to_first), static_cast<const void*>(first), (last - first) * sizeof(ItemType));
 
-    for ( ; first != last; first++, to_first++);
-        temp_allocator.construct(to_first, typename IteratorTraits<ForwardIterator>::value_type(*first));
+    return to_first + (last - first);
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* relocate(ItemType* first, ItemType* last, ItemType* to_first, const Allocator &allocator, std::false_type) {
+    to_first = uninitialized_move(first, last, to_first, allocator);
+
+    destroy(first, last, allocator);
 
     return to_first;
 }
+
+/*
+ * Moves [first, last) into the uninitialized memory starting at to_first, ending the
+ * lifetime of the source objects. Uses a single memcpy() for trivially relocatable types.
+ */
+template <typename ItemType, typename Allocator>
+ItemType* relocate(ItemType* first, ItemType* last, ItemType* to_first, const Allocator &allocator) {
+    return relocate(first, last, to_first, allocator, typename is_trivially_relocatable<ItemType>::type());
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* open_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &, std::true_type) {
+    if (position != finish)
+        memmove(static_cast<void*>(position + count), static_cast<const void*>(position), (finish - position) * sizeof(ItemType));
+
+    return finish + count;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* open_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &allocator, std::false_type) {
+    auto temp_allocator(allocator);
+
+    for (ItemType* it = finish; it != position; ) {
+        it--;
+
+        // Slots past the old end are raw memory and have to be constructed, not assigned.
+        if (it + count >= finish)
+            temp_allocator.construct(it + count, std::move(*it));
+        else
+            *(it + count) = std::move(*it);
+    }
+
+    destroy(position, (position + count < finish) ? position + count : finish, allocator);
+
+    return finish + count;
+}
+
+/*
+ * Shifts the elements of [position, finish) count slots to the right, leaving
+ * [position, position + count) as uninitialized memory. The storage has to be large
+ * enough already. Returns the new end of the range.
+ */
+template <typename ItemType, typename Allocator>
+ItemType* open_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &allocator) {
+    return open_gap(position, finish, count, allocator, typename is_trivially_relocatable<ItemType>::type());
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* close_raw_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &, std::true_type) {
+    if (position + count != finish)
+        memmove(static_cast<void*>(position), static_cast<const void*>(position + count), (finish - position - count) * sizeof(ItemType));
+
+    return finish - count;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* close_raw_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &allocator, std::false_type) {
+    auto temp_allocator(allocator);
+
+    for (ItemType* it = position + count; it != finish; it++) {
+        // Slots of the gap are raw memory and have to be constructed, not assigned.
+        if (it - count < position + count)
+            temp_allocator.construct(it - count, std::move(*it));
+        else
+            *(it - count) = std::move(*it);
+    }
+
+    destroy((finish - count > position + count) ? finish - count : position + count, finish, allocator);
+
+    return finish - count;
+}
+
+/*
+ * Undoes open_gap(): shifts the elements of [position + count, finish) count slots to the
+ * left, over the uninitialized [position, position + count). Returns the new end of the range.
+ */
+template <typename ItemType, typename Allocator>
+ItemType* close_raw_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &allocator) {
+    return close_raw_gap(position, finish, count, allocator, typename is_trivially_relocatable<ItemType>::type());
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* close_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &allocator, std::true_type) {
+    destroy(position, position + count, allocator);
+
+    if (position + count != finish)
+        memmove(static_cast<void*>(position), static_cast<const void*>(position + count), (finish - position - count) * sizeof(ItemType));
+
+    return finish - count;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType* close_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &allocator, std::false_type) {
+    for (ItemType* it = position + count; it != finish; it++)
+        *(it - count) = std::move(*it);
+
+    destroy(finish - count, finish, allocator);
+
+    return finish - count;
+}
+
+/*
+ * Destroys [position, position + count) and shifts the rest of [position, finish) over it.
+ * Returns the new end of the range.
+ */
+template <typename ItemType, typename Allocator>
+ItemType* close_gap(ItemType* position, ItemType* finish, size_t count, const Allocator &allocator) {
+    return close_gap(position, finish, count, allocator, typename is_trivially_relocatable<ItemType>::type());
+}
@@ -1,10 +1,34 @@
 #pragma once
 
+// Contains
+//      simd_equal() and simd_compare() kernels for contiguous ranges
+#include "simd.h"
+
+// Used for true_type and false_type.
+#include <type_traits>
+
 template <typename ItemType>
 class VectorCompare {
+    private:
+        int execute_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, const ItemType* last_2, std::true_type) const;
+        int execute_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, const ItemType* last_2, std::false_type) const;
+
+        bool equal_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, std::true_type) const;
+        bool equal_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, std::false_type) const;
+
     public:
         template <typename IteratorType>
         int execute(IteratorType first_1, IteratorType last_1, IteratorType first_2, IteratorType last_2) const;
+
+        /*
+         * Contiguous ranges of integral items are compared with the SIMD kernels.
+         */
+        int execute(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, const ItemType* last_2) const;
+
+        template <typename IteratorType>
+        bool equal(IteratorType first_1, IteratorType last_1, IteratorType first_2) const;
+
+        bool equal(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2) const;
 };
 
 template <typename ItemType>
@@ -28,6 +52,46 @@ int VectorCompare<ItemType>::execute(IteratorType first_1, IteratorType end_1, I
     return 0;
 }
 
+template <typename ItemType>
+int VectorCompare<ItemType>::execute(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, const ItemType* last_2) const {
+    return this->execute_choose(first_1, last_1, first_2, last_2, is_bitwise_comparable<ItemType>());
+}
+
+template <typename ItemType>
+int VectorCompare<ItemType>::execute_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, const ItemType* last_2, std::true_type) const {
+    return simd_compare(first_1, last_1 - first_1, first_2, last_2 - first_2);
+}
+
+template <typename ItemType>
+int VectorCompare<ItemType>::execute_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, const ItemType* last_2, std::false_type) const {
+    return this->execute<const ItemType*>(first_1, last_1, first_2, last_2);
+}
+
+template <typename ItemType>
+template <typename IteratorType>
+bool VectorCompare<ItemType>::equal(IteratorType first_1, IteratorType last_1, IteratorType first_2) const {
+    for ( ; first_1 != last_1; first_1++, first_2++)
+        if (!(*first_1 == *first_2))
+            return false;
+
+    return true;
+}
+
+template <typename ItemType>
+bool VectorCompare<ItemType>::equal(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2) const {
+    return this->equal_choose(first_1, last_1, first_2, is_bitwise_comparable<ItemType>());
+}
+
+template <typename ItemType>
+bool VectorCompare<ItemType>::equal_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, std::true_type) const {
+    return simd_equal(first_1, first_2, last_1 - first_1);
+}
+
+template <typename ItemType>
+bool VectorCompare<ItemType>::equal_choose(const ItemType* first_1, const ItemType* last_1, const ItemType* first_2, std::false_type) const {
+    return this->equal<const ItemType*>(first_1, last_1, first_2);
+}
+
 template <typename ItemType>
 class NodeCompare {
     public:
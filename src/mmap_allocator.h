@@ -0,0 +1,419 @@
+/**
+ * @file mmap_allocator.h
+ *
+ * Allocators serving their blocks straight from the kernel through mmap().
+ * Linux only (mremap() is not portable).
+ */
+
+#pragma once
+
+// Used for mmap(), munmap() and mremap().
+#include <sys/mman.h>
+
+// Used for sysconf().
+#include <unistd.h>
+
+// Used for std::bad_alloc and ::operator new.
+#include <new>
+
+// Used for uintptr_t.
+#include <cstdint>
+
+// Used for std::forward().
+#include <utility>
+
+// ptrdiff_t and size_t definitions.
+#include <cstddef>
+
+/**
+ * @brief Returns the size of a page, as reported by the kernel
+ */
+inline size_t page_size() {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    return size;
+}
+
+/**
+ * @brief Rounds a size in bytes up to a whole number of pages
+ */
+inline size_t round_to_pages(size_t bytes) {
+    return (bytes + page_size() - 1) & ~(page_size() - 1);
+}
+
+/**
+ * @tparam ItemType the type of item the allocated blocks hold
+ */
+template <typename ItemType>
+/**
+ * @class MmapAllocator
+ *
+ * @brief Allocator mapping every block as anonymous memory
+ *
+ * Every block takes at least one page, so it is meant for large vectors. It provides
+ * reallocate(), through which a Vector of trivially relocatable items grows with
+ * mremap(): the kernel moves the page table entries instead of the contents, so
+ * growth neither copies the elements nor needs the old and new block at once.
+ */
+class MmapAllocator {
+    public:
+        typedef ItemType            value_type;
+        typedef ItemType*           pointer;
+        typedef const ItemType*     const_pointer;
+        typedef ItemType&           reference;
+        typedef const ItemType&     const_reference;
+
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+
+        template <typename OtherType>
+        struct rebind {
+            typedef MmapAllocator<OtherType> other;
+        };
+
+        MmapAllocator() {}
+
+        template <typename OtherType>
+        MmapAllocator(const MmapAllocator<OtherType>&) {}
+
+        /**
+         * @brief Maps a block of at least @b size items, nullptr for 0 items
+         *
+         * @throw std::bad_alloc if the kernel refuses the mapping
+         */
+        pointer allocate(size_type size);
+
+        /**
+         * @brief Unmaps a block returned by allocate() or reallocate(), nullptr is ignored
+         */
+        void deallocate(pointer start, size_type size);
+
+        /**
+         * @brief Resizes a block of @b size items to @b new_size items with mremap()
+         *
+         * The block may be moved to another address, its contents are kept.
+         *
+         * @return
+         *      the new address of the block
+         *
+         *      nullptr if either size is 0 or the block could not be resized, in which case it
+         *      is left untouched
+         */
+        pointer reallocate(pointer start, size_type size, size_type new_size);
+
+        template <typename OtherType, typename... Args>
+        void construct(OtherType* position, Args&&... args);
+
+        template <typename OtherType>
+        void destroy(OtherType* position);
+
+        bool operator==(const MmapAllocator&) const;
+        bool operator!=(const MmapAllocator&) const;
+};
+
+template <typename ItemType>
+typename MmapAllocator<ItemType>::pointer MmapAllocator<ItemType>::allocate(size_type size) {
+    if (size > size_type(-1) / sizeof(ItemType))
+        throw std::bad_alloc();
+
+    // mmap() fails on an empty mapping.
+    if (size == 0)
+        return nullptr;
+
+    void* block = mmap(nullptr, round_to_pages(size * sizeof(ItemType)), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (block == MAP_FAILED)
+        throw std::bad_alloc();
+
+    return static_cast<pointer>(block);
+}
+
+template <typename ItemType>
+void MmapAllocator<ItemType>::deallocate(pointer start, size_type size) {
+    if (start != nullptr && size != 0)
+        munmap(start, round_to_pages(size * sizeof(ItemType)));
+}
+
+template <typename ItemType>
+typename MmapAllocator<ItemType>::pointer MmapAllocator<ItemType>::reallocate(pointer start, size_type size, size_type new_size) {
+    if (new_size > size_type(-1) / sizeof(ItemType))
+        return nullptr;
+
+    // There is no mapping to resize, or none to resize to, allocate() and deallocate() handle those.
+    if (start == nullptr || size == 0 || new_size == 0)
+        return nullptr;
+
+    size_t old_bytes = round_to_pages(size * sizeof(ItemType));
+    size_t new_bytes = round_to_pages(new_size * sizeof(ItemType));
+
+    if (old_bytes == new_bytes)
+        return start;
+
+    void* block = mremap(start, old_bytes, new_bytes, MREMAP_MAYMOVE);
+
+    if (block == MAP_FAILED)
+        return nullptr;
+
+    return static_cast<pointer>(block);
+}
+
+template <typename ItemType>
+template <typename OtherType, typename... Args>
+void MmapAllocator<ItemType>::construct(OtherType* position, Args&&... args) {
+    ::new (static_cast<void*>(position)) OtherType(std::forward<Args>(args)...);
+}
+
+template <typename ItemType>
+template <typename OtherType>
+void MmapAllocator<ItemType>::destroy(OtherType* position) {
+    position->~OtherType();
+}
+
+template <typename ItemType>
+bool MmapAllocator<ItemType>::operator==(const MmapAllocator&) const {
+    return true;
+}
+
+template <typename ItemType>
+bool MmapAllocator<ItemType>::operator!=(const MmapAllocator&) const {
+    return false;
+}
+
+/**
+ * @brief Size and alignment of a transparent huge page
+ */
+constexpr size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+
+/**
+ * @tparam ItemType the type of item the allocated blocks hold
+ */
+template <typename ItemType>
+/**
+ * @class HugePageAllocator
+ *
+ * @brief Allocator backing large blocks with transparent huge pages
+ *
+ * Blocks of at least @b threshold bytes are mapped directly, aligned to and rounded up to
+ * HUGE_PAGE_SIZE, and marked with madvise(MADV_HUGEPAGE), so that scans over them take a
+ * TLB entry per 2 MB instead of per 4 KB. With @b populate set, the pages are faulted in
+ * when the block is allocated rather than on first touch. Smaller blocks come from
+ * ::operator new.
+ *
+ * Large blocks grow through reallocate() with mremap(), into a new aligned range.
+ */
+class HugePageAllocator {
+    template <typename OtherType>
+    friend class HugePageAllocator;
+
+    private:
+        size_t threshold;
+        bool populate;
+
+        bool is_huge(size_t size) const;
+
+        static void* map_aligned(size_t bytes);
+        static void advise(void* block, size_t bytes, bool populate);
+
+    public:
+        typedef ItemType            value_type;
+        typedef ItemType*           pointer;
+        typedef const ItemType*     const_pointer;
+        typedef ItemType&           reference;
+        typedef const ItemType&     const_reference;
+
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+
+        template <typename OtherType>
+        struct rebind {
+            typedef HugePageAllocator<OtherType> other;
+        };
+
+        /**
+         * @param threshold the size in bytes from which blocks are mapped on huge pages
+         * @param populate whether huge blocks are pre-faulted on allocation
+         */
+        HugePageAllocator(size_t threshold = HUGE_PAGE_SIZE, bool populate = false);
+
+        template <typename OtherType>
+        HugePageAllocator(const HugePageAllocator<OtherType>& other);
+
+        /**
+         * @throw std::bad_alloc if the block can not be allocated
+         */
+        pointer allocate(size_type size);
+
+        void deallocate(pointer start, size_type size);
+
+        /**
+         * @brief Resizes a huge block of @b size items to @b new_size items with mremap()
+         *
+         * @return
+         *      the new address of the block
+         *
+         *      nullptr if either size is below the threshold or the block could not be
+         *      resized, in which case it is left untouched
+         */
+        pointer reallocate(pointer start, size_type size, size_type new_size);
+
+        template <typename OtherType, typename... Args>
+        void construct(OtherType* position, Args&&... args);
+
+        template <typename OtherType>
+        void destroy(OtherType* position);
+
+        bool operator==(const HugePageAllocator& other) const;
+        bool operator!=(const HugePageAllocator& other) const;
+};
+
+template <typename ItemType>
+HugePageAllocator<ItemType>::HugePageAllocator(size_t threshold, bool populate) {
+    this->threshold = threshold;
+    this->populate = populate;
+}
+
+template <typename ItemType>
+template <typename OtherType>
+HugePageAllocator<ItemType>::HugePageAllocator(const HugePageAllocator<OtherType>& other) {
+    this->threshold = other.threshold;
+    this->populate = other.populate;
+}
+
+template <typename ItemType>
+bool HugePageAllocator<ItemType>::is_huge(size_t size) const {
+    return size * sizeof(ItemType) >= this->threshold;
+}
+
+/*
+ * Maps bytes (a multiple of HUGE_PAGE_SIZE) at a HUGE_PAGE_SIZE aligned address,
+ * by over-mapping and trimming both ends. Returns nullptr on failure.
+ */
+template <typename ItemType>
+void* HugePageAllocator<ItemType>::map_aligned(size_t bytes) {
+    size_t mapped = bytes + HUGE_PAGE_SIZE;
+
+    void* block = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (block == MAP_FAILED)
+        return nullptr;
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(block);
+    uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+    if (aligned != start)
+        munmap(block, aligned - start);
+
+    if (aligned + bytes != start + mapped)
+        munmap(reinterpret_cast<void*>(aligned + bytes), start + mapped - aligned - bytes);
+
+    return reinterpret_cast<void*>(aligned);
+}
+
+template <typename ItemType>
+void HugePageAllocator<ItemType>::advise(void* block, size_t bytes, bool populate) {
+    madvise(block, bytes, MADV_HUGEPAGE);
+
+    if (populate == false)
+        return;
+
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(block, bytes, MADV_POPULATE_WRITE) == 0)
+        return;
+#endif
+
+    // Kernels before 5.14 have no MADV_POPULATE_WRITE, touch every huge page instead.
+    for (size_t offset = 0; offset < bytes; offset += HUGE_PAGE_SIZE)
+        static_cast<volatile char*>(block)[offset] = 0;
+}
+
+template <typename ItemType>
+typename HugePageAllocator<ItemType>::pointer HugePageAllocator<ItemType>::allocate(size_type size) {
+    if (size > (size_type(-1) - HUGE_PAGE_SIZE) / sizeof(ItemType))
+        throw std::bad_alloc();
+
+    if (this->is_huge(size) == false)
+        return static_cast<pointer>(::operator new(size * sizeof(ItemType)));
+
+    size_t bytes = (size * sizeof(ItemType) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+    void* block = map_aligned(bytes);
+
+    if (block == nullptr)
+        throw std::bad_alloc();
+
+    advise(block, bytes, this->populate);
+
+    return static_cast<pointer>(block);
+}
+
+template <typename ItemType>
+void HugePageAllocator<ItemType>::deallocate(pointer start, size_type size) {
+    if (this->is_huge(size) == false) {
+        ::operator delete(start);
+
+        return;
+    }
+
+    munmap(start, (size * sizeof(ItemType) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+}
+
+template <typename ItemType>
+typename HugePageAllocator<ItemType>::pointer HugePageAllocator<ItemType>::reallocate(pointer start, size_type size, size_type new_size) {
+    if (this->is_huge(size) == false || this->is_huge(new_size) == false)
+        return nullptr;
+
+    if (new_size > (size_type(-1) - HUGE_PAGE_SIZE) / sizeof(ItemType))
+        return nullptr;
+
+    size_t old_bytes = (size * sizeof(ItemType) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    size_t new_bytes = (new_size * sizeof(ItemType) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+    if (old_bytes == new_bytes)
+        return start;
+
+    if (new_bytes < old_bytes) {
+        munmap(reinterpret_cast<char*>(start) + new_bytes, old_bytes - new_bytes);
+
+        return start;
+    }
+
+    // Reserve an aligned range, then move the pages over it so the block stays aligned.
+    void* target = map_aligned(new_bytes);
+
+    if (target == nullptr)
+        return nullptr;
+
+    void* block = mremap(start, old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+
+    if (block == MAP_FAILED) {
+        munmap(target, new_bytes);
+
+        return nullptr;
+    }
+
+    advise(static_cast<char*>(block) + old_bytes, new_bytes - old_bytes, this->populate);
+
+    return static_cast<pointer>(block);
+}
+
+template <typename ItemType>
+template <typename OtherType, typename... Args>
+void HugePageAllocator<ItemType>::construct(OtherType* position, Args&&... args) {
+    ::new (static_cast<void*>(position)) OtherType(std::forward<Args>(args)...);
+}
+
+template <typename ItemType>
+template <typename OtherType>
+void HugePageAllocator<ItemType>::destroy(OtherType* position) {
+    position->~OtherType();
+}
+
+template <typename ItemType>
+bool HugePageAllocator<ItemType>::operator==(const HugePageAllocator& other) const {
+    return this->threshold == other.threshold;
+}
+
+template <typename ItemType>
+bool HugePageAllocator<ItemType>::operator!=(const HugePageAllocator& other) const {
+    return !(*this == other);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+// Used for is_trivially_relocatable.
+#include "mem_tools.h"
+
 template <typename Type_1, typename Type_2>
 class Pair {
     public:
@@ -35,3 +38,7 @@ template <typename Type_1, typename Type_2>
 bool Pair<Type_1, Type_2>::operator==(const Pair<Type_1, Type_2> &pair) {
     return this->first == pair.first && this->second == pair.second;
 }
+
+template <typename Type_1, typename Type_2>
+struct is_trivially_relocatable<Pair<Type_1, Type_2>> :
+    public std::integral_constant<bool, is_trivially_relocatable<Type_1>::value && is_trivially_relocatable<Type_2>::value> {};
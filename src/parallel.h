@@ -0,0 +1,439 @@
+/**
+ * @file parallel.h
+ *
+ * A work-stealing thread pool and parallel algorithms over random access ranges
+ * (Vector iterators or plain pointers).
+ */
+
+#pragma once
+
+// Used for std::thread.
+#include <thread>
+
+// Used for std::mutex.
+#include <mutex>
+
+// Used for std::condition_variable.
+#include <condition_variable>
+
+// Used for std::atomic.
+#include <atomic>
+
+// Used for std::function.
+#include <functional>
+
+// Used for the per-worker task queues.
+#include <deque>
+
+// Used for std::unique_ptr.
+#include <memory>
+
+// Used for std::exception_ptr.
+#include <exception>
+
+#include "vector.h"
+
+class ThreadPool;
+
+/*
+ * Workers record which pool they belong to, a thread may call into several pools.
+ */
+struct ThreadPoolWorker {
+    static const ThreadPool*& pool() {
+        static thread_local const ThreadPool* pool = nullptr;
+
+        return pool;
+    }
+
+    static size_t& index() {
+        static thread_local size_t index = 0;
+
+        return index;
+    }
+};
+
+/**
+ * @class ThreadPool
+ *
+ * @brief Pool of worker threads, each with its own task queue
+ *
+ * A worker runs the tasks of its own queue newest first, and when it runs dry steals the
+ * oldest task of another queue. Threads waiting on parallel work run queued tasks
+ * themselves instead of blocking, so parallel algorithms may be nested.
+ */
+class ThreadPool {
+    private:
+        /** @brief Task queue of a worker, locked by the owner and by thieves alike */
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        Vector<std::thread> workers;
+        std::unique_ptr<WorkerQueue[]> queues;
+
+        size_t worker_count;
+
+        /** @brief Queued tasks not yet taken by any thread */
+        std::atomic<size_t> pending;
+
+        /** @brief Queue the next task submitted from outside the pool goes to */
+        std::atomic<size_t> next_queue;
+
+        bool stopping;
+
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+
+        /** @brief Index of the calling thread's queue, or worker_count if it is not a worker of this pool */
+        size_t current_worker() const;
+
+        bool pop_task(size_t index, std::function<void()>& task);
+        bool steal_task(size_t thief, std::function<void()>& task);
+
+        void worker_loop(size_t index);
+
+    public:
+        /**
+         * @param threads the number of workers, the threads calling into the pool work too
+         */
+        explicit ThreadPool(size_t threads);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /** @brief Finishes the queued tasks, then joins the workers */
+        ~ThreadPool();
+
+        /**
+         * @brief The pool the parallel algorithms use by default
+         *
+         * Has one worker less than the hardware threads, since the caller works as well.
+         */
+        static ThreadPool& instance();
+
+        size_t size() const;
+
+        /** @brief Queues @b task, on the caller's own queue if it is a worker */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Runs one queued task on the calling thread
+         *
+         * @return false if there was no task to run
+         */
+        bool run_pending_task();
+
+        /**
+         * @brief Splits [0, size) in chunks of @b grain indices and calls body(first, last, chunk) on each
+         *
+         * The chunks are handed out dynamically to the caller and up to size() workers. Returns
+         * once every chunk is done; the first exception thrown by @b body is rethrown here and
+         * the chunks not started yet are skipped.
+         *
+         * @param grain the number of indices per chunk, 0 picks one from the size and the pool
+         */
+        template <typename Body>
+        void parallel_for(size_t size, size_t grain, Body body);
+};
+
+inline ThreadPool::ThreadPool(size_t threads) : queues(new WorkerQueue[threads + 1]) {
+    this->worker_count = threads;
+
+    this->pending = 0;
+    this->next_queue = 0;
+
+    this->stopping = false;
+
+    this->workers.reserve_exact(threads);
+
+    for (size_t index = 0; index < threads; index++)
+        this->workers.emplace_back(&ThreadPool::worker_loop, this, index);
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->sleep_mutex);
+
+        this->stopping = true;
+    }
+
+    this->wake.notify_all();
+
+    for (auto it = this->workers.begin(); it != this->workers.end(); it++)
+        it->join();
+}
+
+inline ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool((std::thread::hardware_concurrency() > 1) ? std::thread::hardware_concurrency() - 1 : 0);
+
+    return pool;
+}
+
+inline size_t ThreadPool::size() const {
+    return this->worker_count;
+}
+
+inline size_t ThreadPool::current_worker() const {
+    return (ThreadPoolWorker::pool() == this) ? ThreadPoolWorker::index() : this->worker_count;
+}
+
+inline bool ThreadPool::pop_task(size_t index, std::function<void()>& task) {
+    WorkerQueue& queue = this->queues[index];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+
+    this->pending--;
+
+    return true;
+}
+
+inline bool ThreadPool::steal_task(size_t thief, std::function<void()>& task) {
+    // Queue worker_count holds the tasks submitted from outside the pool.
+    for (size_t offset = 1; offset <= this->worker_count; offset++) {
+        WorkerQueue& queue = this->queues[(thief + offset) % (this->worker_count + 1)];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty())
+            continue;
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+
+        this->pending--;
+
+        return true;
+    }
+
+    return false;
+}
+
+inline void ThreadPool::worker_loop(size_t index) {
+    ThreadPoolWorker::pool() = this;
+    ThreadPoolWorker::index() = index;
+
+    std::function<void()> task;
+
+    while (true) {
+        if (this->pop_task(index, task) || this->steal_task(index, task)) {
+            task();
+
+            task = nullptr;
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->sleep_mutex);
+
+        this->wake.wait(lock, [this] { return this->stopping || this->pending > 0; });
+
+        if (this->stopping && this->pending == 0)
+            return;
+    }
+}
+
+inline void ThreadPool::submit(std::function<void()> task) {
+    size_t index = this->current_worker();
+
+    if (index == this->worker_count && this->worker_count > 0)
+        index = this->next_queue++ % this->worker_count;
+
+    {
+        std::lock_guard<std::mutex> lock(this->queues[index].mutex);
+
+        this->queues[index].tasks.push_back(std::move(task));
+
+        this->pending++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->sleep_mutex);
+    }
+
+    this->wake.notify_one();
+}
+
+inline bool ThreadPool::run_pending_task() {
+    size_t index = this->current_worker();
+
+    std::function<void()> task;
+
+    if (this->pop_task(index, task) || this->steal_task(index, task)) {
+        task();
+
+        return true;
+    }
+
+    return false;
+}
+
+template <typename Body>
+void ThreadPool::parallel_for(size_t size, size_t grain, Body body) {
+    if (size == 0)
+        return;
+
+    if (grain == 0) {
+        grain = size / (8 * (this->worker_count + 1));
+
+        if (grain == 0)
+            grain = 1;
+    }
+
+    size_t chunks = size / grain + ((size % grain) ? 1 : 0);
+
+    if (chunks == 1 || this->worker_count == 0) {
+        for (size_t chunk = 0; chunk < chunks; chunk++)
+            body(chunk * grain, (chunk + 1 == chunks) ? size : (chunk + 1) * grain, chunk);
+
+        return;
+    }
+
+    std::atomic<size_t> next_chunk(0);
+    std::atomic<size_t> running(0);
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        while (true) {
+            size_t chunk = next_chunk++;
+
+            if (chunk >= chunks)
+                return;
+
+            try {
+                body(chunk * grain, (chunk + 1 == chunks) ? size : (chunk + 1) * grain, chunk);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+
+                if (!error)
+                    error = std::current_exception();
+
+                next_chunk = chunks;
+            }
+        }
+    };
+
+    size_t helpers = (chunks - 1 < this->worker_count) ? chunks - 1 : this->worker_count;
+
+    running = helpers;
+
+    for (size_t helper = 0; helper < helpers; helper++)
+        this->submit([&]() {
+            work();
+
+            running--;
+        });
+
+    work();
+
+    // The helpers may still sit in a queue, run them (or anything else) instead of blocking.
+    while (running > 0)
+        if (this->run_pending_task() == false)
+            std::this_thread::yield();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/**
+ * @brief Calls @b function on every item of [first, last)
+ */
+template <typename RandomAccessIterator, typename Function>
+void parallel_for_each(RandomAccessIterator first, RandomAccessIterator last, Function function, size_t grain = 0, ThreadPool& pool = ThreadPool::instance()) {
+    pool.parallel_for(last - first, grain, [&](size_t begin, size_t end, size_t) {
+        for (RandomAccessIterator it = first + begin, chunk_last = first + end; it != chunk_last; it++)
+            function(*it);
+    });
+}
+
+/**
+ * @brief Stores @b operation applied to every item of [first, last) in the range starting at @b to_first
+ *
+ * @return the end of the output range
+ */
+template <typename RandomAccessIterator, typename OutputIterator, typename Operation>
+OutputIterator parallel_transform(RandomAccessIterator first, RandomAccessIterator last, OutputIterator to_first, Operation operation, size_t grain = 0, ThreadPool& pool = ThreadPool::instance()) {
+    pool.parallel_for(last - first, grain, [&](size_t begin, size_t end, size_t) {
+        OutputIterator to = to_first + begin;
+
+        for (RandomAccessIterator it = first + begin, chunk_last = first + end; it != chunk_last; it++, to++)
+            *to = operation(*it);
+    });
+
+    return to_first + (last - first);
+}
+
+/**
+ * @brief Folds [first, last) into @b init with @b operation
+ *
+ * Each chunk is folded on its own, then the chunk results are folded into @b init in
+ * order, so @b operation has to be associative but not commutative.
+ */
+template <typename RandomAccessIterator, typename ValueType, typename Operation>
+ValueType parallel_reduce(RandomAccessIterator first, RandomAccessIterator last, ValueType init, Operation operation, size_t grain = 0, ThreadPool& pool = ThreadPool::instance()) {
+    size_t size = last - first;
+
+    if (size == 0)
+        return init;
+
+    if (grain == 0) {
+        grain = size / (8 * (pool.size() + 1));
+
+        if (grain == 0)
+            grain = 1;
+    }
+
+    Vector<ValueType> partial;
+
+    partial.resize(size / grain + ((size % grain) ? 1 : 0), init);
+
+    pool.parallel_for(size, grain, [&](size_t begin, size_t end, size_t chunk) {
+        ValueType value = first[begin];
+
+        for (RandomAccessIterator it = first + begin + 1, chunk_last = first + end; it != chunk_last; it++)
+            value = operation(value, *it);
+
+        partial[chunk] = value;
+    });
+
+    for (size_t chunk = 0; chunk < partial.size(); chunk++)
+        init = operation(init, partial[chunk]);
+
+    return init;
+}
+
+/**
+ * @brief Assigns @b value to every item of [first, last)
+ */
+template <typename RandomAccessIterator, typename ValueType>
+void parallel_fill(RandomAccessIterator first, RandomAccessIterator last, const ValueType& value, size_t grain = 0, ThreadPool& pool = ThreadPool::instance()) {
+    pool.parallel_for(last - first, grain, [&](size_t begin, size_t end, size_t) {
+        for (RandomAccessIterator it = first + begin, chunk_last = first + end; it != chunk_last; it++)
+            *it = value;
+    });
+}
+
+/**
+ * @brief Copies [first, last) to the range starting at @b to_first
+ *
+ * @return the end of the output range
+ */
+template <typename RandomAccessIterator, typename OutputIterator>
+OutputIterator parallel_copy(RandomAccessIterator first, RandomAccessIterator last, OutputIterator to_first, size_t grain = 0, ThreadPool& pool = ThreadPool::instance()) {
+    pool.parallel_for(last - first, grain, [&](size_t begin, size_t end, size_t) {
+        OutputIterator to = to_first + begin;
+
+        for (RandomAccessIterator it = first + begin, chunk_last = first + end; it != chunk_last; it++, to++)
+            *to = *it;
+    });
+
+    return to_first + (last - first);
+}
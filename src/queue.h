@@ -0,0 +1,122 @@
+/**
+ * @file queue.h
+ *
+ * This module provides an implementation of a first-in first-out Queue
+ */
+
+#pragma once
+
+#include "deque.h"
+
+/**
+ * @tparam ItemType the type of item the queue will contain
+ * @tparam ContainerType the underlying container, providing push_back(), pop_front(), front() and back()
+ */
+template <typename ItemType, typename ContainerType = Deque<ItemType>>
+/**
+ * @class Queue
+ *
+ * @brief A class implementing a FIFO Queue-type container
+ *
+ * Items are pushed at the back of the underlying container and popped from its front,
+ * both in constant time with the default Deque.
+ */
+class Queue {
+    private:
+        /** @brief The underlying container of the Queue */
+        ContainerType container;
+
+    public:
+        /** @brief Default constructor */
+        Queue();
+
+        /**
+         * @brief Builds a Queue on top of a copy of @b container
+         */
+        explicit Queue(const ContainerType& container);
+
+        /**
+         * @brief Checks if the underlying container has no elements
+         *
+         * @return
+         *      true if the Queue is empty
+         *
+         *      false if the Queue is not empty
+         */
+        bool empty() const;
+        size_t size() const;
+
+        void push(const ItemType& value);
+        void push(ItemType&& value);
+
+        template <typename... Args>
+        void emplace(Args&&... args);
+
+        /** @brief Removes the oldest item */
+        void pop();
+
+        /** @brief The oldest item, the next one pop() removes */
+        ItemType& front();
+        const ItemType& front() const;
+
+        /** @brief The newest item */
+        ItemType& back();
+        const ItemType& back() const;
+};
+
+template <typename ItemType, typename ContainerType>
+Queue<ItemType, ContainerType>::Queue() {}
+
+template <typename ItemType, typename ContainerType>
+Queue<ItemType, ContainerType>::Queue(const ContainerType& container) : container(container) {}
+
+template <typename ItemType, typename ContainerType>
+bool Queue<ItemType, ContainerType>::empty() const {
+    return this->container.empty();
+}
+
+template <typename ItemType, typename ContainerType>
+size_t Queue<ItemType, ContainerType>::size() const {
+    return this->container.size();
+}
+
+template <typename ItemType, typename ContainerType>
+void Queue<ItemType, ContainerType>::push(const ItemType& value) {
+    this->container.push_back(value);
+}
+
+template <typename ItemType, typename ContainerType>
+void Queue<ItemType, ContainerType>::push(ItemType&& value) {
+    this->container.push_back(std::move(value));
+}
+
+template <typename ItemType, typename ContainerType>
+template <typename... Args>
+void Queue<ItemType, ContainerType>::emplace(Args&&... args) {
+    this->container.emplace_back(std::forward<Args>(args)...);
+}
+
+template <typename ItemType, typename ContainerType>
+void Queue<ItemType, ContainerType>::pop() {
+    this->container.pop_front();
+}
+
+template <typename ItemType, typename ContainerType>
+ItemType& Queue<ItemType, ContainerType>::front() {
+    return this->container.front();
+}
+
+template <typename ItemType, typename ContainerType>
+const ItemType& Queue<ItemType, ContainerType>::front() const {
+    return this->container.front();
+}
+
+template <typename ItemType, typename ContainerType>
+ItemType& Queue<ItemType, ContainerType>::back() {
+    return this->container.back();
+}
+
+template <typename ItemType, typename ContainerType>
+const ItemType& Queue<ItemType, ContainerType>::back() const {
+    return this->container.back();
+}
@@ -0,0 +1,611 @@
+/**
+ * @file ring_queue.h
+ *
+ * A bounded FIFO over a power of two ring buffer, for one thread, one producer and one
+ * consumer, or many of both.
+ */
+
+#pragma once
+
+// Contains
+//      CACHE_LINE_SIZE
+#include "mem_tools.h"
+
+// Used for std::atomic.
+#include <atomic>
+
+// Used for std::allocator.
+#include <memory>
+
+// Used for std::move() and std::forward().
+#include <utility>
+
+// Used for std::is_nothrow_constructible and std::is_nothrow_move_constructible.
+#include <type_traits>
+
+// ptrdiff_t and size_t definitions.
+#include <cstddef>
+
+/**
+ * @brief An index owned by a single thread, with the interface of std::atomic
+ */
+template <typename Value>
+struct PlainCounter {
+    Value value;
+
+    PlainCounter() : value(0) {}
+
+    Value load(std::memory_order) const {
+        return this->value;
+    }
+
+    void store(Value new_value, std::memory_order) {
+        this->value = new_value;
+    }
+};
+
+/*
+ * Concurrency modes of a RingQueue. The first two share one implementation and differ
+ * in the type of the head and tail indices, which the mode provides as counter<Value>.
+ */
+
+/**
+ * @brief RingQueue used by one thread at a time, the indices are plain integers
+ */
+struct SingleThreaded {
+    template <typename Value>
+    using counter = PlainCounter<Value>;
+};
+
+/**
+ * @brief RingQueue with one producer thread and one consumer thread
+ */
+struct SingleProducerSingleConsumer {
+    template <typename Value>
+    using counter = std::atomic<Value>;
+};
+
+/**
+ * @brief RingQueue any number of threads push to and pop from
+ */
+struct MultiProducerMultiConsumer {};
+
+/**
+ * @tparam ItemType the type of item stored
+ * @tparam Mode SingleThreaded, SingleProducerSingleConsumer or MultiProducerMultiConsumer
+ * @tparam Allocator the allocator of the ring, called once in the constructor
+ */
+template <typename ItemType, typename Mode = SingleThreaded, typename Allocator = std::allocator<ItemType>>
+/**
+ * @class RingQueue
+ *
+ * @brief Bounded FIFO whose items live in a ring of a power of two slots, allocated once
+ *
+ * The producer owns the tail index and the consumer the head index, each on its own cache
+ * line. Each side also keeps the last value it read of the other's index, and only reads it
+ * again when the ring looks full (or empty) according to that copy, so in the steady state
+ * neither side touches the other's cache line. In SingleProducerSingleConsumer mode an item
+ * is published by a release store of the tail and handed back by one of the head.
+ *
+ * push_n() and pop_n() move a whole batch for the price of one index update. A full ring
+ * makes pushes return false (or push fewer items), an empty one does the same to pops.
+ */
+class RingQueue {
+    private:
+        typedef typename Mode::template counter<size_t>  Counter;
+
+        /** @brief Next slot to push to, and the producer's copy of head */
+        alignas(CACHE_LINE_SIZE) Counter tail;
+        size_t cached_head;
+
+        /** @brief Next slot to pop from, and the consumer's copy of tail */
+        alignas(CACHE_LINE_SIZE) Counter head;
+        size_t cached_tail;
+
+        alignas(CACHE_LINE_SIZE) ItemType* slots;
+        size_t mask;
+
+        Allocator allocator;
+
+        /** @brief Free slots, reading head again only if fewer than @b wanted seem free */
+        size_t free_slots(size_t position, size_t wanted);
+
+        /** @brief Filled slots, reading tail again only if fewer than @b wanted seem filled */
+        size_t filled_slots(size_t position, size_t wanted);
+
+    public:
+        typedef ItemType    value_type;
+        typedef size_t      size_type;
+        typedef Allocator   allocator_type;
+
+        /**
+         * @brief Builds an empty queue of @b capacity slots, rounded up to a power of two
+         */
+        explicit RingQueue(size_t capacity, const allocator_type& allocator = allocator_type());
+
+        RingQueue(const RingQueue&) = delete;
+        RingQueue& operator=(const RingQueue&) = delete;
+
+        ~RingQueue();
+
+        size_type capacity() const;
+
+        /** @brief Number of items, a snapshot when the other side is active */
+        size_type size() const;
+        bool empty() const;
+
+        /**
+         * @brief Appends a copy of @b value
+         *
+         * @return false, pushing nothing, if the queue was full
+         */
+        bool try_push(const ItemType& value);
+        bool try_push(ItemType&& value);
+
+        template <typename... Args>
+        bool try_emplace(Args&&... args);
+
+        /**
+         * @brief Moves the oldest item into @b value and removes it
+         *
+         * @return false if the queue was empty
+         */
+        bool try_pop(ItemType& value);
+
+        /**
+         * @brief Appends copies of up to @b count items starting at @b first
+         *
+         * @return the number of items pushed, less than @b count when the queue fills up
+         */
+        template <typename InputIterator>
+        size_type push_n(InputIterator first, size_type count);
+
+        /**
+         * @brief Moves up to @b count of the oldest items to @b out and removes them
+         *
+         * @return the number of items popped, less than @b count when the queue runs empty
+         */
+        template <typename OutputIterator>
+        size_type pop_n(size_type count, OutputIterator out);
+};
+
+/**
+ * @tparam ItemType the type of item stored
+ * @tparam Allocator the allocator of the ring, called once in the constructor
+ */
+template <typename ItemType, typename Allocator>
+/**
+ * @class RingQueue
+ *
+ * @brief Bounded FIFO many threads may push to and pop from, without locks
+ *
+ * Follows Vyukov's bounded MPMC queue: every slot carries a sequence number telling which
+ * lap of the ring it is ready for, so a producer claims the slot at tail with one
+ * compare_exchange once its sequence says it is free, fills it, then publishes it by storing
+ * the next sequence; consumers do the same at head. Producers and consumers never touch the
+ * same index, and a slow thread only delays the slot it claimed.
+ *
+ * push_n() and pop_n() claim every ready slot of the batch with a single compare_exchange.
+ *
+ * Claimed slots can not be given back, so an item is only built in its slot if that can not
+ * throw; otherwise it is built first and moved in, and the move constructor must not throw.
+ * If moving an item out to pop_n()'s output throws, the rest of the batch is dropped.
+ */
+class RingQueue<ItemType, MultiProducerMultiConsumer, Allocator> {
+    private:
+        static_assert(std::is_nothrow_move_constructible<ItemType>::value,
+            "RingQueue<MultiProducerMultiConsumer> needs items whose move constructor does not throw");
+
+        struct Cell {
+            /** @brief Equals the position of the slot when free, the position plus one when filled */
+            std::atomic<size_t> sequence;
+            alignas(ItemType) unsigned char storage[sizeof(ItemType)];
+
+            ItemType* item() {
+                return reinterpret_cast<ItemType*>(this->storage);
+            }
+        };
+
+        typedef typename Allocator::template rebind<Cell>::other    CellAllocator;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head;
+
+        alignas(CACHE_LINE_SIZE) Cell* cells;
+        size_t mask;
+
+        CellAllocator allocator;
+
+        Cell& cell(size_t position);
+
+        /**
+         * @brief Claims up to @b count slots at @b index whose sequence is @b index plus @b lag
+         *
+         * @return the number of slots claimed, from the position left in @b position
+         */
+        size_t claim(std::atomic<size_t>& index, size_t lag, size_t count, size_t& position);
+
+        template <typename Value>
+        void fill(size_t position, Value&& value);
+
+        template <typename InputIterator>
+        size_t push_n_choose(InputIterator first, size_t count, std::true_type);
+
+        template <typename InputIterator>
+        size_t push_n_choose(InputIterator first, size_t count, std::false_type);
+
+    public:
+        typedef ItemType    value_type;
+        typedef size_t      size_type;
+        typedef Allocator   allocator_type;
+
+        explicit RingQueue(size_t capacity, const allocator_type& allocator = allocator_type());
+
+        RingQueue(const RingQueue&) = delete;
+        RingQueue& operator=(const RingQueue&) = delete;
+
+        /** @brief Destroys the remaining items, no thread may be using the queue */
+        ~RingQueue();
+
+        size_type capacity() const;
+
+        /** @brief Number of items, a snapshot while other threads are active */
+        size_type size() const;
+        bool empty() const;
+
+        bool try_push(const ItemType& value);
+        bool try_push(ItemType&& value);
+
+        template <typename... Args>
+        bool try_emplace(Args&&... args);
+
+        bool try_pop(ItemType& value);
+
+        template <typename InputIterator>
+        size_type push_n(InputIterator first, size_type count);
+
+        template <typename OutputIterator>
+        size_type pop_n(size_type count, OutputIterator out);
+};
+
+/**
+ * @brief The number of slots of a RingQueue asked for @b capacity items, at least 2
+ */
+inline size_t ring_capacity(size_t capacity) {
+    size_t rounded = 2;
+
+    while (rounded < capacity)
+        rounded *= 2;
+
+    return rounded;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+RingQueue<ItemType, Mode, Allocator>::RingQueue(size_t capacity, const allocator_type& allocator) :
+    cached_head(0), cached_tail(0), allocator(allocator) {
+    this->tail.store(0, std::memory_order_relaxed);
+    this->head.store(0, std::memory_order_relaxed);
+
+    this->mask = ring_capacity(capacity) - 1;
+    this->slots = this->allocator.allocate(this->mask + 1);
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+RingQueue<ItemType, Mode, Allocator>::~RingQueue() {
+    size_t last = this->tail.load(std::memory_order_acquire);
+
+    for (size_t position = this->head.load(std::memory_order_relaxed); position != last; position++)
+        this->allocator.destroy(this->slots + (position & this->mask));
+
+    this->allocator.deallocate(this->slots, this->mask + 1);
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+size_t RingQueue<ItemType, Mode, Allocator>::free_slots(size_t position, size_t wanted) {
+    size_t available = this->mask + 1 - (position - this->cached_head);
+
+    if (available >= wanted)
+        return available;
+
+    this->cached_head = this->head.load(std::memory_order_acquire);
+
+    return this->mask + 1 - (position - this->cached_head);
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+size_t RingQueue<ItemType, Mode, Allocator>::filled_slots(size_t position, size_t wanted) {
+    size_t available = this->cached_tail - position;
+
+    if (available >= wanted)
+        return available;
+
+    this->cached_tail = this->tail.load(std::memory_order_acquire);
+
+    return this->cached_tail - position;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+typename RingQueue<ItemType, Mode, Allocator>::size_type RingQueue<ItemType, Mode, Allocator>::capacity() const {
+    return this->mask + 1;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+typename RingQueue<ItemType, Mode, Allocator>::size_type RingQueue<ItemType, Mode, Allocator>::size() const {
+    size_t first = this->head.load(std::memory_order_acquire);
+
+    return this->tail.load(std::memory_order_acquire) - first;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+bool RingQueue<ItemType, Mode, Allocator>::empty() const {
+    return this->size() == 0;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+bool RingQueue<ItemType, Mode, Allocator>::try_push(const ItemType& value) {
+    return this->try_emplace(value);
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+bool RingQueue<ItemType, Mode, Allocator>::try_push(ItemType&& value) {
+    return this->try_emplace(std::move(value));
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+template <typename... Args>
+bool RingQueue<ItemType, Mode, Allocator>::try_emplace(Args&&... args) {
+    size_t position = this->tail.load(std::memory_order_relaxed);
+
+    if (this->free_slots(position, 1) == 0)
+        return false;
+
+    this->allocator.construct(this->slots + (position & this->mask), std::forward<Args>(args)...);
+    this->tail.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+bool RingQueue<ItemType, Mode, Allocator>::try_pop(ItemType& value) {
+    return this->pop_n(1, &value) == 1;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+template <typename InputIterator>
+typename RingQueue<ItemType, Mode, Allocator>::size_type RingQueue<ItemType, Mode, Allocator>::push_n(InputIterator first, size_type count) {
+    size_t position = this->tail.load(std::memory_order_relaxed);
+    size_t available = this->free_slots(position, count);
+    size_t pushed = 0;
+
+    if (count > available)
+        count = available;
+
+    try {
+        for ( ; pushed < count; pushed++, first++)
+            this->allocator.construct(this->slots + ((position + pushed) & this->mask), *first);
+    } catch (...) {
+        // The items built so far are pushed.
+        this->tail.store(position + pushed, std::memory_order_release);
+
+        throw;
+    }
+
+    this->tail.store(position + pushed, std::memory_order_release);
+
+    return pushed;
+}
+
+template <typename ItemType, typename Mode, typename Allocator>
+template <typename OutputIterator>
+typename RingQueue<ItemType, Mode, Allocator>::size_type RingQueue<ItemType, Mode, Allocator>::pop_n(size_type count, OutputIterator out) {
+    size_t position = this->head.load(std::memory_order_relaxed);
+    size_t available = this->filled_slots(position, count);
+    size_t popped = 0;
+
+    if (count > available)
+        count = available;
+
+    try {
+        for ( ; popped < count; popped++, out++) {
+            ItemType* item = this->slots + ((position + popped) & this->mask);
+
+            *out = std::move(*item);
+
+            this->allocator.destroy(item);
+        }
+    } catch (...) {
+        // The item which failed to move out stays first in the queue.
+        this->head.store(position + popped, std::memory_order_release);
+
+        throw;
+    }
+
+    this->head.store(position + popped, std::memory_order_release);
+
+    return popped;
+}
+
+template <typename ItemType, typename Allocator>
+RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::RingQueue(size_t capacity, const allocator_type& allocator) : allocator(allocator) {
+    this->tail.store(0, std::memory_order_relaxed);
+    this->head.store(0, std::memory_order_relaxed);
+
+    this->mask = ring_capacity(capacity) - 1;
+    this->cells = this->allocator.allocate(this->mask + 1);
+
+    for (size_t position = 0; position <= this->mask; position++) {
+        ::new (static_cast<void*>(this->cells + position)) Cell;
+
+        this->cells[position].sequence.store(position, std::memory_order_relaxed);
+    }
+}
+
+template <typename ItemType, typename Allocator>
+RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::~RingQueue() {
+    size_t last = this->tail.load(std::memory_order_acquire);
+
+    for (size_t position = this->head.load(std::memory_order_relaxed); position != last; position++)
+        this->cell(position).item()->~ItemType();
+
+    for (size_t position = 0; position <= this->mask; position++)
+        this->cells[position].~Cell();
+
+    this->allocator.deallocate(this->cells, this->mask + 1);
+}
+
+template <typename ItemType, typename Allocator>
+typename RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::Cell& RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::cell(size_t position) {
+    return this->cells[position & this->mask];
+}
+
+template <typename ItemType, typename Allocator>
+size_t RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::claim(std::atomic<size_t>& index, size_t lag, size_t count, size_t& position) {
+    position = index.load(std::memory_order_relaxed);
+
+    while (true) {
+        size_t ready = 0;
+
+        // A ready slot stays ready until some thread moves index past it, which would make
+        // the compare_exchange below fail.
+        while (ready < count && this->cell(position + ready).sequence.load(std::memory_order_acquire) == position + ready + lag)
+            ready++;
+
+        if (ready == 0) {
+            ptrdiff_t behind = static_cast<ptrdiff_t>(this->cell(position).sequence.load(std::memory_order_acquire) - (position + lag));
+
+            // The slot is a lap behind: the ring is full (or empty, for consumers).
+            if (behind < 0 || count == 0)
+                return 0;
+
+            position = index.load(std::memory_order_relaxed);
+
+            continue;
+        }
+
+        if (index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed, std::memory_order_relaxed))
+            return ready;
+    }
+}
+
+template <typename ItemType, typename Allocator>
+template <typename Value>
+void RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::fill(size_t position, Value&& value) {
+    Cell& target = this->cell(position);
+
+    ::new (static_cast<void*>(target.item())) ItemType(std::forward<Value>(value));
+
+    target.sequence.store(position + 1, std::memory_order_release);
+}
+
+template <typename ItemType, typename Allocator>
+typename RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::size_type RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::capacity() const {
+    return this->mask + 1;
+}
+
+template <typename ItemType, typename Allocator>
+typename RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::size_type RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::size() const {
+    size_t first = this->head.load(std::memory_order_acquire);
+    size_t last = this->tail.load(std::memory_order_acquire);
+
+    return (last > first) ? last - first : 0;
+}
+
+template <typename ItemType, typename Allocator>
+bool RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::empty() const {
+    return this->size() == 0;
+}
+
+template <typename ItemType, typename Allocator>
+bool RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::try_push(const ItemType& value) {
+    return this->push_n(&value, 1) == 1;
+}
+
+template <typename ItemType, typename Allocator>
+bool RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::try_push(ItemType&& value) {
+    size_t position;
+
+    if (this->claim(this->tail, 0, 1, position) == 0)
+        return false;
+
+    this->fill(position, std::move(value));
+
+    return true;
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+bool RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::try_emplace(Args&&... args) {
+    ItemType value(std::forward<Args>(args)...);
+
+    return this->try_push(std::move(value));
+}
+
+template <typename ItemType, typename Allocator>
+bool RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::try_pop(ItemType& value) {
+    return this->pop_n(1, &value) == 1;
+}
+
+template <typename ItemType, typename Allocator>
+template <typename InputIterator>
+size_t RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::push_n_choose(InputIterator first, size_t count, std::true_type) {
+    size_t position;
+    size_t claimed = this->claim(this->tail, 0, count, position);
+
+    for (size_t index = 0; index < claimed; index++, first++)
+        this->fill(position + index, *first);
+
+    return claimed;
+}
+
+template <typename ItemType, typename Allocator>
+template <typename InputIterator>
+size_t RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::push_n_choose(InputIterator first, size_t count, std::false_type) {
+    size_t pushed = 0;
+
+    // Copying may throw, so each item is copied before its slot is claimed.
+    for ( ; pushed < count; pushed++, first++) {
+        ItemType value(*first);
+
+        if (!this->try_push(std::move(value)))
+            break;
+    }
+
+    return pushed;
+}
+
+template <typename ItemType, typename Allocator>
+template <typename InputIterator>
+typename RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::size_type RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::push_n(InputIterator first, size_type count) {
+    return this->push_n_choose(first, count, std::is_nothrow_constructible<ItemType, decltype(*first)>());
+}
+
+template <typename ItemType, typename Allocator>
+template <typename OutputIterator>
+typename RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::size_type RingQueue<ItemType, MultiProducerMultiConsumer, Allocator>::pop_n(size_type count, OutputIterator out) {
+    size_t position;
+    size_t claimed = this->claim(this->head, 1, count, position);
+    size_t index = 0;
+
+    try {
+        for ( ; index < claimed; index++, out++) {
+            Cell& source = this->cell(position + index);
+
+            *out = std::move(*source.item());
+
+            source.item()->~ItemType();
+            source.sequence.store(position + index + this->mask + 1, std::memory_order_release);
+        }
+    } catch (...) {
+        // The slots are claimed already, their items can only be dropped.
+        for ( ; index < claimed; index++) {
+            Cell& source = this->cell(position + index);
+
+            source.item()->~ItemType();
+            source.sequence.store(position + index + this->mask + 1, std::memory_order_release);
+        }
+
+        throw;
+    }
+
+    return claimed;
+}
@@ -0,0 +1,318 @@
+/**
+ * @file serialize.h
+ *
+ * Binary snapshots of a Vector, written to and read from a file descriptor or a stream.
+ *
+ * A snapshot starts with a SerialHeader. Trivially copyable items follow as one raw block,
+ * written straight from the Vector's storage and read straight into it. Other items are
+ * turned into bytes by a codec and written as a sequence of chunks, each one a
+ * SerialChunk followed by the bytes of a whole number of items, ending with a chunk of
+ * no bytes and no items.
+ *
+ * A codec is any object providing
+ *
+ *      void encode(const ItemType& item, Vector<char>& bytes)
+ *          appends the bytes of item to bytes
+ *
+ *      const char* decode(const char* first, const char* last, ItemType& item)
+ *          reads one item from the bytes at first, returns past its last byte
+ */
+
+#pragma once
+
+#include "vector.h"
+
+// Used for read() and write().
+#include <unistd.h>
+
+// Used for errno and EINTR.
+#include <cerrno>
+
+// Used for uint8_t, uint16_t, uint32_t and uint64_t.
+#include <cstdint>
+
+// Used for std::istream and std::ostream.
+#include <istream>
+#include <ostream>
+
+// Used for std::system_error.
+#include <system_error>
+
+// Used for std::runtime_error.
+#include <stdexcept>
+
+// Used for is_trivially_copyable.
+#include <type_traits>
+
+/**
+ * @brief Header of every snapshot
+ *
+ * The header itself is written in the byte order of the writer, which @b endianness records.
+ */
+struct SerialHeader {
+    static constexpr uint32_t MAGIC = 0x4C524553;
+    static constexpr uint16_t VERSION = 1;
+
+    static constexpr uint8_t LITTLE_ENDIAN_ORDER = 1;
+    static constexpr uint8_t BIG_ENDIAN_ORDER = 2;
+
+    /** @brief Values of @b format */
+    static constexpr uint8_t RAW = 0;
+    static constexpr uint8_t CHUNKED = 1;
+
+    uint32_t magic;
+    uint16_t version;
+    uint8_t endianness;
+    uint8_t format;
+
+    /** @brief sizeof(ItemType) for raw snapshots, 0 for chunked ones */
+    uint64_t item_size;
+    uint64_t count;
+
+    static uint8_t native_endianness() {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return BIG_ENDIAN_ORDER;
+#else
+        return LITTLE_ENDIAN_ORDER;
+#endif
+    }
+};
+
+/**
+ * @brief Header of a chunk of encoded items
+ */
+struct SerialChunk {
+    uint32_t bytes;
+    uint32_t count;
+};
+
+/**
+ * @brief Bytes of encoded items gathered before a chunk is written
+ */
+constexpr size_t SERIAL_CHUNK_SIZE = size_t(1) << 16;
+
+/*
+ * Raw transfers, looping over the partial reads and writes of file descriptors.
+ */
+inline void serial_write(int descriptor, const void* bytes, size_t size) {
+    const char* position = static_cast<const char*>(bytes);
+
+    while (size > 0) {
+        ssize_t written = write(descriptor, position, size);
+
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+
+            throw std::system_error(errno, std::generic_category(), "write_to() can not write");
+        }
+
+        position += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+inline void serial_write(std::ostream& stream, const void* bytes, size_t size) {
+    if (!stream.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size)))
+        throw std::runtime_error("write_to() can not write to the stream");
+}
+
+inline void serial_read(int descriptor, void* bytes, size_t size) {
+    char* position = static_cast<char*>(bytes);
+
+    while (size > 0) {
+        ssize_t count = read(descriptor, position, size);
+
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+
+            throw std::system_error(errno, std::generic_category(), "read_from() can not read");
+        }
+
+        if (count == 0)
+            throw std::runtime_error("read_from() reached the end of the snapshot early");
+
+        position += count;
+        size -= static_cast<size_t>(count);
+    }
+}
+
+inline void serial_read(std::istream& stream, void* bytes, size_t size) {
+    if (!stream.read(static_cast<char*>(bytes), static_cast<std::streamsize>(size)))
+        throw std::runtime_error("read_from() reached the end of the snapshot early");
+}
+
+template <typename Stream>
+SerialHeader serial_read_header(Stream& stream, uint8_t format) {
+    SerialHeader header;
+
+    serial_read(stream, &header, sizeof(SerialHeader));
+
+    if (header.magic != SerialHeader::MAGIC || header.version != SerialHeader::VERSION)
+        throw std::runtime_error("read_from() found no snapshot of a known version");
+
+    if (header.endianness != SerialHeader::native_endianness())
+        throw std::runtime_error("read_from() found a snapshot of another byte order");
+
+    if (header.format != format)
+        throw std::runtime_error("read_from() found a snapshot of another format");
+
+    return header;
+}
+
+/*
+ * Makes room for size items to be read over, without constructing them first when
+ * their default constructor does nothing.
+ */
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void serial_prepare(Vector<ItemType, Allocator, GrowthPolicy>& vec, size_t size, std::true_type) {
+    vec.clear();
+    vec.resize_uninitialized(size);
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void serial_prepare(Vector<ItemType, Allocator, GrowthPolicy>& vec, size_t size, std::false_type) {
+    vec.clear();
+    vec.resize(size);
+}
+
+/**
+ * @brief Writes @b vec to @b stream, a file descriptor or a std::ostream, as one raw block
+ *
+ * @throw std::system_error or std::runtime_error if the write fails
+ */
+template <typename Stream, typename ItemType, typename Allocator, typename GrowthPolicy>
+void write_to(Stream&& stream, const Vector<ItemType, Allocator, GrowthPolicy>& vec) {
+    static_assert(std::is_trivially_copyable<ItemType>::value, "write_to() needs a codec for items that are not trivially copyable");
+
+    SerialHeader header = {SerialHeader::MAGIC, SerialHeader::VERSION, SerialHeader::native_endianness(),
+        SerialHeader::RAW, sizeof(ItemType), vec.size()};
+
+    serial_write(stream, &header, sizeof(SerialHeader));
+
+    if (vec.empty() == false)
+        serial_write(stream, vec.begin().base(), vec.size() * sizeof(ItemType));
+}
+
+/**
+ * @brief Replaces the items of @b vec with a snapshot written by write_to()
+ *
+ * The items are read straight into the storage of @b vec.
+ *
+ * @throw std::runtime_error if the snapshot is truncated or was written for another item size,
+ *        byte order or format
+ *
+ *        std::system_error if the read fails
+ */
+template <typename Stream, typename ItemType, typename Allocator, typename GrowthPolicy>
+void read_from(Stream&& stream, Vector<ItemType, Allocator, GrowthPolicy>& vec) {
+    static_assert(std::is_trivially_copyable<ItemType>::value, "read_from() needs a codec for items that are not trivially copyable");
+
+    SerialHeader header = serial_read_header(stream, SerialHeader::RAW);
+
+    if (header.item_size != sizeof(ItemType))
+        throw std::runtime_error("read_from() found a snapshot of another item size");
+
+    if (header.count > vec.max_size())
+        throw std::length_error("read_from() found a snapshot larger than Vector::max_size()");
+
+    serial_prepare(vec, header.count, std::is_trivially_default_constructible<ItemType>());
+
+    if (header.count > 0)
+        serial_read(stream, vec.begin().base(), header.count * sizeof(ItemType));
+}
+
+/**
+ * @brief Writes @b vec to @b stream in chunks of items encoded by @b codec
+ *
+ * Only one chunk is held in memory at a time.
+ */
+template <typename Stream, typename ItemType, typename Allocator, typename GrowthPolicy, typename Codec>
+void write_to(Stream&& stream, const Vector<ItemType, Allocator, GrowthPolicy>& vec, Codec&& codec) {
+    SerialHeader header = {SerialHeader::MAGIC, SerialHeader::VERSION, SerialHeader::native_endianness(),
+        SerialHeader::CHUNKED, 0, vec.size()};
+
+    serial_write(stream, &header, sizeof(SerialHeader));
+
+    Vector<char> bytes;
+    SerialChunk chunk = {0, 0};
+
+    bytes.reserve(SERIAL_CHUNK_SIZE);
+
+    for (auto it = vec.begin(); it != vec.end(); it++) {
+        codec.encode(*it, bytes);
+
+        chunk.count++;
+
+        if (bytes.size() >= SERIAL_CHUNK_SIZE || chunk.count == uint32_t(-1) || it + 1 == vec.end()) {
+            if (bytes.size() > uint32_t(-1))
+                throw std::length_error("write_to() encoded an item larger than a chunk can hold");
+
+            chunk.bytes = static_cast<uint32_t>(bytes.size());
+
+            serial_write(stream, &chunk, sizeof(SerialChunk));
+            serial_write(stream, bytes.begin().base(), bytes.size());
+
+            bytes.clear();
+            chunk.count = 0;
+        }
+    }
+
+    chunk.bytes = 0;
+    chunk.count = 0;
+
+    serial_write(stream, &chunk, sizeof(SerialChunk));
+}
+
+/**
+ * @brief Replaces the items of @b vec with a snapshot written by write_to() with a codec
+ *
+ * Items are default constructed, then decoded over.
+ *
+ * @throw std::runtime_error if the snapshot is truncated, malformed or not a chunked one
+ */
+template <typename Stream, typename ItemType, typename Allocator, typename GrowthPolicy, typename Codec>
+void read_from(Stream&& stream, Vector<ItemType, Allocator, GrowthPolicy>& vec, Codec&& codec) {
+    SerialHeader header = serial_read_header(stream, SerialHeader::CHUNKED);
+
+    vec.clear();
+
+    if (header.count <= vec.max_size())
+        vec.reserve(header.count);
+
+    Vector<char> bytes;
+    SerialChunk chunk;
+
+    // Keeps the buffer allocated, so even a chunk of no bytes is decoded from a valid pointer.
+    bytes.reserve(SERIAL_CHUNK_SIZE);
+
+    while (true) {
+        serial_read(stream, &chunk, sizeof(SerialChunk));
+
+        if (chunk.bytes == 0 && chunk.count == 0)
+            break;
+
+        bytes.resize_uninitialized(chunk.bytes);
+
+        serial_read(stream, bytes.begin().base(), chunk.bytes);
+
+        const char* position = bytes.begin().base();
+        const char* last = position + chunk.bytes;
+
+        for (uint32_t index = 0; index < chunk.count; index++) {
+            vec.emplace_back();
+
+            position = codec.decode(position, last, vec.back());
+
+            if (position == nullptr || position > last)
+                throw std::runtime_error("read_from() found an item its codec can not decode");
+        }
+
+        if (position != last)
+            throw std::runtime_error("read_from() found bytes past the last item of a chunk");
+    }
+
+    if (vec.size() != header.count)
+        throw std::runtime_error("read_from() found fewer items than the snapshot holds");
+}
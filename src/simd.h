@@ -0,0 +1,179 @@
+#pragma once
+
+// size_t definition.
+#include <cstddef>
+
+// Used for uint64_t.
+#include <cstdint>
+
+// Used for memcpy().
+#include <cstring>
+
+// Used for is_integral.
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+
+// Used for the SSE2 and AVX2 intrinsics.
+#include <immintrin.h>
+#endif
+
+/*
+ * Vectorized kernels comparing contiguous ranges.
+ *
+ * Integral items are equal exactly when their bytes are, so two ranges of them are
+ * compared by looking for their first differing byte, 32 or 16 bytes at a time. The
+ * widest kernel the CPU supports is picked once, at the first call.
+ */
+
+/*
+ * Whether ranges of ItemType can be compared bytewise. Floating point items can not,
+ * since 0.0 == -0.0 and NaN != NaN.
+ */
+template <typename ItemType>
+struct is_bitwise_comparable : public std::is_integral<ItemType> {};
+
+typedef size_t (*MismatchKernel)(const unsigned char* first_1, const unsigned char* first_2, size_t bytes);
+
+/*
+ * Returns the offset of the first byte where the two blocks differ, or bytes if they are equal.
+ */
+inline size_t mismatch_scalar(const unsigned char* first_1, const unsigned char* first_2, size_t bytes) {
+    size_t offset = 0;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for ( ; offset + sizeof(uint64_t) <= bytes; offset += sizeof(uint64_t)) {
+        uint64_t word_1, word_2;
+
+        memcpy(&word_1, first_1 + offset, sizeof(uint64_t));
+        memcpy(&word_2, first_2 + offset, sizeof(uint64_t));
+
+        if (word_1 != word_2)
+            return offset + __builtin_ctzll(word_1 ^ word_2) / 8;
+    }
+#endif
+
+    for ( ; offset < bytes; offset++)
+        if (first_1[offset] != first_2[offset])
+            return offset;
+
+    return bytes;
+}
+
+#ifdef SIMD_X86
+__attribute__((target("sse2")))
+inline size_t mismatch_sse2(const unsigned char* first_1, const unsigned char* first_2, size_t bytes) {
+    size_t offset = 0;
+
+    for ( ; offset + 16 <= bytes; offset += 16) {
+        __m128i block_1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first_1 + offset));
+        __m128i block_2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first_2 + offset));
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block_1, block_2)));
+
+        if (mask != 0xFFFF)
+            return offset + __builtin_ctz(~mask);
+    }
+
+    return offset + mismatch_scalar(first_1 + offset, first_2 + offset, bytes - offset);
+}
+
+__attribute__((target("avx2")))
+inline size_t mismatch_avx2(const unsigned char* first_1, const unsigned char* first_2, size_t bytes) {
+    size_t offset = 0;
+
+    // Two blocks per iteration, merged into a single test on the common path.
+    for ( ; offset + 64 <= bytes; offset += 64) {
+        __m256i equal_low = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_1 + offset)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_2 + offset)));
+
+        __m256i equal_high = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_1 + offset + 32)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_2 + offset + 32)));
+
+        if (static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(equal_low, equal_high))) != 0xFFFFFFFFu) {
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(equal_low));
+
+            if (mask != 0xFFFFFFFFu)
+                return offset + __builtin_ctz(~mask);
+
+            mask = static_cast<unsigned>(_mm256_movemask_epi8(equal_high));
+
+            return offset + 32 + __builtin_ctz(~mask);
+        }
+    }
+
+    for ( ; offset + 32 <= bytes; offset += 32) {
+        __m256i block_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_1 + offset));
+        __m256i block_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_2 + offset));
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_1, block_2)));
+
+        if (mask != 0xFFFFFFFFu)
+            return offset + __builtin_ctz(~mask);
+    }
+
+    return offset + mismatch_sse2(first_1 + offset, first_2 + offset, bytes - offset);
+}
+#endif
+
+inline MismatchKernel select_mismatch_kernel() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return mismatch_avx2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return mismatch_sse2;
+#endif
+
+    return mismatch_scalar;
+}
+
+inline size_t mismatch_bytes(const void* first_1, const void* first_2, size_t bytes) {
+    static const MismatchKernel kernel = select_mismatch_kernel();
+
+    return kernel(static_cast<const unsigned char*>(first_1), static_cast<const unsigned char*>(first_2), bytes);
+}
+
+/*
+ * Returns whether the size items starting at first_1 and first_2 are equal.
+ */
+template <typename ItemType>
+bool simd_equal(const ItemType* first_1, const ItemType* first_2, size_t size) {
+    static_assert(is_bitwise_comparable<ItemType>::value, "simd_equal needs bitwise comparable items");
+
+    if (size == 0 || first_1 == first_2)
+        return true;
+
+    return mismatch_bytes(first_1, first_2, size * sizeof(ItemType)) == size * sizeof(ItemType);
+}
+
+/*
+ * Three-way lexicographic compare of [first_1, first_1 + size_1) and [first_2, first_2 + size_2),
+ * with the same result as VectorCompare::execute(): -1, 0 or 1.
+ *
+ * The kernels only find the first differing item, which is then compared by value, so
+ * signed and multi-byte items order correctly (a bare memcmp() would not).
+ */
+template <typename ItemType>
+int simd_compare(const ItemType* first_1, size_t size_1, const ItemType* first_2, size_t size_2) {
+    static_assert(is_bitwise_comparable<ItemType>::value, "simd_compare needs bitwise comparable items");
+
+    size_t size = (size_1 < size_2) ? size_1 : size_2;
+    size_t offset = (size == 0) ? 0 : mismatch_bytes(first_1, first_2, size * sizeof(ItemType));
+
+    if (offset < size * sizeof(ItemType)) {
+        size_t index = offset / sizeof(ItemType);
+
+        return (first_1[index] < first_2[index]) ? -1 : 1;
+    }
+
+    if (size_1 == size_2)
+        return 0;
+
+    return (size_1 < size_2) ? -1 : 1;
+}
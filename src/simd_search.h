@@ -0,0 +1,398 @@
+#pragma once
+
+// Contains
+//      SIMD_X86 and the runtime CPU dispatch pattern
+#include "simd.h"
+
+#include "iterator.h"
+#include "pair.h"
+
+// Used for numeric_limits.
+#include <limits>
+
+// Used for uint64_t.
+#include <cstdint>
+
+// Used for memcpy().
+#include <cstring>
+
+// Used for is_arithmetic and is_same.
+#include <type_traits>
+
+/*
+ * Searches over ranges of arithmetic items: simd_find(), simd_count(), simd_contains(),
+ * simd_min_element(), simd_max_element() and simd_minmax().
+ *
+ * Contiguous ranges (Vector iterators and pointers) are scanned with GCC vector extensions,
+ * 64, 32 or 16 bytes at a time depending on the CPU (AVX-512, AVX2 or SSE4.2, picked once at
+ * the first call), other ranges with plain loops. The value searched for is converted to the
+ * item type first. Minimum and maximum ignore NaN items.
+ */
+
+/*
+ * Whether the kernels handle ranges of ItemType.
+ */
+template <typename ItemType>
+struct is_simd_searchable : public std::integral_constant<bool, std::is_arithmetic<ItemType>::value &&
+    !std::is_same<ItemType, bool>::value && (sizeof(ItemType) == 1 || sizeof(ItemType) == 2 ||
+    sizeof(ItemType) == 4 || sizeof(ItemType) == 8)> {};
+
+/*
+ * Whether IteratorType walks over contiguous memory, which contiguous_pointer() returns.
+ */
+template <typename IteratorType>
+struct is_contiguous_iterator : public std::false_type {};
+
+template <typename ItemType>
+struct is_contiguous_iterator<ItemType*> : public std::true_type {};
+
+template <typename ItemType, typename Container>
+struct is_contiguous_iterator<NormalIterator<ItemType*, Container>> : public std::true_type {};
+
+template <typename ItemType>
+ItemType* contiguous_pointer(ItemType* iterator) {
+    return iterator;
+}
+
+template <typename ItemType, typename Container>
+ItemType* contiguous_pointer(const NormalIterator<ItemType*, Container>& iterator) {
+    return iterator.base();
+}
+
+template <typename IteratorType>
+struct use_search_kernels : public std::integral_constant<bool, is_contiguous_iterator<IteratorType>::value &&
+    is_simd_searchable<typename IteratorTraits<IteratorType>::value_type>::value> {};
+
+/*
+ * The kernels, written once for every vector width and inlined into one function per
+ * instruction set below.
+ */
+template <size_t Width, typename Mask>
+__attribute__((always_inline)) inline bool any_lane(const Mask& mask) {
+    uint64_t words[Width / sizeof(uint64_t)];
+
+    memcpy(words, &mask, Width);
+
+    uint64_t bits = 0;
+
+    for (size_t word = 0; word < Width / sizeof(uint64_t); word++)
+        bits |= words[word];
+
+    return bits != 0;
+}
+
+template <size_t Width, typename ItemType>
+__attribute__((always_inline)) inline size_t find_kernel(const ItemType* first, size_t size, ItemType value) {
+    typedef ItemType Block __attribute__((vector_size(Width)));
+
+    const size_t lanes = Width / sizeof(ItemType);
+
+    Block needle = Block{} + value;
+
+    size_t index = 0;
+
+    // Four blocks per test, the matching one is then located by the scalar loop.
+    for ( ; index + 4 * lanes <= size; index += 4 * lanes) {
+        Block block[4];
+
+        memcpy(block, first + index, 4 * Width);
+
+        if (any_lane<Width>((block[0] == needle) | (block[1] == needle) | (block[2] == needle) | (block[3] == needle)))
+            break;
+    }
+
+    for ( ; index < size; index++)
+        if (first[index] == value)
+            return index;
+
+    return size;
+}
+
+template <size_t Width, typename ItemType>
+__attribute__((always_inline)) inline size_t count_kernel(const ItemType* first, size_t size, ItemType value) {
+    typedef ItemType Block __attribute__((vector_size(Width)));
+    typedef decltype(Block{} == Block{}) Mask;
+
+    const size_t lanes = Width / sizeof(ItemType);
+
+    Block needle = Block{} + value;
+
+    size_t count = 0;
+    size_t index = 0;
+
+    while (index + lanes <= size) {
+        // Matches subtract -1 from their lane, flushed before a single byte lane can overflow.
+        Mask matches = Mask{};
+
+        for (size_t round = 0; round < 127 && index + lanes <= size; round++, index += lanes) {
+            Block block;
+
+            memcpy(&block, first + index, Width);
+
+            matches -= (block == needle);
+        }
+
+        for (size_t lane = 0; lane < lanes; lane++)
+            count += static_cast<size_t>(matches[lane]);
+    }
+
+    for ( ; index < size; index++)
+        if (first[index] == value)
+            count++;
+
+    return count;
+}
+
+template <size_t Width, typename ItemType>
+__attribute__((always_inline)) inline void minmax_kernel(const ItemType* first, size_t size, ItemType& low, ItemType& high) {
+    typedef ItemType Block __attribute__((vector_size(Width)));
+
+    const size_t lanes = Width / sizeof(ItemType);
+
+    // Starting from the extremes rather than the first items keeps NaN out of every lane.
+    ItemType largest = std::numeric_limits<ItemType>::has_infinity ? std::numeric_limits<ItemType>::infinity() : std::numeric_limits<ItemType>::max();
+    ItemType smallest = std::numeric_limits<ItemType>::has_infinity ? -std::numeric_limits<ItemType>::infinity() : std::numeric_limits<ItemType>::lowest();
+
+    Block block_low = Block{} + largest;
+    Block block_high = Block{} + smallest;
+
+    size_t index = 0;
+
+    for ( ; index + lanes <= size; index += lanes) {
+        Block block;
+
+        memcpy(&block, first + index, Width);
+
+        block_low = (block < block_low) ? block : block_low;
+        block_high = (block > block_high) ? block : block_high;
+    }
+
+    low = largest;
+    high = smallest;
+
+    for (size_t lane = 0; lane < lanes; lane++) {
+        if (block_low[lane] < low)
+            low = block_low[lane];
+
+        if (block_high[lane] > high)
+            high = block_high[lane];
+    }
+
+    for ( ; index < size; index++) {
+        if (first[index] < low)
+            low = first[index];
+
+        if (first[index] > high)
+            high = first[index];
+    }
+}
+
+template <typename ItemType>
+struct SearchKernels {
+    typedef size_t (*FindKernel)(const ItemType* first, size_t size, ItemType value);
+    typedef void (*MinMaxKernel)(const ItemType* first, size_t size, ItemType& low, ItemType& high);
+
+    FindKernel find;
+    FindKernel count;
+    MinMaxKernel minmax;
+};
+
+template <typename ItemType>
+size_t find_default(const ItemType* first, size_t size, ItemType value) {
+    return find_kernel<16>(first, size, value);
+}
+
+template <typename ItemType>
+size_t count_default(const ItemType* first, size_t size, ItemType value) {
+    return count_kernel<16>(first, size, value);
+}
+
+template <typename ItemType>
+void minmax_default(const ItemType* first, size_t size, ItemType& low, ItemType& high) {
+    minmax_kernel<16>(first, size, low, high);
+}
+
+#ifdef SIMD_X86
+template <typename ItemType>
+__attribute__((target("sse4.2"))) size_t find_sse42(const ItemType* first, size_t size, ItemType value) {
+    return find_kernel<16>(first, size, value);
+}
+
+template <typename ItemType>
+__attribute__((target("sse4.2"))) size_t count_sse42(const ItemType* first, size_t size, ItemType value) {
+    return count_kernel<16>(first, size, value);
+}
+
+template <typename ItemType>
+__attribute__((target("sse4.2"))) void minmax_sse42(const ItemType* first, size_t size, ItemType& low, ItemType& high) {
+    minmax_kernel<16>(first, size, low, high);
+}
+
+template <typename ItemType>
+__attribute__((target("avx2"))) size_t find_avx2(const ItemType* first, size_t size, ItemType value) {
+    return find_kernel<32>(first, size, value);
+}
+
+template <typename ItemType>
+__attribute__((target("avx2"))) size_t count_avx2(const ItemType* first, size_t size, ItemType value) {
+    return count_kernel<32>(first, size, value);
+}
+
+template <typename ItemType>
+__attribute__((target("avx2"))) void minmax_avx2(const ItemType* first, size_t size, ItemType& low, ItemType& high) {
+    minmax_kernel<32>(first, size, low, high);
+}
+
+template <typename ItemType>
+__attribute__((target("avx512f,avx512bw"))) size_t find_avx512(const ItemType* first, size_t size, ItemType value) {
+    return find_kernel<64>(first, size, value);
+}
+
+template <typename ItemType>
+__attribute__((target("avx512f,avx512bw"))) size_t count_avx512(const ItemType* first, size_t size, ItemType value) {
+    return count_kernel<64>(first, size, value);
+}
+
+template <typename ItemType>
+__attribute__((target("avx512f,avx512bw"))) void minmax_avx512(const ItemType* first, size_t size, ItemType& low, ItemType& high) {
+    minmax_kernel<64>(first, size, low, high);
+}
+#endif
+
+template <typename ItemType>
+SearchKernels<ItemType> select_search_kernels() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        return SearchKernels<ItemType>{find_avx512<ItemType>, count_avx512<ItemType>, minmax_avx512<ItemType>};
+
+    if (__builtin_cpu_supports("avx2"))
+        return SearchKernels<ItemType>{find_avx2<ItemType>, count_avx2<ItemType>, minmax_avx2<ItemType>};
+
+    if (__builtin_cpu_supports("sse4.2"))
+        return SearchKernels<ItemType>{find_sse42<ItemType>, count_sse42<ItemType>, minmax_sse42<ItemType>};
+#endif
+
+    return SearchKernels<ItemType>{find_default<ItemType>, count_default<ItemType>, minmax_default<ItemType>};
+}
+
+template <typename ItemType>
+const SearchKernels<ItemType>& search_kernels() {
+    static const SearchKernels<ItemType> kernels = select_search_kernels<ItemType>();
+
+    return kernels;
+}
+
+/*
+ * Dispatch between the kernels (std::true_type) and the loops over the iterators.
+ */
+template <typename IteratorType, typename ItemType>
+IteratorType find_choose(IteratorType first, IteratorType last, const ItemType& value, std::true_type) {
+    return first + search_kernels<ItemType>().find(contiguous_pointer(first), last - first, value);
+}
+
+template <typename IteratorType, typename ItemType>
+IteratorType find_choose(IteratorType first, IteratorType last, const ItemType& value, std::false_type) {
+    for ( ; first != last; first++)
+        if (*first == value)
+            return first;
+
+    return last;
+}
+
+template <typename IteratorType, typename ItemType>
+size_t count_choose(IteratorType first, IteratorType last, const ItemType& value, std::true_type) {
+    return search_kernels<ItemType>().count(contiguous_pointer(first), last - first, value);
+}
+
+template <typename IteratorType, typename ItemType>
+size_t count_choose(IteratorType first, IteratorType last, const ItemType& value, std::false_type) {
+    size_t count = 0;
+
+    for ( ; first != last; first++)
+        if (*first == value)
+            count++;
+
+    return count;
+}
+
+/*
+ * Returns the first minimum and the first maximum of a non empty range, skipping NaN items.
+ * The kernels find the values, their first occurrences are then located with the find kernel.
+ */
+template <typename IteratorType>
+Pair<IteratorType, IteratorType> minmax_choose(IteratorType first, IteratorType last, std::true_type) {
+    typedef typename IteratorTraits<IteratorType>::value_type ItemType;
+
+    ItemType low, high;
+
+    search_kernels<ItemType>().minmax(contiguous_pointer(first), last - first, low, high);
+
+    IteratorType low_position = find_choose(first, last, low, std::true_type());
+    IteratorType high_position = find_choose(first, last, high, std::true_type());
+
+    // Only NaN items, none of them compares equal to the extremes.
+    if (low_position == last)
+        return Pair<IteratorType, IteratorType>(first, first);
+
+    return Pair<IteratorType, IteratorType>(low_position, high_position);
+}
+
+template <typename IteratorType>
+Pair<IteratorType, IteratorType> minmax_choose(IteratorType first, IteratorType last, std::false_type) {
+    IteratorType low = first;
+    IteratorType high = first;
+
+    for (first++; first != last; first++) {
+        if (*first < *low)
+            low = first;
+
+        if (*high < *first)
+            high = first;
+    }
+
+    return Pair<IteratorType, IteratorType>(low, high);
+}
+
+/**
+ * Returns the first item of [first, last) equal to value, or last.
+ */
+template <typename IteratorType>
+IteratorType simd_find(IteratorType first, IteratorType last, const typename IteratorTraits<IteratorType>::value_type& value) {
+    return find_choose(first, last, value, use_search_kernels<IteratorType>());
+}
+
+/**
+ * Returns the number of items of [first, last) equal to value.
+ */
+template <typename IteratorType>
+size_t simd_count(IteratorType first, IteratorType last, const typename IteratorTraits<IteratorType>::value_type& value) {
+    return count_choose(first, last, value, use_search_kernels<IteratorType>());
+}
+
+template <typename IteratorType>
+bool simd_contains(IteratorType first, IteratorType last, const typename IteratorTraits<IteratorType>::value_type& value) {
+    return simd_find(first, last, value) != last;
+}
+
+/**
+ * Returns the first smallest and the first largest item of [first, last), or (last, last) if it is empty.
+ */
+template <typename IteratorType>
+Pair<IteratorType, IteratorType> simd_minmax(IteratorType first, IteratorType last) {
+    if (first == last)
+        return Pair<IteratorType, IteratorType>(last, last);
+
+    return minmax_choose(first, last, use_search_kernels<IteratorType>());
+}
+
+template <typename IteratorType>
+IteratorType simd_min_element(IteratorType first, IteratorType last) {
+    return simd_minmax(first, last).first;
+}
+
+template <typename IteratorType>
+IteratorType simd_max_element(IteratorType first, IteratorType last) {
+    return simd_minmax(first, last).second;
+}
@@ -0,0 +1,860 @@
+#pragma once
+
+#include "iterator.h"
+#include "mem_tools.h"
+#include "misc.h"
+#include "growth_policy.h"
+
+// Used for true_type and false_type.
+#include <type_traits>
+
+// Used for std::allocator.
+#include <memory>
+
+// Used for initialize_list constructor and assign.
+#include <initializer_list>
+
+// Used for std::move() and std::forward().
+#include <utility>
+
+// Used for std::out_of_range and std::length_error.
+#include <stdexcept>
+
+/*
+ * A Vector which keeps up to N elements in a buffer inside the object and only
+ * allocates through Allocator once it grows past that.
+ *
+ * Exposes the same interface as Vector, so the two can be swapped at call sites.
+ * Iterators and references are invalidated by moving or swapping a SmallVector
+ * whose elements are stored inline.
+ */
+template <typename ItemType, size_t N, typename Allocator = std::allocator<ItemType>, typename GrowthPolicy = DoublingGrowth>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+    private:
+        typedef SmallVector<ItemType, N, Allocator, GrowthPolicy>    small_vector_type;
+
+        struct SmallVectorMemory : public Allocator {
+            ItemType* start;
+            ItemType* finish;
+            ItemType* storage_end;
+
+            SmallVectorMemory(const Allocator& allocator) : Allocator(allocator) {
+                start = nullptr;
+                finish = nullptr;
+                storage_end = nullptr;
+            }
+        };
+
+        SmallVectorMemory memory;
+
+        alignas(ItemType) unsigned char buffer[N * sizeof(ItemType)];
+
+    public:
+        typedef ItemType                                value_type;
+        typedef typename Allocator::pointer             pointer;
+        typedef typename Allocator::const_pointer       const_pointer;
+        typedef typename Allocator::reference           reference;
+        typedef typename Allocator::const_reference     const_reference;
+
+        typedef size_t                                  size_type;
+        typedef ptrdiff_t                               difference_type;
+
+        typedef Allocator                               allocator_type;
+        typedef GrowthPolicy                            growth_policy;
+
+        typedef NormalIterator<pointer, small_vector_type>          iterator;
+        typedef NormalIterator<const_pointer, small_vector_type>    const_iterator;
+
+        SmallVector(const allocator_type& allocator = allocator_type());
+        SmallVector(size_type size, const value_type& value, const allocator_type& allocator = allocator_type());
+        SmallVector(size_type size);
+
+        SmallVector(const SmallVector& other);
+        SmallVector(SmallVector&& other) noexcept;
+
+        template <typename InputIterator>
+        SmallVector(InputIterator first, InputIterator last, const allocator_type& allocator = allocator_type());
+
+        SmallVector(std::initializer_list<ItemType> list, const allocator_type& allocator = allocator_type());
+
+        ~SmallVector();
+
+        SmallVector& operator=(const SmallVector& other);
+        SmallVector& operator=(SmallVector&& other) noexcept;
+
+    protected:
+        ItemType* inline_storage();
+        bool is_inline() const;
+
+        size_type next_capacity() const;
+        size_type grow_capacity(size_type required) const;
+
+        void reallocate(size_type capacity);
+        void resize_reserve(size_type size);
+
+        void steal(SmallVector& other);
+
+        template <typename... Args>
+        void realloc_emplace_back(Args&&... args);
+
+        template <typename IntegralType>
+        void assign_choose(IntegralType first, IntegralType last, std::true_type);
+
+        template <typename IteratorType>
+        void assign_choose(IteratorType first, IteratorType last, std::false_type);
+
+        template <typename IntegralType>
+        iterator insert_choose(iterator position, IntegralType first, IntegralType last, std::true_type);
+
+        template <typename IteratorType>
+        iterator insert_choose(iterator position, IteratorType first, IteratorType last, std::false_type);
+
+        template <typename InputIterator>
+        iterator insert_range_fill(iterator position, InputIterator first, InputIterator last, input_iterator_tag);
+
+        template <typename ForwardIterator>
+        iterator insert_range_fill(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+        int compare(const SmallVector& other) const;
+
+    public:
+        void assign(size_type count, const value_type& value);
+
+        template <typename IteratorType>
+        void assign(IteratorType first, IteratorType last);
+
+        void assign(std::initializer_list<ItemType> list);
+
+        reference operator[](size_type offset);
+        const_reference operator[](size_type offset) const;
+
+        reference at(size_type offset);
+        const_reference at(size_type offset) const;
+
+        reference front();
+        const_reference front() const;
+
+        reference back();
+        const_reference back() const;
+
+        allocator_type get_allocator() const;
+
+        size_type size() const;
+        size_type max_size() const;
+        size_type capacity() const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+        bool empty() const;
+
+        iterator erase(iterator position);
+        iterator erase(iterator first, iterator last);
+
+        iterator insert(iterator position, const value_type& value);
+        iterator insert(iterator position, value_type&& value);
+        iterator insert(iterator position, size_type count, const value_type& value);
+
+        template <typename IteratorType>
+        iterator insert(iterator position, IteratorType first, IteratorType last);
+
+        template <typename... Args>
+        iterator emplace(iterator position, Args&&... args);
+
+        void clear();
+
+        void push_back(const value_type& value);
+        void push_back(value_type&& value);
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
+
+        void reserve(size_type capacity);
+        void reserve_exact(size_type capacity);
+
+        void shrink_to_fit();
+
+        void pop_back();
+
+        void resize(size_type size);
+        void resize(size_type size, const value_type& value);
+        void resize(size_type size, default_init_t);
+
+        /*
+         * Grows or shrinks to size items, leaving the new ones uninitialized.
+         */
+        void resize_uninitialized(size_type size);
+
+        void swap(SmallVector& other);
+
+        bool operator==(const SmallVector& other) const;
+        bool operator!=(const SmallVector& other) const;
+
+        bool operator<(const SmallVector& other) const;
+        bool operator>(const SmallVector& other) const;
+        bool operator<=(const SmallVector& other) const;
+        bool operator>=(const SmallVector& other) const;
+};
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::SmallVector(const allocator_type& allocator) : memory(allocator) {
+    this->memory.start = this->inline_storage();
+    this->memory.finish = this->memory.start;
+    this->memory.storage_end = this->memory.start + N;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::SmallVector(size_type size, const value_type& value, const allocator_type& allocator) : SmallVector(allocator) {
+    this->insert(this->end(), size, value);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::SmallVector(size_type size) : SmallVector(allocator_type()) {
+    this->insert(this->end(), size, value_type());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::SmallVector(const SmallVector& other) : SmallVector(other.get_allocator()) {
+    this->reserve_exact(other.size());
+
+    this->memory.finish = uninitialized_copy(other.memory.start, other.memory.finish, this->memory.start, this->get_allocator());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::SmallVector(SmallVector&& other) noexcept : SmallVector(other.get_allocator()) {
+    this->steal(other);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename InputIterator>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::SmallVector(InputIterator first, InputIterator last, const allocator_type& allocator) : SmallVector(allocator) {
+    this->insert(this->end(), first, last);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::SmallVector(std::initializer_list<ItemType> list, const allocator_type& allocator) : SmallVector(allocator) {
+    this->insert(this->end(), list.begin(), list.end());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>::~SmallVector() {
+    destroy(this->memory.start, this->memory.finish, this->get_allocator());
+
+    if (this->is_inline() == false)
+        this->memory.deallocate(this->memory.start, this->capacity());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>& SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator=(const SmallVector& other) {
+    if (this != &other) {
+        this->clear();
+        this->reserve_exact(other.size());
+
+        this->memory.finish = uninitialized_copy(other.memory.start, other.memory.finish, this->memory.start, this->get_allocator());
+    }
+
+    return *this;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+SmallVector<ItemType, N, Allocator, GrowthPolicy>& SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator=(SmallVector&& other) noexcept {
+    if (this != &other) {
+        this->clear();
+
+        if (this->is_inline() == false) {
+            this->memory.deallocate(this->memory.start, this->capacity());
+
+            this->memory.start = this->inline_storage();
+            this->memory.finish = this->memory.start;
+            this->memory.storage_end = this->memory.start + N;
+        }
+
+        // The allocator follows the block steal() may take over.
+        static_cast<Allocator&>(this->memory) = other.get_allocator();
+
+        this->steal(other);
+    }
+
+    return *this;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+ItemType* SmallVector<ItemType, N, Allocator, GrowthPolicy>::inline_storage() {
+    return reinterpret_cast<ItemType*>(this->buffer);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::is_inline() const {
+    return this->memory.start == reinterpret_cast<const ItemType*>(this->buffer);
+}
+
+/*
+ * Takes over the elements of other, which is left empty with its inline storage.
+ * This has to be empty and inline.
+ */
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::steal(SmallVector& other) {
+    if (other.is_inline() == false) {
+        this->memory.start = other.memory.start;
+        this->memory.finish = other.memory.finish;
+        this->memory.storage_end = other.memory.storage_end;
+
+        other.memory.start = other.inline_storage();
+        other.memory.storage_end = other.memory.start + N;
+    } else
+        this->memory.finish = relocate(other.memory.start, other.memory.finish, this->memory.start, this->get_allocator());
+
+    other.memory.finish = other.memory.start;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::size_type SmallVector<ItemType, N, Allocator, GrowthPolicy>::next_capacity() const {
+    return GrowthPolicy::grow(this->capacity(), sizeof(ItemType));
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::size_type SmallVector<ItemType, N, Allocator, GrowthPolicy>::grow_capacity(size_type required) const {
+    size_type capacity = this->next_capacity();
+
+    return (capacity < required) ? GrowthPolicy::round(required, sizeof(ItemType)) : capacity;
+}
+
+/*
+ * Moves the elements to a block of the given capacity, which is the inline buffer
+ * whenever the elements fit in it.
+ */
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::reallocate(size_type capacity) {
+    ItemType* temp;
+
+    if (capacity <= N) {
+        if (this->is_inline() == true)
+            return;
+
+        temp = this->inline_storage();
+        capacity = N;
+    } else {
+        temp = this->memory.allocate(capacity);
+
+        if (temp == nullptr)
+            throw std::bad_alloc();
+    }
+
+    size_type size = this->size();
+
+    try {
+        relocate(this->memory.start, this->memory.finish, temp, this->get_allocator());
+    } catch (...) {
+        if (temp != this->inline_storage())
+            this->memory.deallocate(temp, capacity);
+
+        throw;
+    }
+
+    if (this->is_inline() == false)
+        this->memory.deallocate(this->memory.start, this->capacity());
+
+    this->memory.start = temp;
+    this->memory.finish = temp + size;
+    this->memory.storage_end = temp + capacity;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::realloc_emplace_back(Args&&... args) {
+    size_type capacity = this->next_capacity();
+    size_type size = this->size();
+
+    if (capacity > this->max_size())
+        throw std::length_error("SmallVector::emplace_back(Args&&...) exceeds SmallVector::max_size()");
+
+    auto temp = this->memory.allocate(capacity);
+
+    // The new element is built before relocating, since args may refer to an element of this SmallVector.
+    try {
+        this->memory.construct(temp + size, std::forward<Args>(args)...);
+    } catch (...) {
+        this->memory.deallocate(temp, capacity);
+
+        throw;
+    }
+
+    try {
+        relocate(this->memory.start, this->memory.finish, temp, this->get_allocator());
+    } catch (...) {
+        this->memory.destroy(temp + size);
+        this->memory.deallocate(temp, capacity);
+
+        throw;
+    }
+
+    if (this->is_inline() == false)
+        this->memory.deallocate(this->memory.start, this->capacity());
+
+    this->memory.start = temp;
+    this->memory.finish = temp + size + 1;
+    this->memory.storage_end = temp + capacity;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::resize_reserve(size_type size) {
+    if (size > this->capacity()) {
+        if (size > this->max_size())
+            throw std::length_error("Parameter of SmallVector::resize(size_type) exceeds SmallVector::max_size()");
+
+        this->reallocate(this->grow_capacity(size));
+    }
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::assign(size_type count, const value_type& value) {
+    // value may refer to an element of this SmallVector, which is destroyed below.
+    value_type copy(value);
+
+    this->clear();
+    this->insert(this->end(), count, copy);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename IntegralType>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::assign_choose(IntegralType first, IntegralType last, std::true_type) {
+    this->assign(static_cast<size_type>(first), static_cast<value_type>(last));
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename IteratorType>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::assign_choose(IteratorType first, IteratorType last, std::false_type) {
+    this->clear();
+    this->insert(this->end(), first, last);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename IteratorType>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::assign(IteratorType first, IteratorType last) {
+    this->assign_choose(first, last, std::is_integral<IteratorType>());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::assign(std::initializer_list<ItemType> list) {
+    this->clear();
+    this->insert(this->end(), list.begin(), list.end());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator[](size_type offset) {
+    return this->memory.start[offset];
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::const_reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator[](size_type offset) const {
+    return this->memory.start[offset];
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::at(size_type offset) {
+    if (offset >= this->size())
+        throw std::out_of_range("std::out_of_range in SmallVector::at(size_type offset)");
+
+    return this->memory.start[offset];
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::const_reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::at(size_type offset) const {
+    if (offset >= this->size())
+        throw std::out_of_range("std::out_of_range in SmallVector::at(size_type offset) const");
+
+    return this->memory.start[offset];
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::front() {
+    return *this->memory.start;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::const_reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::front() const {
+    return *this->memory.start;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::back() {
+    return *(this->memory.finish - 1);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::const_reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::back() const {
+    return *(this->memory.finish - 1);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::allocator_type SmallVector<ItemType, N, Allocator, GrowthPolicy>::get_allocator() const {
+    return *static_cast<const Allocator*>(&this->memory);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::size_type SmallVector<ItemType, N, Allocator, GrowthPolicy>::size() const {
+    return size_type(this->memory.finish - this->memory.start);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::size_type SmallVector<ItemType, N, Allocator, GrowthPolicy>::max_size() const {
+    return size_type(-1) / sizeof(value_type);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::size_type SmallVector<ItemType, N, Allocator, GrowthPolicy>::capacity() const {
+    return size_type(this->memory.storage_end - this->memory.start);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::begin() {
+    return iterator(this->memory.start);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::const_iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::begin() const {
+    return const_iterator(this->memory.start);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::end() {
+    return iterator(this->memory.finish);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::const_iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::end() const {
+    return const_iterator(this->memory.finish);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::empty() const {
+    return this->memory.start == this->memory.finish;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::erase(iterator position) {
+    this->memory.finish = close_gap(position.base(), this->memory.finish, 1, this->get_allocator());
+
+    return position;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::erase(iterator first, iterator last) {
+    if (first != last)
+        this->memory.finish = close_gap(first.base(), this->memory.finish, last - first, this->get_allocator());
+
+    return first;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert(iterator position, const value_type& value) {
+    // value may refer to an element of this SmallVector, which is moved around below.
+    value_type copy(value);
+
+    return this->insert(position, std::move(copy));
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert(iterator position, value_type&& value) {
+    difference_type relative_position = position - this->begin();
+
+    if (this->memory.finish == this->memory.storage_end)
+        this->reallocate(this->next_capacity());
+
+    ItemType* gap = this->memory.start + relative_position;
+    ItemType* finish = open_gap(gap, this->memory.finish, 1, this->get_allocator());
+
+    try {
+        this->memory.construct(gap, std::move(value));
+    } catch (...) {
+        close_raw_gap(gap, finish, 1, this->get_allocator());
+
+        throw;
+    }
+
+    this->memory.finish = finish;
+
+    return iterator(gap);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert(iterator position, size_type count, const value_type& value) {
+    difference_type relative_position = position - this->begin();
+
+    if (count == 0)
+        return position;
+
+    // value may refer to an element of this SmallVector, which is moved around below.
+    value_type copy(value);
+
+    if (this->size() + count > this->capacity())
+        this->reallocate(this->grow_capacity(this->size() + count));
+
+    ItemType* gap = this->memory.start + relative_position;
+    ItemType* finish = open_gap(gap, this->memory.finish, count, this->get_allocator());
+
+    try {
+        uninitialized_fill(gap, count, copy, this->get_allocator());
+    } catch (...) {
+        close_raw_gap(gap, finish, count, this->get_allocator());
+
+        throw;
+    }
+
+    this->memory.finish = finish;
+
+    return iterator(gap);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename IntegralType>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert_choose(iterator position, IntegralType first, IntegralType last, std::true_type) {
+    return this->insert(position, static_cast<size_type>(first), static_cast<value_type>(last));
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename IteratorType>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert_choose(iterator position, IteratorType first, IteratorType last, std::false_type) {
+    return this->insert_range_fill(position, first, last, typename IteratorCategory<IteratorType>::type());
+}
+
+/*
+ * Single pass ranges can not be measured without consuming them, so they are read into
+ * a buffer first, whose items are then moved into place.
+ */
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename InputIterator>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert_range_fill(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+    SmallVector buffer(this->get_allocator());
+
+    for ( ; first != last; first++)
+        buffer.push_back(*first);
+
+    return this->insert_range_fill(position, std::make_move_iterator(buffer.memory.start), std::make_move_iterator(buffer.memory.finish), forward_iterator_tag());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename ForwardIterator>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert_range_fill(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+    difference_type relative_position = position - this->begin();
+    size_type count = iterator_distance(first, last);
+
+    if (count == 0)
+        return position;
+
+    if (this->size() + count > this->capacity())
+        this->reallocate(this->grow_capacity(this->size() + count));
+
+    ItemType* gap = this->memory.start + relative_position;
+    ItemType* finish = open_gap(gap, this->memory.finish, count, this->get_allocator());
+
+    // finish only moves once the gap is filled, a throwing copy closes the gap again.
+    try {
+        uninitialized_copy(first, last, gap, this->get_allocator());
+    } catch (...) {
+        close_raw_gap(gap, finish, count, this->get_allocator());
+
+        throw;
+    }
+
+    this->memory.finish = finish;
+
+    return iterator(gap);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename IteratorType>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::insert(iterator position, IteratorType first, IteratorType last) {
+    return this->insert_choose(position, first, last, std::is_integral<IteratorType>());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::iterator SmallVector<ItemType, N, Allocator, GrowthPolicy>::emplace(iterator position, Args&&... args) {
+    if (position == this->end()) {
+        difference_type relative_position = position - this->begin();
+
+        this->emplace_back(std::forward<Args>(args)...);
+
+        return this->begin() + relative_position;
+    }
+
+    return this->insert(position, value_type(std::forward<Args>(args)...));
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::clear() {
+    destroy(this->memory.start, this->memory.finish, this->get_allocator());
+
+    this->memory.finish = this->memory.start;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::push_back(const value_type& value) {
+    this->emplace_back(value);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::push_back(value_type&& value) {
+    this->emplace_back(std::move(value));
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+typename SmallVector<ItemType, N, Allocator, GrowthPolicy>::reference SmallVector<ItemType, N, Allocator, GrowthPolicy>::emplace_back(Args&&... args) {
+    if (this->memory.finish == this->memory.storage_end)
+        this->realloc_emplace_back(std::forward<Args>(args)...);
+    else
+        this->memory.construct(this->memory.finish++, std::forward<Args>(args)...);
+
+    return this->back();
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::reserve(size_type capacity) {
+    if (capacity > this->capacity()) {
+        if (capacity > this->max_size())
+            throw std::length_error("Parameter of SmallVector::reserve(size_type) exceeds SmallVector::max_size()");
+
+        this->reallocate(GrowthPolicy::round(capacity, sizeof(ItemType)));
+    }
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::reserve_exact(size_type capacity) {
+    if (capacity > this->capacity()) {
+        if (capacity > this->max_size())
+            throw std::length_error("Parameter of SmallVector::reserve_exact(size_type) exceeds SmallVector::max_size()");
+
+        this->reallocate(capacity);
+    }
+}
+
+/*
+ * Moves the elements back to the inline buffer if they fit in it.
+ */
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::shrink_to_fit() {
+    if (this->capacity() > this->size() && this->is_inline() == false)
+        this->reallocate(this->size());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::pop_back() {
+    this->memory.destroy(--this->memory.finish);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::resize(size_type size) {
+    this->resize(size, value_type());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::resize(size_type size, const value_type& value) {
+    if (size <= this->size()) {
+        destroy(this->memory.start + size, this->memory.finish, this->get_allocator());
+
+        this->memory.finish = this->memory.start + size;
+
+        return;
+    }
+
+    // value may refer to an element of this SmallVector, which the reallocation would move.
+    value_type copy(value);
+
+    this->resize_reserve(size);
+
+    uninitialized_fill(this->memory.finish, size - this->size(), copy, this->get_allocator());
+
+    this->memory.finish = this->memory.start + size;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::resize(size_type size, default_init_t) {
+    if (size <= this->size()) {
+        destroy(this->memory.start + size, this->memory.finish, this->get_allocator());
+
+        this->memory.finish = this->memory.start + size;
+
+        return;
+    }
+
+    this->resize_reserve(size);
+
+    uninitialized_default_fill(this->memory.finish, size - this->size());
+
+    this->memory.finish = this->memory.start + size;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::resize_uninitialized(size_type size) {
+    static_assert(std::is_trivially_default_constructible<ItemType>::value && std::is_trivially_destructible<ItemType>::value,
+        "SmallVector::resize_uninitialized() needs trivially constructible items");
+
+    this->resize(size, default_init);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallVector<ItemType, N, Allocator, GrowthPolicy>::swap(SmallVector& other) {
+    if (this->is_inline() == false && other.is_inline() == false) {
+        std::swap(static_cast<Allocator&>(this->memory), static_cast<Allocator&>(other.memory));
+        std::swap(this->memory.start, other.memory.start);
+        std::swap(this->memory.finish, other.memory.finish);
+        std::swap(this->memory.storage_end, other.memory.storage_end);
+
+        return;
+    }
+
+    SmallVector temp(std::move(other));
+
+    other = std::move(*this);
+    *this = std::move(temp);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator==(const SmallVector& other) const {
+    if (this->size() != other.size())
+        return false;
+
+    const ItemType* start = this->memory.start;
+
+    return VectorCompare<ItemType>().equal(start, start + this->size(), static_cast<const ItemType*>(other.memory.start));
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator!=(const SmallVector& other) const {
+    return !(*this == other);
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+int SmallVector<ItemType, N, Allocator, GrowthPolicy>::compare(const SmallVector& other) const {
+    const ItemType* start = this->memory.start;
+    const ItemType* other_start = other.memory.start;
+
+    return VectorCompare<ItemType>().execute(start, start + this->size(), other_start, other_start + other.size());
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator<(const SmallVector& other) const {
+    return this->compare(other) < 0;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator>(const SmallVector& other) const {
+    return this->compare(other) > 0;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator<=(const SmallVector& other) const {
+    return this->compare(other) <= 0;
+}
+
+template <typename ItemType, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallVector<ItemType, N, Allocator, GrowthPolicy>::operator>=(const SmallVector& other) const {
+    return this->compare(other) >= 0;
+}
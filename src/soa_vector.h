@@ -0,0 +1,585 @@
+/**
+ * @file soa_vector.h
+ *
+ * A vector of records stored as one contiguous array per field (structure of arrays).
+ */
+
+#pragma once
+
+// Contains
+//      IndexIterator
+#include "iterator.h"
+
+// Contains
+//      VectorBase
+#include "vector.h"
+
+// Used for std::tuple, std::get() and std::forward_as_tuple().
+#include <tuple>
+
+// Used for std::index_sequence.
+#include <utility>
+
+// Used for std::allocator.
+#include <memory>
+
+// Used for std::is_nothrow_move_constructible.
+#include <type_traits>
+
+// Used for std::out_of_range and std::length_error.
+#include <stdexcept>
+
+/**
+ * @tparam ItemType the type of item viewed, const for read only spans
+ */
+template <typename ItemType>
+/**
+ * @class ColumnSpan
+ *
+ * @brief View over a contiguous array of items, one column of a SoAVector
+ *
+ * Its iterators are plain pointers, so loops over a span vectorize and the kernels of
+ * simd_search.h apply to it.
+ */
+class ColumnSpan {
+    private:
+        ItemType* first;
+        size_t count;
+
+    public:
+        typedef ItemType*   iterator;
+
+        ColumnSpan(ItemType* first, size_t count) : first(first), count(count) {}
+
+        ItemType* data() const {
+            return this->first;
+        }
+
+        size_t size() const {
+            return this->count;
+        }
+
+        bool empty() const {
+            return this->count == 0;
+        }
+
+        ItemType* begin() const {
+            return this->first;
+        }
+
+        ItemType* end() const {
+            return this->first + this->count;
+        }
+
+        ItemType& operator[](size_t offset) const {
+            return this->first[offset];
+        }
+};
+
+/**
+ * @tparam Types the types of the fields of a record
+ */
+template <typename... Types>
+/**
+ * @class SoAVector
+ *
+ * @brief Vector of records whose fields are each stored in their own array
+ *
+ * Every field gets a column, an array allocated through a VectorBase, and all columns share
+ * one size and capacity. A scan over one field reads only that field's array, instead of
+ * pulling whole records through the cache as a Vector of structs does, and the loop over
+ * a ColumnSpan is one the compiler vectorizes.
+ *
+ * Rows are read and written through proxies: operator[] and the iterators return a
+ * std::tuple of references to the fields of the row.
+ */
+class SoAVector {
+    static_assert(sizeof...(Types) > 0, "SoAVector needs at least one field");
+
+    private:
+        typedef SoAVector<Types...>     vector_type;
+
+        template <typename ItemType>
+        using Column = VectorBase<ItemType, std::allocator<ItemType>, DoublingGrowth>;
+
+        typedef std::index_sequence_for<Types...>   Indices;
+
+        std::tuple<Column<Types>...> columns;
+
+        size_t count;
+        size_t storage;
+
+        /** @brief Whether moving items of the field to a new array may throw, they are then copied */
+        template <typename ItemType>
+        using relocation_may_throw = std::integral_constant<bool,
+            !(is_trivially_relocatable<ItemType>::value || std::is_nothrow_move_constructible<ItemType>::value)>;
+
+        template <size_t... Index>
+        void reallocate(size_t capacity, std::index_sequence<Index...>);
+
+        template <typename ItemType>
+        void copy_column(Column<ItemType>& column, ItemType* block);
+
+        template <typename ItemType>
+        void relocate_column(Column<ItemType>& column, ItemType* block, size_t capacity, bool copied);
+
+        /** @brief Constructs the fields of @b row from the items of the tuple @b fields */
+        template <size_t Index, typename Tuple>
+        void construct_fields(size_t row, Tuple&& fields);
+
+        template <size_t... Index>
+        void destroy_row(size_t row, std::index_sequence<Index...>);
+
+        template <size_t... Index>
+        std::tuple<Types&...> row(size_t row, std::index_sequence<Index...>);
+
+        template <size_t... Index>
+        std::tuple<const Types&...> row(size_t row, std::index_sequence<Index...>) const;
+
+        template <size_t... Index>
+        void swap_columns(SoAVector& other, std::index_sequence<Index...>);
+
+        void grow();
+
+    public:
+        typedef std::tuple<Types...>            value_type;
+        typedef std::tuple<Types&...>           reference;
+        typedef std::tuple<const Types&...>     const_reference;
+
+        typedef size_t                          size_type;
+        typedef ptrdiff_t                       difference_type;
+
+        typedef IndexIterator<vector_type, value_type, reference>                       iterator;
+        typedef IndexIterator<const vector_type, const value_type, const_reference>     const_iterator;
+
+        template <size_t Index>
+        using field_type = typename std::tuple_element<Index, value_type>::type;
+
+        SoAVector();
+
+        SoAVector(const SoAVector& other);
+        SoAVector(SoAVector&& other) noexcept;
+
+        ~SoAVector();
+
+        SoAVector& operator=(const SoAVector& other);
+        SoAVector& operator=(SoAVector&& other) noexcept;
+
+        /** @brief The row at @b offset, as a tuple of references to its fields */
+        reference operator[](size_type offset);
+        const_reference operator[](size_type offset) const;
+
+        /**
+         * @throw std::out_of_range if @b offset is not below size()
+         */
+        reference at(size_type offset);
+        const_reference at(size_type offset) const;
+
+        reference front();
+        const_reference front() const;
+
+        reference back();
+        const_reference back() const;
+
+        /** @brief The array of field @b Index of every row */
+        template <size_t Index>
+        ColumnSpan<field_type<Index>> column();
+
+        template <size_t Index>
+        ColumnSpan<const field_type<Index>> column() const;
+
+        size_type size() const;
+        size_type max_size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+        /**
+         * @throw std::length_error if @b capacity exceeds max_size()
+         */
+        void reserve(size_type capacity);
+
+        void push_back(const value_type& row);
+        void push_back(value_type&& row);
+
+        /**
+         * @brief Appends a row whose fields are constructed from @b fields, one argument per field
+         */
+        template <typename... Args>
+        void emplace_back(Args&&... fields);
+
+        void pop_back();
+
+        /** @brief Grows or shrinks to @b size rows, new fields are value initialized */
+        void resize(size_type size);
+
+        void clear();
+
+        void swap(SoAVector& other) noexcept;
+};
+
+template <typename... Types>
+SoAVector<Types...>::SoAVector() : columns(std::allocator<Types>()...) {
+    this->count = 0;
+    this->storage = 0;
+}
+
+template <typename... Types>
+SoAVector<Types...>::SoAVector(const SoAVector& other) : SoAVector() {
+    try {
+        this->reserve(other.count);
+
+        for ( ; this->count < other.count; this->count++)
+            this->construct_fields<0>(this->count, other[this->count]);
+    } catch (...) {
+        this->clear();
+
+        throw;
+    }
+}
+
+template <typename... Types>
+SoAVector<Types...>::SoAVector(SoAVector&& other) noexcept : SoAVector() {
+    this->swap(other);
+}
+
+template <typename... Types>
+SoAVector<Types...>::~SoAVector() {
+    // The columns release their arrays themselves.
+    this->clear();
+}
+
+template <typename... Types>
+SoAVector<Types...>& SoAVector<Types...>::operator=(const SoAVector& other) {
+    if (this != &other) {
+        SoAVector copy(other);
+
+        this->swap(copy);
+    }
+
+    return *this;
+}
+
+template <typename... Types>
+SoAVector<Types...>& SoAVector<Types...>::operator=(SoAVector&& other) noexcept {
+    if (this != &other) {
+        SoAVector temp(std::move(other));
+
+        this->swap(temp);
+    }
+
+    return *this;
+}
+
+/*
+ * Every new array is allocated before any row moves, so a failed allocation leaves the
+ * vector as it was. The columns whose items may throw while moving are then copied, while
+ * every old array is still intact, so a throwing copy leaves the vector as it was too. Only
+ * then are the other columns relocated, which can not throw, and the old arrays freed.
+ */
+template <typename... Types>
+template <size_t... Index>
+void SoAVector<Types...>::reallocate(size_t capacity, std::index_sequence<Index...>) {
+    std::tuple<Types*...> blocks(static_cast<Types*>(nullptr)...);
+
+    try {
+        ((std::get<Index>(blocks) = std::get<Index>(this->columns).memory_allocate(capacity)), ...);
+    } catch (...) {
+        (std::get<Index>(this->columns).memory_deallocate(std::get<Index>(blocks), capacity), ...);
+
+        throw;
+    }
+
+    bool copied[sizeof...(Types)] = {};
+
+    try {
+        ((relocation_may_throw<Types>::value ?
+            (this->copy_column(std::get<Index>(this->columns), std::get<Index>(blocks)), copied[Index] = true) : false), ...);
+    } catch (...) {
+        ((copied[Index] ? destroy(std::get<Index>(blocks), std::get<Index>(blocks) + this->count, std::get<Index>(this->columns).get_allocator()) : void()), ...);
+
+        (std::get<Index>(this->columns).memory_deallocate(std::get<Index>(blocks), capacity), ...);
+
+        throw;
+    }
+
+    (this->relocate_column(std::get<Index>(this->columns), std::get<Index>(blocks), capacity, copied[Index]), ...);
+
+    this->storage = capacity;
+}
+
+template <typename... Types>
+template <typename ItemType>
+void SoAVector<Types...>::copy_column(Column<ItemType>& column, ItemType* block) {
+    uninitialized_move(column.memory.start, column.memory.start + this->count, block, column.get_allocator());
+}
+
+/*
+ * Moves the items of column to block, unless they were copied there already, and frees the old array.
+ */
+template <typename... Types>
+template <typename ItemType>
+void SoAVector<Types...>::relocate_column(Column<ItemType>& column, ItemType* block, size_t capacity, bool copied) {
+    if (copied)
+        destroy(column.memory.start, column.memory.start + this->count, column.get_allocator());
+    else
+        relocate(column.memory.start, column.memory.start + this->count, block, column.get_allocator());
+
+    column.memory_deallocate(column.memory.start, this->storage);
+
+    column.memory.start = block;
+    column.memory.finish = block + this->count;
+    column.memory.storage_end = block + capacity;
+}
+
+template <typename... Types>
+template <size_t Index, typename Tuple>
+void SoAVector<Types...>::construct_fields(size_t row, Tuple&& fields) {
+    if constexpr (Index < sizeof...(Types)) {
+        auto& column = std::get<Index>(this->columns);
+
+        column.memory.construct(column.memory.start + row, std::get<Index>(std::forward<Tuple>(fields)));
+
+        // A later field failing to construct undoes this one.
+        try {
+            this->construct_fields<Index + 1>(row, std::forward<Tuple>(fields));
+        } catch (...) {
+            column.memory.destroy(column.memory.start + row);
+
+            throw;
+        }
+    }
+}
+
+template <typename... Types>
+template <size_t... Index>
+void SoAVector<Types...>::destroy_row(size_t row, std::index_sequence<Index...>) {
+    (std::get<Index>(this->columns).memory.destroy(std::get<Index>(this->columns).memory.start + row), ...);
+}
+
+template <typename... Types>
+template <size_t... Index>
+std::tuple<Types&...> SoAVector<Types...>::row(size_t row, std::index_sequence<Index...>) {
+    return std::tuple<Types&...>(std::get<Index>(this->columns).memory.start[row]...);
+}
+
+template <typename... Types>
+template <size_t... Index>
+std::tuple<const Types&...> SoAVector<Types...>::row(size_t row, std::index_sequence<Index...>) const {
+    return std::tuple<const Types&...>(std::get<Index>(this->columns).memory.start[row]...);
+}
+
+/*
+ * The columns are swapped pointer by pointer, a VectorBase can not be copied or moved.
+ */
+template <typename... Types>
+template <size_t... Index>
+void SoAVector<Types...>::swap_columns(SoAVector& other, std::index_sequence<Index...>) {
+    (std::swap(std::get<Index>(this->columns).memory.start, std::get<Index>(other.columns).memory.start), ...);
+    (std::swap(std::get<Index>(this->columns).memory.finish, std::get<Index>(other.columns).memory.finish), ...);
+    (std::swap(std::get<Index>(this->columns).memory.storage_end, std::get<Index>(other.columns).memory.storage_end), ...);
+}
+
+template <typename... Types>
+void SoAVector<Types...>::grow() {
+    if (this->storage == this->max_size())
+        throw std::length_error("SoAVector::emplace_back(Args&&...) exceeds SoAVector::max_size()");
+
+    size_t capacity = DoublingGrowth::grow(this->storage, 1);
+
+    this->reallocate((capacity < this->max_size()) ? capacity : this->max_size(), Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::reference SoAVector<Types...>::operator[](size_type offset) {
+    return this->row(offset, Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::const_reference SoAVector<Types...>::operator[](size_type offset) const {
+    return this->row(offset, Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::reference SoAVector<Types...>::at(size_type offset) {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in SoAVector::at(size_type offset)");
+
+    return this->row(offset, Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::const_reference SoAVector<Types...>::at(size_type offset) const {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in SoAVector::at(size_type offset) const");
+
+    return this->row(offset, Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::reference SoAVector<Types...>::front() {
+    return this->row(0, Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::const_reference SoAVector<Types...>::front() const {
+    return this->row(0, Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::reference SoAVector<Types...>::back() {
+    return this->row(this->count - 1, Indices());
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::const_reference SoAVector<Types...>::back() const {
+    return this->row(this->count - 1, Indices());
+}
+
+template <typename... Types>
+template <size_t Index>
+ColumnSpan<typename SoAVector<Types...>::template field_type<Index>> SoAVector<Types...>::column() {
+    return ColumnSpan<field_type<Index>>(std::get<Index>(this->columns).memory.start, this->count);
+}
+
+template <typename... Types>
+template <size_t Index>
+ColumnSpan<const typename SoAVector<Types...>::template field_type<Index>> SoAVector<Types...>::column() const {
+    return ColumnSpan<const field_type<Index>>(std::get<Index>(this->columns).memory.start, this->count);
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::size_type SoAVector<Types...>::size() const {
+    return this->count;
+}
+
+/*
+ * Bounded by the widest field, whose array is the largest.
+ */
+template <typename... Types>
+typename SoAVector<Types...>::size_type SoAVector<Types...>::max_size() const {
+    size_t widest = 1;
+
+    ((widest = (sizeof(Types) > widest) ? sizeof(Types) : widest), ...);
+
+    return size_type(-1) / 4 / widest;
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::size_type SoAVector<Types...>::capacity() const {
+    return this->storage;
+}
+
+template <typename... Types>
+bool SoAVector<Types...>::empty() const {
+    return this->count == 0;
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::iterator SoAVector<Types...>::begin() {
+    return iterator(this, 0);
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::const_iterator SoAVector<Types...>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::iterator SoAVector<Types...>::end() {
+    return iterator(this, this->count);
+}
+
+template <typename... Types>
+typename SoAVector<Types...>::const_iterator SoAVector<Types...>::end() const {
+    return const_iterator(this, this->count);
+}
+
+template <typename... Types>
+void SoAVector<Types...>::reserve(size_type capacity) {
+    if (capacity > this->max_size())
+        throw std::length_error("Parameter of SoAVector::reserve(size_type) exceeds SoAVector::max_size()");
+
+    if (capacity > this->storage)
+        this->reallocate(capacity, Indices());
+}
+
+template <typename... Types>
+void SoAVector<Types...>::push_back(const value_type& row) {
+    if (this->count == this->storage)
+        this->grow();
+
+    this->construct_fields<0>(this->count, row);
+
+    this->count++;
+}
+
+template <typename... Types>
+void SoAVector<Types...>::push_back(value_type&& row) {
+    if (this->count == this->storage)
+        this->grow();
+
+    this->construct_fields<0>(this->count, std::move(row));
+
+    this->count++;
+}
+
+/*
+ * The arguments may be fields of this vector, which growth would move, so they are
+ * copied out first when a growth is due.
+ */
+template <typename... Types>
+template <typename... Args>
+void SoAVector<Types...>::emplace_back(Args&&... fields) {
+    static_assert(sizeof...(Args) == sizeof...(Types), "SoAVector::emplace_back() takes one argument per field");
+
+    if (this->count == this->storage) {
+        value_type row(std::forward<Args>(fields)...);
+
+        this->grow();
+        this->construct_fields<0>(this->count, std::move(row));
+    } else {
+        this->construct_fields<0>(this->count, std::forward_as_tuple(std::forward<Args>(fields)...));
+    }
+
+    this->count++;
+}
+
+template <typename... Types>
+void SoAVector<Types...>::pop_back() {
+    this->count--;
+
+    this->destroy_row(this->count, Indices());
+}
+
+template <typename... Types>
+void SoAVector<Types...>::resize(size_type size) {
+    if (size > this->storage)
+        this->reserve(size);
+
+    while (this->count > size)
+        this->pop_back();
+
+    for ( ; this->count < size; this->count++)
+        this->construct_fields<0>(this->count, value_type());
+}
+
+template <typename... Types>
+void SoAVector<Types...>::clear() {
+    while (this->count > 0)
+        this->pop_back();
+}
+
+template <typename... Types>
+void SoAVector<Types...>::swap(SoAVector& other) noexcept {
+    this->swap_columns(other, Indices());
+
+    std::swap(this->count, other.count);
+    std::swap(this->storage, other.storage);
+}
@@ -0,0 +1,402 @@
+/**
+ * @file sort.h
+ *
+ * Sequential and parallel sorting of random access ranges (Vector iterators or plain pointers).
+ */
+
+#pragma once
+
+// Used for std::move() and std::swap().
+#include <utility>
+
+#include "iterator.h"
+#include "vector.h"
+#include "parallel.h"
+
+/**
+ * @brief Below this many items parallel_sort() and parallel_stable_sort() sort on the calling thread
+ */
+constexpr size_t PARALLEL_SORT_THRESHOLD = size_t(1) << 15;
+
+/**
+ * @brief Ranges this short are finished with insertion sort
+ */
+constexpr ptrdiff_t INSERTION_SORT_THRESHOLD = 16;
+
+/**
+ * @brief Default comparator, orders items with operator<
+ */
+template <typename ItemType>
+struct Less {
+    bool operator()(const ItemType& first, const ItemType& second) const {
+        return first < second;
+    }
+};
+
+/**
+ * @brief Stable sort of a short range, moving every item right after its predecessors
+ */
+template <typename RandomAccessIterator, typename Compare>
+void insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare) {
+    if (first == last)
+        return;
+
+    for (RandomAccessIterator it = first + 1; it != last; it++) {
+        typename IteratorTraits<RandomAccessIterator>::value_type value = std::move(*it);
+
+        RandomAccessIterator hole = it;
+
+        for ( ; hole != first && compare(value, *(hole - 1)); hole--)
+            *hole = std::move(*(hole - 1));
+
+        *hole = std::move(value);
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void sift_down(RandomAccessIterator first, ptrdiff_t hole, ptrdiff_t size, Compare compare) {
+    typename IteratorTraits<RandomAccessIterator>::value_type value = std::move(first[hole]);
+
+    for (ptrdiff_t child = 2 * hole + 1; child < size; child = 2 * hole + 1) {
+        if (child + 1 < size && compare(first[child], first[child + 1]))
+            child++;
+
+        if (!compare(value, first[child]))
+            break;
+
+        first[hole] = std::move(first[child]);
+        hole = child;
+    }
+
+    first[hole] = std::move(value);
+}
+
+/**
+ * @brief In place O(n log n) worst case sort, used by introsort() when quicksort degenerates
+ */
+template <typename RandomAccessIterator, typename Compare>
+void heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare) {
+    ptrdiff_t size = last - first;
+
+    for (ptrdiff_t parent = size / 2 - 1; parent >= 0; parent--)
+        sift_down(first, parent, size, compare);
+
+    for (ptrdiff_t end = size - 1; end > 0; end--) {
+        using std::swap;
+
+        swap(first[0], first[end]);
+
+        sift_down(first, 0, end, compare);
+    }
+}
+
+/*
+ * Moves the median of *first, *second and *third to *result.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void move_median_to(RandomAccessIterator result, RandomAccessIterator first, RandomAccessIterator second, RandomAccessIterator third, Compare compare) {
+    using std::swap;
+
+    if (compare(*first, *second)) {
+        if (compare(*second, *third))
+            swap(*result, *second);
+        else if (compare(*first, *third))
+            swap(*result, *third);
+        else
+            swap(*result, *first);
+    } else if (compare(*first, *third))
+        swap(*result, *first);
+    else if (compare(*second, *third))
+        swap(*result, *third);
+    else
+        swap(*result, *second);
+}
+
+/*
+ * Hoare partition of [first, last) around *pivot, which lies outside the range. The median
+ * of three guarantees that neither scan runs off the range.
+ */
+template <typename RandomAccessIterator, typename Compare>
+RandomAccessIterator unguarded_partition(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator pivot, Compare compare) {
+    while (true) {
+        while (compare(*first, *pivot))
+            first++;
+
+        last--;
+
+        while (compare(*pivot, *last))
+            last--;
+
+        if (!(first < last))
+            return first;
+
+        using std::swap;
+
+        swap(*first, *last);
+
+        first++;
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void introsort_loop(RandomAccessIterator first, RandomAccessIterator last, size_t depth, Compare compare) {
+    while (last - first > INSERTION_SORT_THRESHOLD) {
+        if (depth == 0) {
+            heap_sort(first, last, compare);
+
+            return;
+        }
+
+        depth--;
+
+        move_median_to(first, first + 1, first + (last - first) / 2, last - 1, compare);
+
+        RandomAccessIterator cut = unguarded_partition(first + 1, last, first, compare);
+
+        introsort_loop(cut, last, depth, compare);
+
+        last = cut;
+    }
+}
+
+/**
+ * @brief Sorts [first, last) with quicksort, falling back to heap sort past 2 log2(n) levels
+ *
+ * Not stable. O(n log n) comparisons in the worst case.
+ */
+template <typename RandomAccessIterator, typename Compare = Less<typename IteratorTraits<RandomAccessIterator>::value_type>>
+void introsort(RandomAccessIterator first, RandomAccessIterator last, Compare compare = Compare()) {
+    size_t depth = 0;
+
+    for (ptrdiff_t size = last - first; size > 1; size >>= 1)
+        depth += 2;
+
+    introsort_loop(first, last, depth, compare);
+    insertion_sort(first, last, compare);
+}
+
+/*
+ * Stable merge of the sorted ranges [first_1, last_1) and [first_2, last_2) into to_first,
+ * moving the items. Ties are taken from the first range.
+ */
+template <typename InputIterator, typename OutputIterator, typename Compare>
+OutputIterator move_merge(InputIterator first_1, InputIterator last_1, InputIterator first_2, InputIterator last_2, OutputIterator to_first, Compare compare) {
+    for ( ; first_1 != last_1 && first_2 != last_2; to_first++) {
+        if (compare(*first_2, *first_1))
+            *to_first = std::move(*first_2++);
+        else
+            *to_first = std::move(*first_1++);
+    }
+
+    for ( ; first_1 != last_1; first_1++, to_first++)
+        *to_first = std::move(*first_1);
+
+    for ( ; first_2 != last_2; first_2++, to_first++)
+        *to_first = std::move(*first_2);
+
+    return to_first;
+}
+
+/*
+ * Merges the sorted runs of length run in [first, first + size) pairwise into to_first.
+ */
+template <typename InputIterator, typename OutputIterator, typename Compare>
+void merge_runs(InputIterator first, OutputIterator to_first, ptrdiff_t size, ptrdiff_t run, Compare compare) {
+    for (ptrdiff_t start = 0; start < size; start += 2 * run) {
+        ptrdiff_t middle = (start + run < size) ? start + run : size;
+        ptrdiff_t end = (start + 2 * run < size) ? start + 2 * run : size;
+
+        move_merge(first + start, first + middle, first + middle, first + end, to_first + start, compare);
+    }
+}
+
+/**
+ * @brief Stable merge sort of [first, last), using the range at @b buffer (of at least the same size) as scratch
+ *
+ * Runs of INSERTION_SORT_THRESHOLD items are insertion sorted, then merged bottom-up back and
+ * forth between the range and the buffer.
+ */
+template <typename RandomAccessIterator, typename BufferIterator, typename Compare>
+void merge_sort(RandomAccessIterator first, RandomAccessIterator last, BufferIterator buffer, Compare compare) {
+    ptrdiff_t size = last - first;
+
+    for (ptrdiff_t start = 0; start < size; start += INSERTION_SORT_THRESHOLD)
+        insertion_sort(first + start, (start + INSERTION_SORT_THRESHOLD < size) ? first + start + INSERTION_SORT_THRESHOLD : last, compare);
+
+    for (ptrdiff_t run = INSERTION_SORT_THRESHOLD; run < size; run *= 4) {
+        merge_runs(first, buffer, size, run, compare);
+
+        if (2 * run >= size) {
+            for (ptrdiff_t index = 0; index < size; index++)
+                first[index] = std::move(buffer[index]);
+
+            return;
+        }
+
+        merge_runs(buffer, first, size, 2 * run, compare);
+    }
+}
+
+/**
+ * @brief Stable sort of [first, last)
+ *
+ * Allocates a buffer of last - first default constructed items.
+ */
+template <typename RandomAccessIterator, typename Compare = Less<typename IteratorTraits<RandomAccessIterator>::value_type>>
+void merge_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare = Compare()) {
+    Vector<typename IteratorTraits<RandomAccessIterator>::value_type> buffer;
+
+    buffer.resize(last - first, default_init);
+
+    merge_sort(first, last, buffer.begin(), compare);
+}
+
+/*
+ * Number of items of [first_1, first_1 + size_1) among the first count items of the stable
+ * merge of it with [first_2, first_2 + size_2), found by binary search on the merge path.
+ */
+template <typename InputIterator, typename Compare>
+ptrdiff_t merge_split(InputIterator first_1, ptrdiff_t size_1, InputIterator first_2, ptrdiff_t size_2, ptrdiff_t count, Compare compare) {
+    ptrdiff_t low = (count > size_2) ? count - size_2 : 0;
+    ptrdiff_t high = (count < size_1) ? count : size_1;
+
+    while (low < high) {
+        ptrdiff_t middle = low + (high - low) / 2;
+
+        // Taking middle items of the first range is too few if its next item precedes the last one taken from the second.
+        if (!compare(first_2[count - middle - 1], first_1[middle]))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/*
+ * One parallel round of merge_runs(): the output is split in chunks, each chunk locates its
+ * inputs with merge_split() and merges them on its own, so every round uses the whole pool.
+ *
+ * The splits are all found in a first pass: merge_split() reads items of the runs which
+ * neighbouring chunks move out of once merging starts.
+ */
+template <typename InputIterator, typename OutputIterator, typename Compare>
+void parallel_merge_runs(InputIterator first, OutputIterator to_first, ptrdiff_t size, ptrdiff_t run, Compare compare, ThreadPool& pool) {
+    ptrdiff_t grain = size / (8 * (pool.size() + 1));
+
+    if (grain == 0)
+        grain = 1;
+
+    // Items of the first run of its pair among the merged items before each chunk.
+    Vector<ptrdiff_t> splits;
+
+    splits.resize(size / grain + ((size % grain) ? 1 : 0), default_init);
+
+    pool.parallel_for(size, grain, [&](size_t begin, size_t, size_t chunk) {
+        ptrdiff_t index = begin;
+
+        ptrdiff_t start = index - index % (2 * run);
+        ptrdiff_t middle = (start + run < size) ? start + run : size;
+        ptrdiff_t stop = (start + 2 * run < size) ? start + 2 * run : size;
+
+        splits[chunk] = merge_split(first + start, middle - start, first + middle, stop - middle, index - start, compare);
+    });
+
+    pool.parallel_for(size, grain, [&](size_t begin, size_t end, size_t chunk) {
+        ptrdiff_t chunk_first = begin;
+        ptrdiff_t chunk_last = end;
+
+        for (ptrdiff_t start = chunk_first - chunk_first % (2 * run); start < chunk_last; start += 2 * run) {
+            ptrdiff_t middle = (start + run < size) ? start + run : size;
+            ptrdiff_t stop = (start + 2 * run < size) ? start + 2 * run : size;
+
+            ptrdiff_t from = (start > chunk_first) ? start : chunk_first;
+            ptrdiff_t to = (stop < chunk_last) ? stop : chunk_last;
+
+            // A chunk boundary inside the pair is the start of this chunk or of the next one.
+            ptrdiff_t from_1 = (from == start) ? 0 : splits[chunk];
+            ptrdiff_t to_1 = (to == stop) ? middle - start : splits[chunk + 1];
+
+            move_merge(first + start + from_1, first + start + to_1,
+                first + middle + (from - start - from_1), first + middle + (to - start - to_1), to_first + from, compare);
+        }
+    });
+}
+
+/*
+ * Parallel merge sort: blocks sorted one per chunk, then merged in rounds of parallel_merge_runs().
+ */
+template <typename RandomAccessIterator, typename Compare>
+void parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare, bool stable, ThreadPool& pool) {
+    typedef typename IteratorTraits<RandomAccessIterator>::value_type value_type;
+
+    ptrdiff_t size = last - first;
+
+    Vector<value_type> buffer;
+
+    buffer.resize(size, default_init);
+
+    auto scratch = buffer.begin();
+
+    // A few blocks per thread, so that uneven blocks still balance.
+    ptrdiff_t blocks = 4 * (pool.size() + 1);
+    ptrdiff_t block = size / blocks + ((size % blocks) ? 1 : 0);
+
+    pool.parallel_for(size, block, [&](size_t begin, size_t end, size_t) {
+        if (stable)
+            merge_sort(first + begin, first + end, scratch + begin, compare);
+        else
+            introsort(first + begin, first + end, compare);
+    });
+
+    bool in_buffer = false;
+
+    for (ptrdiff_t run = block; run < size; run *= 2) {
+        if (in_buffer)
+            parallel_merge_runs(scratch, first, size, run, compare, pool);
+        else
+            parallel_merge_runs(first, scratch, size, run, compare, pool);
+
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+        pool.parallel_for(size, 0, [&](size_t begin, size_t end, size_t) {
+            for (size_t index = begin; index < end; index++)
+                first[index] = std::move(scratch[index]);
+        });
+}
+
+/**
+ * @brief Sorts [first, last) on @b pool, not stable
+ *
+ * Ranges under PARALLEL_SORT_THRESHOLD items are sorted with introsort() on the calling thread.
+ * Larger ones are split in blocks sorted in parallel, which are then merged in parallel through
+ * a buffer of last - first default constructed items.
+ */
+template <typename RandomAccessIterator, typename Compare = Less<typename IteratorTraits<RandomAccessIterator>::value_type>>
+void parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare = Compare(), ThreadPool& pool = ThreadPool::instance()) {
+    if (static_cast<size_t>(last - first) < PARALLEL_SORT_THRESHOLD || pool.size() == 0) {
+        introsort(first, last, compare);
+
+        return;
+    }
+
+    parallel_merge_sort(first, last, compare, false, pool);
+}
+
+/**
+ * @brief Sorts [first, last) on @b pool, keeping equivalent items in their original order
+ *
+ * Ranges under PARALLEL_SORT_THRESHOLD items are sorted with merge_sort() on the calling thread.
+ */
+template <typename RandomAccessIterator, typename Compare = Less<typename IteratorTraits<RandomAccessIterator>::value_type>>
+void parallel_stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare = Compare(), ThreadPool& pool = ThreadPool::instance()) {
+    if (static_cast<size_t>(last - first) < PARALLEL_SORT_THRESHOLD || pool.size() == 0) {
+        merge_sort(first, last, compare);
+
+        return;
+    }
+
+    parallel_merge_sort(first, last, compare, true, pool);
+}
@@ -0,0 +1,466 @@
+/**
+ * @file stable_vector.h
+ *
+ * A vector stored in fixed-size chunks, whose items never move.
+ */
+
+#pragma once
+
+// Contains
+//      IndexIterator
+#include "iterator.h"
+
+#include "vector.h"
+
+// Used for std::allocator.
+#include <memory>
+
+// Used for std::move() and std::forward().
+#include <utility>
+
+// Used for std::out_of_range and std::length_error.
+#include <stdexcept>
+
+/**
+ * @brief Size in bytes a StableVector chunk aims for
+ */
+constexpr size_t STABLE_VECTOR_CHUNK_BYTES = 4096;
+
+/**
+ * @tparam ItemType the type of item stored
+ * @tparam ChunkItems the number of items per chunk, a power of two
+ * @tparam Allocator the allocator of the chunks
+ */
+template <typename ItemType, size_t ChunkItems = block_items(sizeof(ItemType), STABLE_VECTOR_CHUNK_BYTES), typename Allocator = std::allocator<ItemType>>
+/**
+ * @class StableVector
+ *
+ * @brief Vector whose items live in chunks of ChunkItems, found through a table of chunk pointers
+ *
+ * Growing allocates one more chunk and never touches the items already stored, so
+ * push_back() costs the same at any size and references to items stay valid until they
+ * are erased. Only the table of chunk pointers is reallocated, one pointer per chunk,
+ * which for items of 8 bytes is 512 times less to copy than a Vector reallocation.
+ *
+ * Indexing costs a shift, a mask and one more load than a Vector.
+ */
+class StableVector {
+    static_assert(ChunkItems > 0 && (ChunkItems & (ChunkItems - 1)) == 0, "StableVector needs a power of two chunk size");
+
+    private:
+        typedef StableVector<ItemType, ChunkItems, Allocator>                   vector_type;
+        typedef typename Allocator::template rebind<ItemType*>::other           TableAllocator;
+
+        Allocator allocator;
+
+        /** @brief Every allocated chunk, the ones past the last item are spare */
+        Vector<ItemType*, TableAllocator> chunks;
+
+        size_t count;
+
+        static size_t chunk_of(size_t index);
+        static size_t offset_of(size_t index);
+
+        ItemType* slot(size_t index) const;
+
+        /** @brief Allocates chunks until @b capacity items fit */
+        void add_chunks(size_t capacity);
+
+        void release();
+
+    public:
+        typedef ItemType                value_type;
+        typedef ItemType*               pointer;
+        typedef const ItemType*         const_pointer;
+        typedef ItemType&               reference;
+        typedef const ItemType&         const_reference;
+
+        typedef size_t                  size_type;
+        typedef ptrdiff_t               difference_type;
+
+        typedef Allocator               allocator_type;
+
+        typedef IndexIterator<vector_type, ItemType>                iterator;
+        typedef IndexIterator<const vector_type, const ItemType>    const_iterator;
+
+        explicit StableVector(const allocator_type& allocator = allocator_type());
+        StableVector(size_type size, const value_type& value, const allocator_type& allocator = allocator_type());
+
+        StableVector(const StableVector& other);
+        StableVector(StableVector&& other) noexcept;
+
+        ~StableVector();
+
+        StableVector& operator=(const StableVector& other);
+        StableVector& operator=(StableVector&& other) noexcept;
+
+        allocator_type get_allocator() const;
+
+        reference operator[](size_type offset);
+        const_reference operator[](size_type offset) const;
+
+        /**
+         * @throw std::out_of_range if @b offset is not below size()
+         */
+        reference at(size_type offset);
+        const_reference at(size_type offset) const;
+
+        reference front();
+        const_reference front() const;
+
+        reference back();
+        const_reference back() const;
+
+        size_type size() const;
+        size_type max_size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+        void push_back(const value_type& value);
+        void push_back(value_type&& value);
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
+
+        void pop_back();
+
+        /**
+         * @brief Allocates the chunks needed to hold @b capacity items
+         *
+         * @throw std::length_error if @b capacity exceeds max_size()
+         */
+        void reserve(size_type capacity);
+
+        /** @brief Frees the spare chunks */
+        void shrink_to_fit();
+
+        void resize(size_type size);
+        void resize(size_type size, const value_type& value);
+
+        /** @brief Destroys every item, keeping the chunks */
+        void clear();
+
+        void swap(StableVector& other) noexcept;
+
+        bool operator==(const StableVector& other) const;
+        bool operator!=(const StableVector& other) const;
+};
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+StableVector<ItemType, ChunkItems, Allocator>::StableVector(const allocator_type& allocator) : allocator(allocator), chunks(TableAllocator(allocator)) {
+    this->count = 0;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+StableVector<ItemType, ChunkItems, Allocator>::StableVector(size_type size, const value_type& value, const allocator_type& allocator) :
+    allocator(allocator), chunks(TableAllocator(allocator)) {
+    this->count = 0;
+
+    try {
+        this->resize(size, value);
+    } catch (...) {
+        this->release();
+
+        throw;
+    }
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+StableVector<ItemType, ChunkItems, Allocator>::StableVector(const StableVector& other) : allocator(other.allocator), chunks(TableAllocator(other.allocator)) {
+    this->count = 0;
+
+    try {
+        this->reserve(other.size());
+
+        for (size_t index = 0; index < other.size(); index++)
+            this->push_back(other[index]);
+    } catch (...) {
+        this->release();
+
+        throw;
+    }
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+StableVector<ItemType, ChunkItems, Allocator>::StableVector(StableVector&& other) noexcept : allocator(other.allocator), chunks(std::move(other.chunks)) {
+    this->count = other.count;
+
+    other.count = 0;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+StableVector<ItemType, ChunkItems, Allocator>::~StableVector() {
+    this->release();
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+StableVector<ItemType, ChunkItems, Allocator>& StableVector<ItemType, ChunkItems, Allocator>::operator=(const StableVector& other) {
+    if (this != &other) {
+        StableVector copy(other);
+
+        this->swap(copy);
+    }
+
+    return *this;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+StableVector<ItemType, ChunkItems, Allocator>& StableVector<ItemType, ChunkItems, Allocator>::operator=(StableVector&& other) noexcept {
+    if (this != &other) {
+        StableVector temp(std::move(other));
+
+        this->swap(temp);
+    }
+
+    return *this;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+size_t StableVector<ItemType, ChunkItems, Allocator>::chunk_of(size_t index) {
+    return index / ChunkItems;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+size_t StableVector<ItemType, ChunkItems, Allocator>::offset_of(size_t index) {
+    return index & (ChunkItems - 1);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+ItemType* StableVector<ItemType, ChunkItems, Allocator>::slot(size_t index) const {
+    return this->chunks[chunk_of(index)] + offset_of(index);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::add_chunks(size_t capacity) {
+    while (this->capacity() < capacity) {
+        ItemType* chunk = this->allocator.allocate(ChunkItems);
+
+        try {
+            this->chunks.push_back(chunk);
+        } catch (...) {
+            this->allocator.deallocate(chunk, ChunkItems);
+
+            throw;
+        }
+    }
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::release() {
+    this->clear();
+
+    for (size_t chunk = 0; chunk < this->chunks.size(); chunk++)
+        this->allocator.deallocate(this->chunks[chunk], ChunkItems);
+
+    this->chunks.clear();
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::allocator_type StableVector<ItemType, ChunkItems, Allocator>::get_allocator() const {
+    return this->allocator;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::reference StableVector<ItemType, ChunkItems, Allocator>::operator[](size_type offset) {
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::const_reference StableVector<ItemType, ChunkItems, Allocator>::operator[](size_type offset) const {
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::reference StableVector<ItemType, ChunkItems, Allocator>::at(size_type offset) {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in StableVector::at(size_type offset)");
+
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::const_reference StableVector<ItemType, ChunkItems, Allocator>::at(size_type offset) const {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in StableVector::at(size_type offset) const");
+
+    return *this->slot(offset);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::reference StableVector<ItemType, ChunkItems, Allocator>::front() {
+    return *this->slot(0);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::const_reference StableVector<ItemType, ChunkItems, Allocator>::front() const {
+    return *this->slot(0);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::reference StableVector<ItemType, ChunkItems, Allocator>::back() {
+    return *this->slot(this->count - 1);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::const_reference StableVector<ItemType, ChunkItems, Allocator>::back() const {
+    return *this->slot(this->count - 1);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::size_type StableVector<ItemType, ChunkItems, Allocator>::size() const {
+    return this->count;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::size_type StableVector<ItemType, ChunkItems, Allocator>::max_size() const {
+    return size_type(-1) / 4 / sizeof(ItemType);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::size_type StableVector<ItemType, ChunkItems, Allocator>::capacity() const {
+    return this->chunks.size() * ChunkItems;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+bool StableVector<ItemType, ChunkItems, Allocator>::empty() const {
+    return this->count == 0;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::iterator StableVector<ItemType, ChunkItems, Allocator>::begin() {
+    return iterator(this, 0);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::const_iterator StableVector<ItemType, ChunkItems, Allocator>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::iterator StableVector<ItemType, ChunkItems, Allocator>::end() {
+    return iterator(this, this->count);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+typename StableVector<ItemType, ChunkItems, Allocator>::const_iterator StableVector<ItemType, ChunkItems, Allocator>::end() const {
+    return const_iterator(this, this->count);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::push_back(const value_type& value) {
+    this->emplace_back(value);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::push_back(value_type&& value) {
+    this->emplace_back(std::move(value));
+}
+
+/*
+ * Items never move, so args may refer to one of them even when a chunk is added.
+ */
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+template <typename... Args>
+typename StableVector<ItemType, ChunkItems, Allocator>::reference StableVector<ItemType, ChunkItems, Allocator>::emplace_back(Args&&... args) {
+    if (this->count == this->capacity()) {
+        if (this->count == this->max_size())
+            throw std::length_error("StableVector::emplace_back(Args&&...) exceeds StableVector::max_size()");
+
+        this->add_chunks(this->count + 1);
+    }
+
+    ItemType* position = this->slot(this->count);
+
+    this->allocator.construct(position, std::forward<Args>(args)...);
+
+    this->count++;
+
+    return *position;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::pop_back() {
+    this->count--;
+
+    this->allocator.destroy(this->slot(this->count));
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::reserve(size_type capacity) {
+    if (capacity > this->max_size())
+        throw std::length_error("Parameter of StableVector::reserve(size_type) exceeds StableVector::max_size()");
+
+    if (capacity <= this->capacity())
+        return;
+
+    this->chunks.reserve(chunk_of(capacity + ChunkItems - 1));
+    this->add_chunks(capacity);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::shrink_to_fit() {
+    size_t used = chunk_of(this->count + ChunkItems - 1);
+
+    while (this->chunks.size() > used) {
+        this->allocator.deallocate(this->chunks.back(), ChunkItems);
+
+        this->chunks.pop_back();
+    }
+
+    this->chunks.shrink_to_fit();
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::resize(size_type size) {
+    this->resize(size, value_type());
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::resize(size_type size, const value_type& value) {
+    if (size > this->count)
+        this->reserve(size);
+
+    while (this->count > size)
+        this->pop_back();
+
+    while (this->count < size)
+        this->emplace_back(value);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::clear() {
+    while (this->count > 0)
+        this->pop_back();
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+void StableVector<ItemType, ChunkItems, Allocator>::swap(StableVector& other) noexcept {
+    std::swap(this->allocator, other.allocator);
+    std::swap(this->count, other.count);
+
+    this->chunks.swap(other.chunks);
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+bool StableVector<ItemType, ChunkItems, Allocator>::operator==(const StableVector& other) const {
+    if (this->count != other.count)
+        return false;
+
+    for (size_t index = 0; index < this->count; index++)
+        if (!((*this)[index] == other[index]))
+            return false;
+
+    return true;
+}
+
+template <typename ItemType, size_t ChunkItems, typename Allocator>
+bool StableVector<ItemType, ChunkItems, Allocator>::operator!=(const StableVector& other) const {
+    return !(*this == other);
+}
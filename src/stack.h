@@ -8,6 +8,22 @@
 
 #include "vector.h"
 
+// Used for std::move() and std::forward().
+#include <utility>
+
+// Used for std::is_nothrow_move_constructible, std::is_nothrow_move_assignable and std::declval().
+#include <type_traits>
+
+/**
+ * @brief Whether @b ContainerType has reserve(size_t) and capacity(), as Vector has and Deque has not
+ */
+template <typename ContainerType, typename = void>
+struct container_can_reserve : public std::false_type {};
+
+template <typename ContainerType>
+struct container_can_reserve<ContainerType,
+    decltype(void(std::declval<ContainerType&>().reserve(size_t())), void(std::declval<const ContainerType&>().capacity()))> : public std::true_type {};
+
 /**
  * @tparam ItemType the type of item the stack will contain
  */
@@ -22,30 +38,64 @@ class Stack {
         /** @brief The underlying container of the Stack */
         ContainerType container;
 
+        constexpr void reserve(size_t capacity, std::true_type);
+        constexpr void reserve(size_t, std::false_type);
+
+        /** @brief Makes room for @b count more items if the range is bigger than the free capacity */
+        constexpr void reserve_more(size_t count, std::true_type);
+        constexpr void reserve_more(size_t, std::false_type);
+
+        template <typename InputIterator>
+        constexpr void push_range(InputIterator first, InputIterator last, input_iterator_tag);
+
+        template <typename ForwardIterator>
+        constexpr void push_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
     public:
         /** @brief Default constructor */
-        Stack();
+        constexpr Stack();
+
+        /**
+         * @brief Builds a Stack on top of a copy of @b container
+         *
+         * Lets the underlying container be given a stateful allocator, e.g. an ArenaAllocator
+         */
+        constexpr explicit Stack(const ContainerType& container);
 
         /** 
          * @brief Copy constructor
          *
          * The underlying container is copy-constructed with the content of @b other.container
          */
-        Stack(const Stack& other);
+        constexpr Stack(const Stack& other);
+
+        /**
+         * @brief Move constructor
+         *
+         * Takes over the underlying container of @b other, leaving it empty
+         */
+        constexpr Stack(Stack&& other) noexcept(std::is_nothrow_move_constructible<ContainerType>::value);
 
         /**
          * @brief Default destructor
          *
          * Destructs the underlying container
          */
-        ~Stack();
+        ~Stack() = default;
 
         /**
          * @brief Assignment operator
          *
          * @details Replaces the content of the underlying container with those of @b other
          */
-        Stack& operator=(const Stack<ItemType, ContainerType>& other);
+        constexpr Stack& operator=(const Stack<ItemType, ContainerType>& other);
+
+        /**
+         * @brief Move assignment operator
+         *
+         * @details Replaces the underlying container with that of @b other, without copying items
+         */
+        constexpr Stack& operator=(Stack<ItemType, ContainerType>&& other) noexcept(std::is_nothrow_move_assignable<ContainerType>::value);
 
         /**
          * @brief Checks if the underlying container has no elements
@@ -57,62 +107,188 @@ class Stack {
          *
          *      false if the Stack is not empty
          */ 
-        bool empty() const;
-        size_t size() const;
+        constexpr bool empty() const;
+        constexpr size_t size() const;
+
+        /**
+         * @brief Reserves room for @b capacity items in the underlying container
+         *
+         * Does nothing for containers without reserve(), such as Deque
+         */
+        constexpr void reserve(size_t capacity);
+
+        constexpr void push(const ItemType& value);
+        constexpr void push(ItemType&& value);
+
+        /**
+         * @brief Constructs a new top item in place from @b args
+         */
+        template <typename... Args>
+        constexpr void emplace(Args&&... args);
+
+        /**
+         * @brief Pushes every item of [first, last) in order, the last one ends on top
+         *
+         * Pushes the items one by one. A container with reserve() makes room for a forward
+         * range first, so a Vector grows at most once.
+         */
+        template <typename InputIterator>
+        constexpr void push_range(InputIterator first, InputIterator last);
 
-        void push(const ItemType& value);
-        void pop();
+        constexpr void pop();
 
-        ItemType& top();
-        const ItemType& top() const;
+        /**
+         * @brief Removes the top item and returns it, moved out of the container
+         */
+        constexpr ItemType pop_value();
+
+        /**
+         * @brief Moves the top @b count items to @b out, top first, and removes them
+         *
+         * @return the end of the output range
+         */
+        template <typename OutputIterator>
+        constexpr OutputIterator pop_n(size_t count, OutputIterator out);
+
+        constexpr ItemType& top();
+        constexpr const ItemType& top() const;
 };
 
 template <typename ItemType, typename ContainerType>
-Stack<ItemType, ContainerType>::Stack() {
-    this->container = ContainerType();
-}
+constexpr Stack<ItemType, ContainerType>::Stack() : container() {}
 
 template <typename ItemType, typename ContainerType>
-Stack<ItemType, ContainerType>::Stack(const Stack& other) {
-    this->container = ContainerType(other.container);
-}
+constexpr Stack<ItemType, ContainerType>::Stack(const ContainerType& container) : container(container) {}
+
+template <typename ItemType, typename ContainerType>
+constexpr Stack<ItemType, ContainerType>::Stack(const Stack& other) : container(other.container) {}
+
+template <typename ItemType, typename ContainerType>
+constexpr Stack<ItemType, ContainerType>::Stack(Stack&& other) noexcept(std::is_nothrow_move_constructible<ContainerType>::value) : container(std::move(other.container)) {}
 
 template <typename ItemType, typename ContainerType>
-Stack<ItemType, ContainerType>::~Stack() {}
+constexpr Stack<ItemType, ContainerType>& Stack<ItemType, ContainerType>::operator=(const Stack<ItemType, ContainerType>& other) {
+    this->container = other.container;
+
+    return *this;
+}
 
 template <typename ItemType, typename ContainerType>
-Stack<ItemType, ContainerType>& Stack<ItemType, ContainerType>::operator=(const Stack<ItemType, ContainerType>& other) {
-    this->container = ContainerType(other.container);
+constexpr Stack<ItemType, ContainerType>& Stack<ItemType, ContainerType>::operator=(Stack<ItemType, ContainerType>&& other) noexcept(std::is_nothrow_move_assignable<ContainerType>::value) {
+    this->container = std::move(other.container);
 
     return *this;
 }
 
 template <typename ItemType, typename ContainerType>
-bool Stack<ItemType, ContainerType>::empty() const {
+constexpr bool Stack<ItemType, ContainerType>::empty() const {
     return this->container.empty();
 }
 
 template <typename ItemType, typename ContainerType>
-size_t Stack<ItemType, ContainerType>::size() const {
+constexpr size_t Stack<ItemType, ContainerType>::size() const {
     return this->container.size();
 }
 
 template <typename ItemType, typename ContainerType>
-void Stack<ItemType, ContainerType>::push(const ItemType& value) {
+constexpr void Stack<ItemType, ContainerType>::reserve(size_t capacity) {
+    this->reserve(capacity, container_can_reserve<ContainerType>());
+}
+
+template <typename ItemType, typename ContainerType>
+constexpr void Stack<ItemType, ContainerType>::reserve(size_t capacity, std::true_type) {
+    this->container.reserve(capacity);
+}
+
+template <typename ItemType, typename ContainerType>
+constexpr void Stack<ItemType, ContainerType>::reserve(size_t, std::false_type) {}
+
+/*
+ * Grows to at least twice the capacity, as push() would, so that repeated small ranges
+ * do not reallocate on every call.
+ */
+template <typename ItemType, typename ContainerType>
+constexpr void Stack<ItemType, ContainerType>::reserve_more(size_t count, std::true_type) {
+    size_t required = this->container.size() + count;
+    size_t capacity = this->container.capacity();
+
+    if (required > capacity)
+        this->container.reserve((required > 2 * capacity) ? required : 2 * capacity);
+}
+
+template <typename ItemType, typename ContainerType>
+constexpr void Stack<ItemType, ContainerType>::reserve_more(size_t, std::false_type) {}
+
+template <typename ItemType, typename ContainerType>
+constexpr void Stack<ItemType, ContainerType>::push(const ItemType& value) {
     this->container.push_back(value);
 }
 
 template <typename ItemType, typename ContainerType>
-void Stack<ItemType, ContainerType>::pop() {
+constexpr void Stack<ItemType, ContainerType>::push(ItemType&& value) {
+    this->container.push_back(std::move(value));
+}
+
+template <typename ItemType, typename ContainerType>
+template <typename... Args>
+constexpr void Stack<ItemType, ContainerType>::emplace(Args&&... args) {
+    this->container.emplace_back(std::forward<Args>(args)...);
+}
+
+template <typename ItemType, typename ContainerType>
+template <typename InputIterator>
+constexpr void Stack<ItemType, ContainerType>::push_range(InputIterator first, InputIterator last) {
+    this->push_range(first, last, typename IteratorCategory<InputIterator>::type());
+}
+
+template <typename ItemType, typename ContainerType>
+template <typename InputIterator>
+constexpr void Stack<ItemType, ContainerType>::push_range(InputIterator first, InputIterator last, input_iterator_tag) {
+    for ( ; first != last; first++)
+        this->container.push_back(*first);
+}
+
+template <typename ItemType, typename ContainerType>
+template <typename ForwardIterator>
+constexpr void Stack<ItemType, ContainerType>::push_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+    this->reserve_more(iterator_distance(first, last), container_can_reserve<ContainerType>());
+
+    for ( ; first != last; first++)
+        this->container.push_back(*first);
+}
+
+template <typename ItemType, typename ContainerType>
+constexpr void Stack<ItemType, ContainerType>::pop() {
     this->container.pop_back();
 }
 
 template <typename ItemType, typename ContainerType>
-ItemType& Stack<ItemType, ContainerType>::top() {
+constexpr ItemType Stack<ItemType, ContainerType>::pop_value() {
+    ItemType value(std::move(this->container.back()));
+
+    this->container.pop_back();
+
+    return value;
+}
+
+template <typename ItemType, typename ContainerType>
+template <typename OutputIterator>
+constexpr OutputIterator Stack<ItemType, ContainerType>::pop_n(size_t count, OutputIterator out) {
+    for ( ; count--; out++) {
+        *out = std::move(this->container.back());
+
+        this->container.pop_back();
+    }
+
+    return out;
+}
+
+template <typename ItemType, typename ContainerType>
+constexpr ItemType& Stack<ItemType, ContainerType>::top() {
     return this->container.back();
 }
 
 template <typename ItemType, typename ContainerType>
-const ItemType& Stack<ItemType, ContainerType>::top() const {
+constexpr const ItemType& Stack<ItemType, ContainerType>::top() const {
     return this->container.back();
 }
@@ -0,0 +1,773 @@
+/**
+ * @file static_vector.h
+ *
+ * A vector with a fixed capacity whose items live inside the object, never on the heap.
+ */
+
+#pragma once
+
+// Contains
+//      NormalIterator
+#include "iterator.h"
+
+// Contains
+//      Stack, the base of StaticStack
+#include "stack.h"
+
+// Used for std::is_trivial and std::is_integral.
+#include <type_traits>
+
+// Used for std::initializer_list.
+#include <initializer_list>
+
+// Used for std::move() and std::forward().
+#include <utility>
+
+// Used for std::out_of_range and std::length_error.
+#include <stdexcept>
+
+// Used for placement new.
+#include <new>
+
+/**
+ * @tparam ItemType the type of item stored
+ * @tparam Capacity the number of items the storage holds
+ * @tparam Trivial whether ItemType is trivial, which picks the storage
+ */
+template <typename ItemType, size_t Capacity, bool Trivial = std::is_trivial<ItemType>::value>
+/**
+ * @class StaticStorage
+ *
+ * @brief The item storage and count of a StaticVector, for trivial items
+ *
+ * A constexpr constructor has to initialize every member before C++20, so the array of
+ * trivial items is zero filled once on construction; in return every operation of the
+ * StaticVector can run in a constant expression, and its destructor stays trivial.
+ */
+class StaticStorage {
+    protected:
+        ItemType items[Capacity];
+        size_t count;
+
+        constexpr StaticStorage() : items(), count(0) {}
+
+        constexpr ItemType* slots() {
+            return this->items;
+        }
+
+        constexpr const ItemType* slots() const {
+            return this->items;
+        }
+
+        template <typename... Args>
+        constexpr void construct_at(size_t index, Args&&... args) {
+            this->items[index] = ItemType(std::forward<Args>(args)...);
+        }
+
+        constexpr void destroy_at(size_t) {}
+
+        /** @brief Appends [first, last), or nothing if it does not fit */
+        template <typename InputIterator>
+        constexpr void append(InputIterator first, InputIterator last) {
+            size_t old_count = this->count;
+
+            for ( ; first != last; first++) {
+                if (this->count == Capacity) {
+                    this->count = old_count;
+
+                    throw std::length_error("std::length_error in StaticVector, capacity exceeded");
+                }
+
+                this->items[this->count++] = *first;
+            }
+        }
+
+        /** @brief Appends @b count copies of @b value, room for them is checked by the caller */
+        constexpr void fill_append(size_t count, const ItemType& value) {
+            for ( ; count > 0; count--)
+                this->items[this->count++] = value;
+        }
+};
+
+/**
+ * @brief The storage of a StaticVector of non trivial items: raw bytes, constructed on demand
+ */
+template <typename ItemType, size_t Capacity>
+class StaticStorage<ItemType, Capacity, false> {
+    protected:
+        alignas(ItemType) unsigned char bytes[Capacity * sizeof(ItemType)];
+        size_t count;
+
+        StaticStorage() : count(0) {}
+
+        StaticStorage(const StaticStorage&) = delete;
+        StaticStorage& operator=(const StaticStorage&) = delete;
+
+        ~StaticStorage() {
+            for (size_t index = 0; index < this->count; index++)
+                this->destroy_at(index);
+        }
+
+        ItemType* slots() {
+            return reinterpret_cast<ItemType*>(this->bytes);
+        }
+
+        const ItemType* slots() const {
+            return reinterpret_cast<const ItemType*>(this->bytes);
+        }
+
+        template <typename... Args>
+        void construct_at(size_t index, Args&&... args) {
+            ::new (static_cast<void*>(this->slots() + index)) ItemType(std::forward<Args>(args)...);
+        }
+
+        void destroy_at(size_t index) {
+            this->slots()[index].~ItemType();
+        }
+
+        /** @brief Appends [first, last), or nothing if it does not fit or an item fails to copy */
+        template <typename InputIterator>
+        void append(InputIterator first, InputIterator last) {
+            size_t old_count = this->count;
+
+            try {
+                for ( ; first != last; first++, this->count++) {
+                    if (this->count == Capacity)
+                        throw std::length_error("std::length_error in StaticVector, capacity exceeded");
+
+                    this->construct_at(this->count, *first);
+                }
+            } catch (...) {
+                while (this->count > old_count)
+                    this->destroy_at(--this->count);
+
+                throw;
+            }
+        }
+
+        /** @brief Appends @b count copies of @b value, or nothing if one fails to copy */
+        void fill_append(size_t count, const ItemType& value) {
+            size_t old_count = this->count;
+
+            try {
+                for ( ; this->count < old_count + count; this->count++)
+                    this->construct_at(this->count, value);
+            } catch (...) {
+                while (this->count > old_count)
+                    this->destroy_at(--this->count);
+
+                throw;
+            }
+        }
+};
+
+/**
+ * @tparam ItemType the type of item stored
+ * @tparam Capacity the most items the vector can hold
+ */
+template <typename ItemType, size_t Capacity>
+/**
+ * @class StaticVector
+ *
+ * @brief Vector whose storage for Capacity items is part of the object, so it never allocates
+ *
+ * Has the interface of Vector, with NormalIterator iterators. Items are only constructed
+ * when added. Growing past Capacity throws std::length_error, the vector being left as it was.
+ * For trivial item types every member function is constexpr and the vector itself is a
+ * literal type. Moving a StaticVector moves its items one by one, it can not steal a buffer.
+ */
+class StaticVector : protected StaticStorage<ItemType, Capacity> {
+    private:
+        static_assert(Capacity > 0, "StaticVector needs a capacity of at least one item");
+
+        typedef StaticVector<ItemType, Capacity>    vector_type;
+        typedef StaticStorage<ItemType, Capacity>   Base;
+
+        /** @brief Throws std::length_error unless @b count more items fit */
+        constexpr void check_room(size_t count) const;
+
+        /** @brief Turns [first, middle) [middle, end) into [middle, end) [first, middle) */
+        constexpr void rotate(size_t first, size_t middle);
+
+        constexpr void swap_items(ItemType& left, ItemType& right);
+
+        template <typename IntegralType>
+        constexpr void assign_choose(IntegralType count, IntegralType value, std::true_type);
+
+        template <typename InputIterator>
+        constexpr void assign_choose(InputIterator first, InputIterator last, std::false_type);
+
+        template <typename IntegralType>
+        constexpr size_t insert_choose(size_t index, IntegralType count, IntegralType value, std::true_type);
+
+        template <typename InputIterator>
+        constexpr size_t insert_choose(size_t index, InputIterator first, InputIterator last, std::false_type);
+
+        constexpr int compare(const StaticVector& other) const;
+
+    public:
+        typedef ItemType            value_type;
+        typedef ItemType*           pointer;
+        typedef const ItemType*     const_pointer;
+        typedef ItemType&           reference;
+        typedef const ItemType&     const_reference;
+
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+
+        typedef NormalIterator<pointer, vector_type>        iterator;
+        typedef NormalIterator<const_pointer, vector_type>  const_iterator;
+
+        constexpr StaticVector();
+        constexpr explicit StaticVector(size_type size);
+        constexpr StaticVector(size_type size, const value_type& value);
+
+        template <typename InputIterator>
+        constexpr StaticVector(InputIterator first, InputIterator last);
+
+        constexpr StaticVector(std::initializer_list<ItemType> list);
+
+        constexpr StaticVector(const StaticVector& other);
+        constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible<ItemType>::value);
+
+        constexpr StaticVector& operator=(const StaticVector& other);
+        constexpr StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_assignable<ItemType>::value &&
+            std::is_nothrow_move_constructible<ItemType>::value);
+        constexpr StaticVector& operator=(std::initializer_list<ItemType> list);
+
+        constexpr void assign(size_type count, const value_type& value);
+
+        template <typename IteratorType>
+        constexpr void assign(IteratorType first, IteratorType last);
+
+        constexpr void assign(std::initializer_list<ItemType> list);
+
+        constexpr reference operator[](size_type offset);
+        constexpr const_reference operator[](size_type offset) const;
+
+        constexpr reference at(size_type offset);
+        constexpr const_reference at(size_type offset) const;
+
+        constexpr reference front();
+        constexpr const_reference front() const;
+
+        constexpr reference back();
+        constexpr const_reference back() const;
+
+        constexpr pointer data();
+        constexpr const_pointer data() const;
+
+        constexpr size_type size() const;
+        constexpr size_type max_size() const;
+        constexpr size_type capacity() const;
+
+        constexpr iterator begin();
+        constexpr const_iterator begin() const;
+
+        constexpr iterator end();
+        constexpr const_iterator end() const;
+
+        constexpr bool empty() const;
+        constexpr bool full() const;
+
+        constexpr iterator erase(iterator position);
+        constexpr iterator erase(iterator first, iterator last);
+
+        constexpr iterator insert(iterator position, const value_type& value);
+        constexpr iterator insert(iterator position, value_type&& value);
+        constexpr iterator insert(iterator position, size_type count, const value_type& value);
+
+        template <typename IteratorType>
+        constexpr iterator insert(iterator position, IteratorType first, IteratorType last);
+
+        template <typename... Args>
+        constexpr iterator emplace(iterator position, Args&&... args);
+
+        constexpr void clear();
+
+        constexpr void push_back(const value_type& value);
+        constexpr void push_back(value_type&& value);
+
+        template <typename... Args>
+        constexpr reference emplace_back(Args&&... args);
+
+        /**
+         * @brief Only checks that @b capacity items fit, the storage is already there
+         */
+        constexpr void reserve(size_type capacity);
+
+        constexpr void pop_back();
+
+        constexpr void resize(size_type size);
+        constexpr void resize(size_type size, const value_type& value);
+
+        constexpr void swap(StaticVector& other);
+
+        constexpr bool operator==(const StaticVector& other) const;
+        constexpr bool operator!=(const StaticVector& other) const;
+
+        constexpr bool operator<(const StaticVector& other) const;
+        constexpr bool operator>(const StaticVector& other) const;
+        constexpr bool operator<=(const StaticVector& other) const;
+        constexpr bool operator>=(const StaticVector& other) const;
+};
+
+/**
+ * @brief A Stack which never allocates, over a StaticVector of Capacity items
+ */
+template <typename ItemType, size_t Capacity>
+using StaticStack = Stack<ItemType, StaticVector<ItemType, Capacity>>;
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>::StaticVector() : Base() {}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>::StaticVector(size_type size) : Base() {
+    this->resize(size);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>::StaticVector(size_type size, const value_type& value) : Base() {
+    this->resize(size, value);
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename InputIterator>
+constexpr StaticVector<ItemType, Capacity>::StaticVector(InputIterator first, InputIterator last) : Base() {
+    this->assign_choose(first, last, std::is_integral<InputIterator>());
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>::StaticVector(std::initializer_list<ItemType> list) : Base() {
+    this->append(list.begin(), list.end());
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>::StaticVector(const StaticVector& other) : Base() {
+    for ( ; this->count < other.count; this->count++)
+        this->construct_at(this->count, other.slots()[this->count]);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>::StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible<ItemType>::value) : Base() {
+    for ( ; this->count < other.count; this->count++)
+        this->construct_at(this->count, std::move(other.slots()[this->count]));
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>& StaticVector<ItemType, Capacity>::operator=(const StaticVector& other) {
+    if (this != &other)
+        this->assign_choose(other.begin(), other.end(), std::false_type());
+
+    return *this;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>& StaticVector<ItemType, Capacity>::operator=(StaticVector&& other)
+    noexcept(std::is_nothrow_move_assignable<ItemType>::value && std::is_nothrow_move_constructible<ItemType>::value) {
+    if (this != &other) {
+        size_t common = (this->count < other.count) ? this->count : other.count;
+
+        for (size_t index = 0; index < common; index++)
+            this->slots()[index] = std::move(other.slots()[index]);
+
+        for ( ; this->count < other.count; this->count++)
+            this->construct_at(this->count, std::move(other.slots()[this->count]));
+
+        while (this->count > other.count)
+            this->destroy_at(--this->count);
+    }
+
+    return *this;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr StaticVector<ItemType, Capacity>& StaticVector<ItemType, Capacity>::operator=(std::initializer_list<ItemType> list) {
+    this->assign_choose(list.begin(), list.end(), std::false_type());
+
+    return *this;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::check_room(size_t count) const {
+    if (count > Capacity - this->count)
+        throw std::length_error("std::length_error in StaticVector, capacity exceeded");
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::swap_items(ItemType& left, ItemType& right) {
+    ItemType temp(std::move(left));
+
+    left = std::move(right);
+    right = std::move(temp);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::rotate(size_t first, size_t middle) {
+    ItemType* items = this->slots();
+
+    // Three reversals, so no item ever leaves the storage.
+    for (size_t left = first, right = middle; left + 1 < right; left++, right--)
+        this->swap_items(items[left], items[right - 1]);
+
+    for (size_t left = middle, right = this->count; left + 1 < right; left++, right--)
+        this->swap_items(items[left], items[right - 1]);
+
+    for (size_t left = first, right = this->count; left + 1 < right; left++, right--)
+        this->swap_items(items[left], items[right - 1]);
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename IntegralType>
+constexpr void StaticVector<ItemType, Capacity>::assign_choose(IntegralType count, IntegralType value, std::true_type) {
+    this->assign(static_cast<size_type>(count), static_cast<value_type>(value));
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename InputIterator>
+constexpr void StaticVector<ItemType, Capacity>::assign_choose(InputIterator first, InputIterator last, std::false_type) {
+    size_t index = 0;
+
+    for ( ; first != last && index < this->count; first++, index++)
+        this->slots()[index] = *first;
+
+    while (this->count > index)
+        this->destroy_at(--this->count);
+
+    this->append(first, last);
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename IntegralType>
+constexpr size_t StaticVector<ItemType, Capacity>::insert_choose(size_t index, IntegralType count, IntegralType value, std::true_type) {
+    return this->insert(this->begin() + index, static_cast<size_type>(count), static_cast<value_type>(value)) - this->begin();
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename InputIterator>
+constexpr size_t StaticVector<ItemType, Capacity>::insert_choose(size_t index, InputIterator first, InputIterator last, std::false_type) {
+    size_t old_count = this->count;
+
+    this->append(first, last);
+    this->rotate(index, old_count);
+
+    return index;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::assign(size_type count, const value_type& value) {
+    if (count > Capacity)
+        throw std::length_error("std::length_error in StaticVector::assign(), capacity exceeded");
+
+    size_t index = 0;
+
+    for ( ; index < count && index < this->count; index++)
+        this->slots()[index] = value;
+
+    while (this->count > count)
+        this->destroy_at(--this->count);
+
+    for ( ; this->count < count; this->count++)
+        this->construct_at(this->count, value);
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename IteratorType>
+constexpr void StaticVector<ItemType, Capacity>::assign(IteratorType first, IteratorType last) {
+    this->assign_choose(first, last, std::is_integral<IteratorType>());
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::assign(std::initializer_list<ItemType> list) {
+    this->assign_choose(list.begin(), list.end(), std::false_type());
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::reference StaticVector<ItemType, Capacity>::operator[](size_type offset) {
+    return this->slots()[offset];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::const_reference StaticVector<ItemType, Capacity>::operator[](size_type offset) const {
+    return this->slots()[offset];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::reference StaticVector<ItemType, Capacity>::at(size_type offset) {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in StaticVector::at(size_type offset)");
+
+    return this->slots()[offset];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::const_reference StaticVector<ItemType, Capacity>::at(size_type offset) const {
+    if (offset >= this->count)
+        throw std::out_of_range("std::out_of_range in StaticVector::at(size_type offset) const");
+
+    return this->slots()[offset];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::reference StaticVector<ItemType, Capacity>::front() {
+    return this->slots()[0];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::const_reference StaticVector<ItemType, Capacity>::front() const {
+    return this->slots()[0];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::reference StaticVector<ItemType, Capacity>::back() {
+    return this->slots()[this->count - 1];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::const_reference StaticVector<ItemType, Capacity>::back() const {
+    return this->slots()[this->count - 1];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::pointer StaticVector<ItemType, Capacity>::data() {
+    return this->slots();
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::const_pointer StaticVector<ItemType, Capacity>::data() const {
+    return this->slots();
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::size_type StaticVector<ItemType, Capacity>::size() const {
+    return this->count;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::size_type StaticVector<ItemType, Capacity>::max_size() const {
+    return Capacity;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::size_type StaticVector<ItemType, Capacity>::capacity() const {
+    return Capacity;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::begin() {
+    return iterator(this->slots());
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::const_iterator StaticVector<ItemType, Capacity>::begin() const {
+    return const_iterator(this->slots());
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::end() {
+    return iterator(this->slots() + this->count);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::const_iterator StaticVector<ItemType, Capacity>::end() const {
+    return const_iterator(this->slots() + this->count);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::empty() const {
+    return this->count == 0;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::full() const {
+    return this->count == Capacity;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::erase(iterator position) {
+    return this->erase(position, position + 1);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::erase(iterator first, iterator last) {
+    size_t index = first.base() - this->slots();
+    size_t removed = last.base() - first.base();
+
+    for (size_t from = index + removed; from < this->count; from++)
+        this->slots()[from - removed] = std::move(this->slots()[from]);
+
+    for (size_t left = removed; left > 0; left--)
+        this->destroy_at(--this->count);
+
+    return this->begin() + index;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::insert(iterator position, const value_type& value) {
+    return this->emplace(position, value);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::insert(iterator position, value_type&& value) {
+    return this->emplace(position, std::move(value));
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::insert(iterator position, size_type count, const value_type& value) {
+    size_t index = position.base() - this->slots();
+    size_t old_count = this->count;
+
+    this->check_room(count);
+
+    // Appended first, so value may be an item of this vector.
+    this->fill_append(count, value);
+
+    this->rotate(index, old_count);
+
+    return this->begin() + index;
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename IteratorType>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::insert(iterator position, IteratorType first, IteratorType last) {
+    size_t index = position.base() - this->slots();
+
+    return this->begin() + this->insert_choose(index, first, last, std::is_integral<IteratorType>());
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename... Args>
+constexpr typename StaticVector<ItemType, Capacity>::iterator StaticVector<ItemType, Capacity>::emplace(iterator position, Args&&... args) {
+    size_t index = position.base() - this->slots();
+
+    this->emplace_back(std::forward<Args>(args)...);
+    this->rotate(index, this->count - 1);
+
+    return this->begin() + index;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::clear() {
+    while (this->count > 0)
+        this->destroy_at(--this->count);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::push_back(const value_type& value) {
+    this->emplace_back(value);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::push_back(value_type&& value) {
+    this->emplace_back(std::move(value));
+}
+
+template <typename ItemType, size_t Capacity>
+template <typename... Args>
+constexpr typename StaticVector<ItemType, Capacity>::reference StaticVector<ItemType, Capacity>::emplace_back(Args&&... args) {
+    this->check_room(1);
+    this->construct_at(this->count, std::forward<Args>(args)...);
+
+    return this->slots()[this->count++];
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::reserve(size_type capacity) {
+    if (capacity > Capacity)
+        throw std::length_error("std::length_error in StaticVector::reserve(), capacity exceeded");
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::pop_back() {
+    this->destroy_at(--this->count);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::resize(size_type size) {
+    if (size > Capacity)
+        throw std::length_error("std::length_error in StaticVector::resize(), capacity exceeded");
+
+    while (this->count > size)
+        this->destroy_at(--this->count);
+
+    for ( ; this->count < size; this->count++)
+        this->construct_at(this->count);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::resize(size_type size, const value_type& value) {
+    if (size > Capacity)
+        throw std::length_error("std::length_error in StaticVector::resize(), capacity exceeded");
+
+    while (this->count > size)
+        this->destroy_at(--this->count);
+
+    for ( ; this->count < size; this->count++)
+        this->construct_at(this->count, value);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr void StaticVector<ItemType, Capacity>::swap(StaticVector& other) {
+    StaticVector& shorter = (this->count < other.count) ? *this : other;
+    StaticVector& longer = (this->count < other.count) ? other : *this;
+    size_t common = shorter.count;
+
+    for (size_t index = 0; index < common; index++)
+        this->swap_items(shorter.slots()[index], longer.slots()[index]);
+
+    for ( ; shorter.count < longer.count; shorter.count++)
+        shorter.construct_at(shorter.count, std::move(longer.slots()[shorter.count]));
+
+    while (longer.count > common)
+        longer.destroy_at(--longer.count);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr int StaticVector<ItemType, Capacity>::compare(const StaticVector& other) const {
+    for (size_t index = 0; index < this->count && index < other.count; index++) {
+        if (this->slots()[index] < other.slots()[index])
+            return -1;
+
+        if (other.slots()[index] < this->slots()[index])
+            return 1;
+    }
+
+    return (this->count < other.count) ? -1 : (this->count > other.count);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::operator==(const StaticVector& other) const {
+    if (this->count != other.count)
+        return false;
+
+    for (size_t index = 0; index < this->count; index++)
+        if (!(this->slots()[index] == other.slots()[index]))
+            return false;
+
+    return true;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::operator!=(const StaticVector& other) const {
+    return !(*this == other);
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::operator<(const StaticVector& other) const {
+    return this->compare(other) < 0;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::operator>(const StaticVector& other) const {
+    return this->compare(other) > 0;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::operator<=(const StaticVector& other) const {
+    return this->compare(other) <= 0;
+}
+
+template <typename ItemType, size_t Capacity>
+constexpr bool StaticVector<ItemType, Capacity>::operator>=(const StaticVector& other) const {
+    return this->compare(other) >= 0;
+}
@@ -1,6 +1,9 @@
 #pragma once
 
-template <typename ItemType>
+// Used for std::allocator.
+#include <memory>
+
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
 class Tree {
     private:
         class Node {
@@ -17,8 +20,16 @@ class Tree {
                 Node(const ItemType& value, Node *parent);
         };
 
+        // Nodes are allocated through Allocator rebound to Node, so a Tree can live in an Arena.
+        typedef typename Allocator::template rebind<Node>::other NodeAllocator;
+
+        NodeAllocator node_allocator;
+
         Node *root;
 
+        Node *create_node(const ItemType& value, Node *parent);
+        void destroy_node(Node *node);
+
         void real_delete(Node *leaf);
 
         Node *real_insert(Node *leaf, Node *parent, const ItemType& value);
@@ -86,13 +97,17 @@ class Tree {
                 bool operator!=(const ConstIterator &iterator) const;
         };
 
-        Tree();
+        typedef Allocator allocator_type;
+
+        Tree(const allocator_type& allocator = allocator_type());
         Tree(const Tree& other);
         
         Tree& operator=(const Tree& other);
 
         ~Tree();
 
+        allocator_type get_allocator() const;
+
         void insert(const ItemType& value);
         void erase(const ItemType& value);
 
@@ -107,8 +122,8 @@ class Tree {
         ConstIterator cend() const;
 };
 
-template <typename ItemType>
-Tree<ItemType>::Node::Node() {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Node::Node() {
     this->value = ItemType();
 
     this->parent = nullptr;
@@ -117,8 +132,8 @@ Tree<ItemType>::Node::Node() {
     this->right = nullptr;
 }
 
-template <typename ItemType>
-Tree<ItemType>::Node::Node(const ItemType& value) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Node::Node(const ItemType& value) {
     this->value = value;
 
     this->parent = nullptr;
@@ -127,8 +142,8 @@ Tree<ItemType>::Node::Node(const ItemType& value) {
     this->right = nullptr;
 }
 
-template <typename ItemType>
-Tree<ItemType>::Node::Node(const ItemType& value, Node* parent) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Node::Node(const ItemType& value, Node* parent) {
     this->value = value;
 
     this->parent = parent;
@@ -137,13 +152,13 @@ Tree<ItemType>::Node::Node(const ItemType& value, Node* parent) {
     this->right = nullptr;
 }
 
-template <typename ItemType>
-Tree<ItemType>::Tree() {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Tree(const allocator_type& allocator) : node_allocator(allocator) {
     this->root = nullptr;
 }
 
-template <typename ItemType>
-Tree<ItemType>::Tree(const Tree &other) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Tree(const Tree &other) : node_allocator(other.node_allocator) {
     this->root = nullptr;
 
     for (auto it = other.cbegin(); it != other.cend(); it++)
@@ -151,35 +166,63 @@ Tree<ItemType>::Tree(const Tree &other) {
 
 }
 
-template <typename ItemType>
-Tree<ItemType>& Tree<ItemType>::operator=(const Tree &other) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>& Tree<ItemType, Allocator>::operator=(const Tree &other) {
     this->real_delete(this->root);
 
     this->root = nullptr;
 
     for (auto it = other.cbegin(); it != other.cend(); it++)
         this->insert(it->value);
+
+    return *this;
+}
+
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::create_node(const ItemType& value, typename Tree<ItemType, Allocator>::Node *parent) {
+    Node *node = this->node_allocator.allocate(1);
+
+    try {
+        this->node_allocator.construct(node, value, parent);
+    } catch (...) {
+        this->node_allocator.deallocate(node, 1);
+
+        throw;
+    }
+
+    return node;
+}
+
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::destroy_node(typename Tree<ItemType, Allocator>::Node *node) {
+    this->node_allocator.destroy(node);
+    this->node_allocator.deallocate(node, 1);
+}
+
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::allocator_type Tree<ItemType, Allocator>::get_allocator() const {
+    return allocator_type(this->node_allocator);
 }
 
-template <typename ItemType>
-void Tree<ItemType>::real_delete(Tree<ItemType>::Node *leaf) {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::real_delete(Tree<ItemType, Allocator>::Node *leaf) {
     if (leaf != nullptr) {
         this->real_delete(leaf->left);
         this->real_delete(leaf->right);
 
-        delete leaf;
+        this->destroy_node(leaf);
     }
 }
 
-template <typename ItemType>
-Tree<ItemType>::~Tree() {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::~Tree() {
     this->real_delete(this->root);
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node* Tree<ItemType>::real_insert(Tree<ItemType>::Node *leaf, Tree<ItemType>::Node *parent, const ItemType& value) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::real_insert(Tree<ItemType, Allocator>::Node *leaf, Tree<ItemType, Allocator>::Node *parent, const ItemType& value) {
     if (leaf == nullptr)
-        leaf = new Node(value, parent);
+        leaf = this->create_node(value, parent);
     else if (value < leaf->value)
         leaf->left = real_insert(leaf->left, leaf, value);
     else if (value > leaf->value)
@@ -188,13 +231,13 @@ typename Tree<ItemType>::Node* Tree<ItemType>::real_insert(Tree<ItemType>::Node
     return leaf;
 }
 
-template <typename ItemType>
-void Tree<ItemType>::insert(const ItemType& value) {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::insert(const ItemType& value) {
     this->root = this->real_insert(this->root, this->root, value);
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node* Tree<ItemType>::min(Tree<ItemType>::Node *leaf) const {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::min(Tree<ItemType, Allocator>::Node *leaf) const {
     if (leaf == nullptr)
         return nullptr;
     else if (leaf->left == nullptr)
@@ -203,8 +246,8 @@ typename Tree<ItemType>::Node* Tree<ItemType>::min(Tree<ItemType>::Node *leaf) c
         return min(leaf->left);
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node* Tree<ItemType>::max(Tree<ItemType>::Node *leaf) const {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::max(Tree<ItemType, Allocator>::Node *leaf) const {
     if (leaf == nullptr)
         return nullptr;
     else if (leaf->right == nullptr)
@@ -213,8 +256,8 @@ typename Tree<ItemType>::Node* Tree<ItemType>::max(Tree<ItemType>::Node *leaf) c
         return max(leaf->right);
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node* Tree<ItemType>::real_erase(Tree<ItemType>::Node *leaf, const ItemType &value) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::real_erase(Tree<ItemType, Allocator>::Node *leaf, const ItemType &value) {
     if (leaf == nullptr)
         return nullptr;
     else if (value < leaf->value)
@@ -222,14 +265,14 @@ typename Tree<ItemType>::Node* Tree<ItemType>::real_erase(Tree<ItemType>::Node *
     else if (value > leaf->value)
         leaf->right = real_erase(leaf->right, value);
     else if (leaf->left == nullptr && leaf->right == nullptr) {
-        delete leaf;
+        this->destroy_node(leaf);
 
         leaf = nullptr;
     } else if (leaf->right == nullptr) {
         auto parent = leaf->parent;
         auto left = leaf->left;
 
-        delete leaf;
+        this->destroy_node(leaf);
 
         leaf = left;
         leaf->parent = parent;
@@ -237,7 +280,7 @@ typename Tree<ItemType>::Node* Tree<ItemType>::real_erase(Tree<ItemType>::Node *
         auto parent = leaf->parent;
         auto right = leaf->right;
 
-        delete leaf;
+        this->destroy_node(leaf);
 
         leaf = right;
         leaf->parent = parent;
@@ -252,20 +295,20 @@ typename Tree<ItemType>::Node* Tree<ItemType>::real_erase(Tree<ItemType>::Node *
         else
             leaf->left = temp->left;
 
-        delete temp;
+        this->destroy_node(temp);
         temp = nullptr;
     }
 
     return leaf;
 }
 
-template <typename ItemType>
-void Tree<ItemType>::erase(const ItemType &value) {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::erase(const ItemType &value) {
     this->root = this->real_erase(this->root, value);
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node* Tree<ItemType>::real_search(Tree<ItemType>::Node *leaf, const ItemType &value) const {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::real_search(Tree<ItemType, Allocator>::Node *leaf, const ItemType &value) const {
     if (leaf == nullptr || leaf->value == value)
         return leaf;
 
@@ -275,13 +318,13 @@ typename Tree<ItemType>::Node* Tree<ItemType>::real_search(Tree<ItemType>::Node
     return real_search(leaf->right, value);
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node* Tree<ItemType>::search(const ItemType &value) const {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::search(const ItemType &value) const {
     return this->real_search(this->root, value);
 }
 
-template <typename ItemType>
-void Tree<ItemType>::real_print(Tree<ItemType>::Node *leaf) const {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::real_print(Tree<ItemType, Allocator>::Node *leaf) const {
     if (leaf != nullptr) {
         real_print(leaf->left);
 
@@ -312,35 +355,35 @@ void Tree<ItemType>::real_print(Tree<ItemType>::Node *leaf) const {
     }
 }
 
-template <typename ItemType>
-void Tree<ItemType>::print() const {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::print() const {
     this->real_print(root);
 
     std::cout << std::endl;
 }
 
-template <typename ItemType>
-Tree<ItemType>::Iterator::Iterator() {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Iterator::Iterator() {
     this->current = nullptr;
 }
 
-template <typename ItemType>
-Tree<ItemType>::Iterator::Iterator(typename Tree<ItemType>::Node *node) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Iterator::Iterator(typename Tree<ItemType, Allocator>::Node *node) {
     this->current = node;
 }
 
-template <typename ItemType>
-Tree<ItemType>::Iterator::Iterator(const typename Tree<ItemType>::Iterator &iterator) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::Iterator::Iterator(const typename Tree<ItemType, Allocator>::Iterator &iterator) {
     this->current = iterator.current;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Iterator& Tree<ItemType>::Iterator::operator=(const Iterator &iterator) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Iterator& Tree<ItemType, Allocator>::Iterator::operator=(const Iterator &iterator) {
     this->current = iterator.current;
 }
 
-template <typename ItemType>
-void Tree<ItemType>::Iterator::increment() {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::Iterator::increment() {
     if (this->current->right != nullptr) {
         this->current = this->current->right;
 
@@ -360,15 +403,15 @@ void Tree<ItemType>::Iterator::increment() {
     }
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Iterator Tree<ItemType>::Iterator::operator++() {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Iterator Tree<ItemType, Allocator>::Iterator::operator++() {
     this->increment();
 
     return *this;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Iterator Tree<ItemType>::Iterator::operator++(int) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Iterator Tree<ItemType, Allocator>::Iterator::operator++(int) {
     auto iterator = *this;
 
     this->increment();
@@ -376,8 +419,8 @@ typename Tree<ItemType>::Iterator Tree<ItemType>::Iterator::operator++(int) {
     return iterator;
 }
 
-template <typename ItemType>
-void Tree<ItemType>::Iterator::decrement() {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::Iterator::decrement() {
     if (this->current->parent->parent == this->current)
         this->current = this->current->right;
     else if (this->current->left != nullptr) {
@@ -399,15 +442,15 @@ void Tree<ItemType>::Iterator::decrement() {
     }
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Iterator Tree<ItemType>::Iterator::operator--() {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Iterator Tree<ItemType, Allocator>::Iterator::operator--() {
     this->decrement();
 
     return *this;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Iterator Tree<ItemType>::Iterator::operator--(int) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Iterator Tree<ItemType, Allocator>::Iterator::operator--(int) {
     auto iterator = *this;
 
     this->decrement();
@@ -415,58 +458,58 @@ typename Tree<ItemType>::Iterator Tree<ItemType>::Iterator::operator--(int) {
     return iterator;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node& Tree<ItemType>::Iterator::operator*() {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node& Tree<ItemType, Allocator>::Iterator::operator*() {
     return *this->current;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Node* Tree<ItemType>::Iterator::operator->() {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::Iterator::operator->() {
     return this->current;
 }
 
-template <typename ItemType>
-bool Tree<ItemType>::Iterator::operator==(const Iterator& iterator) const {
+template <typename ItemType, typename Allocator>
+bool Tree<ItemType, Allocator>::Iterator::operator==(const Iterator& iterator) const {
     return this->current == iterator.current;
 }
 
-template <typename ItemType>
-bool Tree<ItemType>::Iterator::operator!=(const Iterator& iterator) const {
+template <typename ItemType, typename Allocator>
+bool Tree<ItemType, Allocator>::Iterator::operator!=(const Iterator& iterator) const {
     return this->current != iterator.current;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Iterator Tree<ItemType>::begin() {
-    return Tree<ItemType>::Iterator(this->min(this->root));
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Iterator Tree<ItemType, Allocator>::begin() {
+    return Tree<ItemType, Allocator>::Iterator(this->min(this->root));
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::Iterator Tree<ItemType>::end() {
-    return Tree<ItemType>::Iterator(nullptr);
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::Iterator Tree<ItemType, Allocator>::end() {
+    return Tree<ItemType, Allocator>::Iterator(nullptr);
 }
 
-template <typename ItemType>
-Tree<ItemType>::ConstIterator::ConstIterator() {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::ConstIterator::ConstIterator() {
     this->current = nullptr;
 }
 
-template <typename ItemType>
-Tree<ItemType>::ConstIterator::ConstIterator(typename Tree<ItemType>::Node *node) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::ConstIterator::ConstIterator(typename Tree<ItemType, Allocator>::Node *node) {
     this->current = node;
 }
 
-template <typename ItemType>
-Tree<ItemType>::ConstIterator::ConstIterator(const typename Tree<ItemType>::ConstIterator &iterator) {
+template <typename ItemType, typename Allocator>
+Tree<ItemType, Allocator>::ConstIterator::ConstIterator(const typename Tree<ItemType, Allocator>::ConstIterator &iterator) {
     this->current = iterator.current;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::ConstIterator& Tree<ItemType>::ConstIterator::operator=(const ConstIterator &iterator) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::ConstIterator& Tree<ItemType, Allocator>::ConstIterator::operator=(const ConstIterator &iterator) {
     this->current = iterator.current;
 }
 
-template <typename ItemType>
-void Tree<ItemType>::ConstIterator::increment() {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::ConstIterator::increment() {
     if (this->current->right != nullptr) {
         this->current = this->current->right;
 
@@ -486,15 +529,15 @@ void Tree<ItemType>::ConstIterator::increment() {
     }
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::ConstIterator Tree<ItemType>::ConstIterator::operator++() {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::ConstIterator Tree<ItemType, Allocator>::ConstIterator::operator++() {
     this->increment();
 
     return *this;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::ConstIterator Tree<ItemType>::ConstIterator::operator++(int) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::ConstIterator Tree<ItemType, Allocator>::ConstIterator::operator++(int) {
     auto iterator = *this;
 
     this->increment();
@@ -502,8 +545,8 @@ typename Tree<ItemType>::ConstIterator Tree<ItemType>::ConstIterator::operator++
     return iterator;
 }
 
-template <typename ItemType>
-void Tree<ItemType>::ConstIterator::decrement() {
+template <typename ItemType, typename Allocator>
+void Tree<ItemType, Allocator>::ConstIterator::decrement() {
     if (this->current->parent->parent == this->current)
         this->current = this->current->right;
     else if (this->current->left != nullptr) {
@@ -525,15 +568,15 @@ void Tree<ItemType>::ConstIterator::decrement() {
     }
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::ConstIterator Tree<ItemType>::ConstIterator::operator--() {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::ConstIterator Tree<ItemType, Allocator>::ConstIterator::operator--() {
     this->decrement();
 
     return *this;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::ConstIterator Tree<ItemType>::ConstIterator::operator--(int) {
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::ConstIterator Tree<ItemType, Allocator>::ConstIterator::operator--(int) {
     auto iterator = *this;
 
     this->decrement();
@@ -541,32 +584,32 @@ typename Tree<ItemType>::ConstIterator Tree<ItemType>::ConstIterator::operator--
     return iterator;
 }
 
-template <typename ItemType>
-const typename Tree<ItemType>::Node& Tree<ItemType>::ConstIterator::operator*() const {
+template <typename ItemType, typename Allocator>
+const typename Tree<ItemType, Allocator>::Node& Tree<ItemType, Allocator>::ConstIterator::operator*() const {
     return *this->current;
 }
 
-template <typename ItemType>
-const typename Tree<ItemType>::Node* Tree<ItemType>::ConstIterator::operator->() const {
+template <typename ItemType, typename Allocator>
+const typename Tree<ItemType, Allocator>::Node* Tree<ItemType, Allocator>::ConstIterator::operator->() const {
     return this->current;
 }
 
-template <typename ItemType>
-bool Tree<ItemType>::ConstIterator::operator==(const ConstIterator& iterator) const {
+template <typename ItemType, typename Allocator>
+bool Tree<ItemType, Allocator>::ConstIterator::operator==(const ConstIterator& iterator) const {
     return this->current == iterator.current;
 }
 
-template <typename ItemType>
-bool Tree<ItemType>::ConstIterator::operator!=(const ConstIterator& iterator) const {
+template <typename ItemType, typename Allocator>
+bool Tree<ItemType, Allocator>::ConstIterator::operator!=(const ConstIterator& iterator) const {
     return this->current != iterator.current;
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::ConstIterator Tree<ItemType>::cbegin() const {
-    return Tree<ItemType>::ConstIterator(this->min(this->root));
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::ConstIterator Tree<ItemType, Allocator>::cbegin() const {
+    return Tree<ItemType, Allocator>::ConstIterator(this->min(this->root));
 }
 
-template <typename ItemType>
-typename Tree<ItemType>::ConstIterator Tree<ItemType>::cend() const {
-    return Tree<ItemType>::ConstIterator(nullptr);
+template <typename ItemType, typename Allocator>
+typename Tree<ItemType, Allocator>::ConstIterator Tree<ItemType, Allocator>::cend() const {
+    return Tree<ItemType, Allocator>::ConstIterator(nullptr);
 }
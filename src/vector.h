@@ -3,6 +3,7 @@
 #include "iterator.h"
 #include "mem_tools.h"
 #include "misc.h"
+#include "growth_policy.h"
 
 // Used for true_type and false_type.
 #include <type_traits>
@@ -16,7 +17,13 @@
 // Used for initialize_list constructor and assign.
 #include <initializer_list>
 
-template <typename ItemType, typename Allocator> 
+// Used for std::move() and std::forward().
+#include <utility>
+
+// Used for std::out_of_range and std::length_error.
+#include <stdexcept>
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy> 
 class VectorBase {
     private:
         struct VectorMemory : public Allocator {
@@ -33,6 +40,7 @@ class VectorBase {
 
     public:
         typedef Allocator       allocator_type;
+        typedef GrowthPolicy    growth_policy;
 
         VectorMemory memory; 
 
@@ -49,6 +57,30 @@ class VectorBase {
                 this->memory.deallocate(start, size);
         }
 
+        /*
+         * Tries to grow the block at start to capacity items without copying it, through
+         * Allocator::reallocate(). Returns nullptr if the allocator can not do that.
+         */
+        ItemType* memory_reallocate(ItemType* start, size_t size, size_t capacity) {
+            return this->memory_reallocate(start, size, capacity, typename allocator_can_reallocate<Allocator, ItemType>::type());
+        }
+
+        ItemType* memory_reallocate(ItemType* start, size_t size, size_t capacity, std::true_type) {
+            return this->memory.reallocate(start, size, capacity);
+        }
+
+        ItemType* memory_reallocate(ItemType*, size_t, size_t, std::false_type) {
+            return nullptr;
+        }
+
+        size_t memory_grow(size_t capacity) const {
+            return GrowthPolicy::grow(capacity, sizeof(ItemType));
+        }
+
+        size_t memory_round(size_t capacity) const {
+            return GrowthPolicy::round(capacity, sizeof(ItemType));
+        }
+
         VectorBase(const allocator_type& allocator) : memory(VectorMemory(allocator)) {}
 
         VectorBase(size_t size, const allocator_type& allocator) : memory(VectorMemory(allocator)) {
@@ -64,11 +96,15 @@ class VectorBase {
         }
 };
 
-template <typename ItemType, typename Allocator = std::allocator<ItemType>>
-class Vector : protected VectorBase<ItemType, Allocator> {
+template <typename ItemType, typename Allocator = std::allocator<ItemType>, typename GrowthPolicy = DoublingGrowth>
+class Vector : protected VectorBase<ItemType, Allocator, GrowthPolicy> {
     private:
-        typedef Vector<ItemType, Allocator>       vector_type;
-        typedef VectorBase<ItemType, Allocator>   Base;
+        typedef Vector<ItemType, Allocator, GrowthPolicy>       vector_type;
+        typedef VectorBase<ItemType, Allocator, GrowthPolicy>   Base;
+
+        // Whether growth can hand the block to Allocator::reallocate() instead of copying it.
+        typedef std::integral_constant<bool, is_trivially_relocatable<ItemType>::value &&
+            allocator_can_reallocate<Allocator, ItemType>::value> expandable;
 
     public:
         typedef ItemType                                value_type;
@@ -81,6 +117,7 @@ class Vector : protected VectorBase<ItemType, Allocator> {
         typedef ptrdiff_t                               difference_type;
 
         typedef typename Base::allocator_type           allocator_type;
+        typedef typename Base::growth_policy            growth_policy;
 
         typedef NormalIterator<pointer, vector_type>            iterator;
         typedef NormalIterator<const_pointer, vector_type>      const_iterator;
@@ -90,6 +127,7 @@ class Vector : protected VectorBase<ItemType, Allocator> {
         Vector(size_type size);
 
         Vector(const Vector& other);
+        Vector(Vector&& other) noexcept;
 
         template <typename InputIterator>
         Vector(InputIterator first, InputIterator last, const allocator_type& allocator = allocator_type());
@@ -97,16 +135,55 @@ class Vector : protected VectorBase<ItemType, Allocator> {
         ~Vector();
 
         Vector& operator=(const Vector& other);
+        Vector& operator=(Vector&& other) noexcept;
 
     protected:
+        size_type next_capacity() const;
+
+        void reallocate(size_type capacity);
+        size_type grow_capacity(size_type required) const;
+        size_type resize_capacity(size_type required) const;
+
+        void resize_reserve(size_type size);
+
+        void fill_insert(ItemType* position, size_type count, const value_type& value);
+
+        int compare(const Vector& other) const;
+
+        template <typename IntegralType>
+        iterator insert_choose(iterator position, IntegralType first, IntegralType last, std::true_type);
+
+        template <typename IteratorType>
+        iterator insert_choose(iterator position, IteratorType first, IteratorType last, std::false_type);
+
+        template <typename InputIterator>
+        iterator insert_range_fill(iterator position, InputIterator first, InputIterator last, input_iterator_tag);
+
+        template <typename ForwardIterator>
+        iterator insert_range_fill(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+        template <typename... Args>
+        void realloc_emplace_back(std::true_type, Args&&... args);
+
+        template <typename... Args>
+        void realloc_emplace_back(std::false_type, Args&&... args);
+
         template <typename Type>
         void assign_choose(Type first, Type last, bool is_integral);
 
         void assign_fill(size_type count, const value_type& value);
 
+        void assign_storage(ItemType* start, size_type size, size_type capacity);
+
         template <typename InputIterator>
         void assign_range_fill(InputIterator first, InputIterator last);
 
+        template <typename InputIterator>
+        void assign_range_fill(InputIterator first, InputIterator last, input_iterator_tag);
+
+        template <typename ForwardIterator>
+        void assign_range_fill(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
         template <typename IntegralType>
         void assign_choose(IntegralType first, IntegralType last, std::true_type);
 
@@ -145,274 +222,636 @@ class Vector : protected VectorBase<ItemType, Allocator> {
         iterator end();
         const_iterator end() const;
 
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+
         bool empty() const;
 
         iterator erase(iterator position);
-        void erase(iterator first, iterator last);
+        iterator erase(iterator first, iterator last);
 
         iterator insert(iterator position, const value_type& value);
+        iterator insert(iterator position, value_type&& value);
+        iterator insert(iterator position, size_type count, const value_type& value);
+
+        template <typename IteratorType>
+        iterator insert(iterator position, IteratorType first, IteratorType last);
+
+        template <typename... Args>
+        iterator emplace(iterator position, Args&&... args);
 
         void clear();
 
         void push_back(const value_type& value);
+        void push_back(value_type&& value);
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
 
         void reserve(size_type capacity);
+        void reserve_exact(size_type capacity);
+
+        void shrink_to_fit();
         bool alloc_memory_if_needed();
 
         void pop_back();
 
-        bool operator==(const Vector& other);
-        bool operator!=(const Vector& other);
+        void resize(size_type size);
+        void resize(size_type size, const value_type& value);
+        void resize(size_type size, default_init_t);
+
+        /*
+         * Grows or shrinks to size items, leaving the new ones uninitialized, so a buffer
+         * about to be filled (from a file or a socket) is not zero filled first.
+         */
+        void resize_uninitialized(size_type size);
+
+        void swap(Vector& other) noexcept;
+
+        bool operator==(const Vector& other) const;
+        bool operator!=(const Vector& other) const;
+
+        bool operator<(const Vector& other) const;
+        bool operator>(const Vector& other) const;
+        bool operator<=(const Vector& other) const;
+        bool operator>=(const Vector& other) const;
 };
 
-template <typename ItemType, typename Allocator>
-Vector<ItemType, Allocator>::Vector(const allocator_type& allocator) : Base(allocator) {}
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>::Vector(const allocator_type& allocator) : Base(allocator) {}
 
-template <typename ItemType, typename Allocator>
-Vector<ItemType, Allocator>::Vector(size_type size, const value_type& value, const allocator_type& allocator) : Base(size, allocator) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>::Vector(size_type size, const value_type& value, const allocator_type& allocator) : Base(size, allocator) {
     uninitialized_fill(this->memory.start, size, value, this->get_allocator());
 
     this->memory.finish = this->memory.start + size;
 }
 
-template <typename ItemType, typename Allocator>
-Vector<ItemType, Allocator>::Vector(size_type size) : Base(size, allocator_type()) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>::Vector(size_type size) : Base(size, allocator_type()) {
     uninitialized_fill(this->memory.start, size, value_type(), this->get_allocator());
 
     this->memory.finish = this->memory.start + size;
 }
 
-template <typename ItemType, typename Allocator>
-Vector<ItemType, Allocator>::Vector(const Vector<ItemType, Allocator>& other) : Base(other.size(), other.get_allocator()) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename InputIterator>
+Vector<ItemType, Allocator, GrowthPolicy>::Vector(InputIterator first, InputIterator last, const allocator_type& allocator) : Base(allocator) {
+    this->assign_choose(first, last, std::is_integral<InputIterator>());
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>::Vector(const Vector<ItemType, Allocator, GrowthPolicy>& other) : Base(other.size(), other.get_allocator()) {
     this->memory.finish = uninitialized_copy(other.begin(), other.end(), this->memory.start, this->get_allocator());
 }
 
-template <typename ItemType, typename Allocator>
-Vector<ItemType, Allocator>& Vector<ItemType, Allocator>::operator=(const Vector<ItemType, Allocator>& other) {
-    // Asssuming that the Allocator interface inherited by VectorMemory has a working operator=()
-    this->memory = other.memory;
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>::Vector(Vector<ItemType, Allocator, GrowthPolicy>&& other) noexcept : Base(other.get_allocator()) {
+    this->swap(other);
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>& Vector<ItemType, Allocator, GrowthPolicy>::operator=(const Vector<ItemType, Allocator, GrowthPolicy>& other) {
+    if (this != &other) {
+        Vector<ItemType, Allocator, GrowthPolicy> copy(other);
+
+        this->swap(copy);
+    }
+
+    return *this;
 }
 
-template <typename ItemType, typename Allocator>
-Vector<ItemType, Allocator>::~Vector() {
-    for (size_type index = 0; index < this->size(); index++)
-        this->memory.destroy(this->memory.start + index);
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>& Vector<ItemType, Allocator, GrowthPolicy>::operator=(Vector<ItemType, Allocator, GrowthPolicy>&& other) noexcept {
+    if (this != &other) {
+        Vector<ItemType, Allocator, GrowthPolicy> temp(std::move(other));
+
+        this->swap(temp);
+    }
+
+    return *this;
 }
 
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+Vector<ItemType, Allocator, GrowthPolicy>::~Vector() {
+    destroy(this->memory.start, this->memory.finish, this->get_allocator());
+}
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::assign_fill(size_type count, const value_type& value) {
-    this->clear();
 
-    while (this->size() < count) 
-        this->push_back(value);
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::assign_storage(ItemType* start, size_type size, size_type capacity) {
+    destroy(this->memory.start, this->memory.finish, this->get_allocator());
+
+    this->memory_deallocate(this->memory.start, this->capacity());
+
+    this->memory.start = start;
+    this->memory.finish = start + size;
+    this->memory.storage_end = start + capacity;
 }
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::assign(size_type count, const value_type& value) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::assign_fill(size_type count, const value_type& value) {
+    if (count > this->capacity()) {
+        /*
+         * Fill a new block before releasing the old one, value may be one of the
+         * elements being replaced.
+         */
+        size_type capacity = this->memory_round(count);
+        ItemType* temp = this->memory_allocate(capacity);
+
+        try {
+            uninitialized_fill(temp, count, value, this->get_allocator());
+        } catch (...) {
+            this->memory_deallocate(temp, capacity);
+
+            throw;
+        }
+
+        this->assign_storage(temp, count, capacity);
+
+        return;
+    }
+
+    ItemType* position = this->memory.start;
+
+    for ( ; position != this->memory.finish && count > 0; position++, count--)
+        *position = value;
+
+    if (count > 0)
+        uninitialized_fill(this->memory.finish, count, value, this->get_allocator());
+    else
+        destroy(position, this->memory.finish, this->get_allocator());
+
+    this->memory.finish = position + count;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::assign(size_type count, const value_type& value) {
     this->assign_fill(count, value);
 }
 
-template <typename ItemType, typename Allocator>
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
 template <typename IteratorType>
-void Vector<ItemType, Allocator>::assign_range_fill(IteratorType first, IteratorType last) {
+void Vector<ItemType, Allocator, GrowthPolicy>::assign_range_fill(IteratorType first, IteratorType last) {
+    this->assign_range_fill(first, last, typename IteratorCategory<IteratorType>::type());
+}
+
+/*
+ * Single pass ranges can not be measured beforehand, so they grow as they are read.
+ */
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename InputIterator>
+void Vector<ItemType, Allocator, GrowthPolicy>::assign_range_fill(InputIterator first, InputIterator last, input_iterator_tag) {
     this->clear();
 
-    for (auto it = first; it != last; it++)
-        this->push_back(*it);
+    for ( ; first != last; first++)
+        this->push_back(*first);
+}
+
+/*
+ * Multi pass ranges are measured first, then copied into the current block if it
+ * is large enough, or into a single block of the exact size otherwise.
+ */
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename ForwardIterator>
+void Vector<ItemType, Allocator, GrowthPolicy>::assign_range_fill(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+    size_type count = iterator_distance(first, last);
+
+    if (count > this->capacity()) {
+        size_type capacity = this->memory_round(count);
+        ItemType* temp = this->memory_allocate(capacity);
+
+        try {
+            uninitialized_copy(first, last, temp, this->get_allocator());
+        } catch (...) {
+            this->memory_deallocate(temp, capacity);
+
+            throw;
+        }
+
+        this->assign_storage(temp, count, capacity);
+
+        return;
+    }
+
+    ItemType* position = this->memory.start;
+
+    for ( ; position != this->memory.finish && first != last; position++, first++)
+        *position = *first;
+
+    if (first != last)
+        this->memory.finish = uninitialized_copy(first, last, this->memory.finish, this->get_allocator());
+    else {
+        destroy(position, this->memory.finish, this->get_allocator());
+
+        this->memory.finish = position;
+    }
 }
 
-template <typename ItemType, typename Allocator>
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
 template <typename IntegralType>
-void Vector<ItemType, Allocator>::assign_choose(IntegralType first, IntegralType last, std::true_type) {
+void Vector<ItemType, Allocator, GrowthPolicy>::assign_choose(IntegralType first, IntegralType last, std::true_type) {
     this->assign_fill(static_cast<size_type>(first), static_cast<value_type>(last));
 }
 
-template <typename ItemType, typename Allocator>
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
 template <typename InteratorType>
-void Vector<ItemType, Allocator>::assign_choose(InteratorType first, InteratorType last, std::false_type) {
+void Vector<ItemType, Allocator, GrowthPolicy>::assign_choose(InteratorType first, InteratorType last, std::false_type) {
     this->assign_range_fill(first, last);
 }
 
-template <typename ItemType, typename Allocator>
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
 template <typename IteratorType>
-void Vector<ItemType, Allocator>::assign(IteratorType first, IteratorType last) {
+void Vector<ItemType, Allocator, GrowthPolicy>::assign(IteratorType first, IteratorType last) {
     this->assign_choose(first, last, std::is_integral<IteratorType>());
 }
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::assign(std::initializer_list<ItemType> list) {
-    this->clear();
-
-    for (auto it = list.begin(); it != list.end(); it++)
-        this->push_back(*it);
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::assign(std::initializer_list<ItemType> list) {
+    this->assign_range_fill(list.begin(), list.end());
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::iterator Vector<ItemType, Allocator>::begin() {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::begin() {
     return iterator(this->memory.start);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::const_iterator Vector<ItemType, Allocator>::begin() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_iterator Vector<ItemType, Allocator, GrowthPolicy>::begin() const {
     return const_iterator(this->memory.start);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::iterator Vector<ItemType, Allocator>::end() {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::end() {
     return iterator(this->memory.finish);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::const_iterator Vector<ItemType, Allocator>::end() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_iterator Vector<ItemType, Allocator, GrowthPolicy>::end() const {
     return const_iterator(this->memory.finish);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::size_type Vector<ItemType, Allocator>::size() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_iterator Vector<ItemType, Allocator, GrowthPolicy>::cbegin() const {
+    return const_iterator(this->memory.start);
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_iterator Vector<ItemType, Allocator, GrowthPolicy>::cend() const {
+    return const_iterator(this->memory.finish);
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::size_type Vector<ItemType, Allocator, GrowthPolicy>::size() const {
     return size_type(this->memory.finish - this->memory.start);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::size_type Vector<ItemType, Allocator>::max_size() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::size_type Vector<ItemType, Allocator, GrowthPolicy>::max_size() const {
     return size_type(-1) / sizeof(value_type);
 } 
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::size_type Vector<ItemType, Allocator>::capacity() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::size_type Vector<ItemType, Allocator, GrowthPolicy>::capacity() const {
     return size_type(this->memory.storage_end - this->memory.start);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::iterator Vector<ItemType, Allocator>::erase(typename Vector<ItemType, Allocator>::iterator position) {
-    difference_type relative_position = position - this->begin();
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::erase(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position) {
+    this->memory.finish = close_gap(position.base(), this->memory.finish, 1, this->get_allocator());
 
-    for (auto it = position; it < this->end() - 1; it++)
-        *it = *(it + 1);
+    return position;
+}
 
-    this->memory.finish--;
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::erase(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator first, typename Vector<ItemType, Allocator, GrowthPolicy>::iterator last) {
+    if (first != last)
+        this->memory.finish = close_gap(first.base(), this->memory.finish, last - first, this->get_allocator());
 
-    if (this->alloc_memory_if_needed() == true)
-        return position + relative_position;
-
-    return position;
+    return first;
 }
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::erase(typename Vector<ItemType, Allocator>::iterator first, typename Vector<ItemType, Allocator>::iterator last) {
-    auto position = first;
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, const value_type& value) {
+    // value may refer to an element of this Vector, which is moved around below.
+    value_type copy(value);
 
-    for (auto it = first; it < last; it++)
-        position = this->erase(position);
+    return this->insert(position, std::move(copy));
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::iterator Vector<ItemType, Allocator>::insert(typename Vector<ItemType, Allocator>::iterator position, const value_type& value) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, value_type&& value) {
     difference_type relative_position = position - this->begin();
 
     if (this->alloc_memory_if_needed() == true)
         position = this->begin() + relative_position;
 
-    this->memory.finish++;
+    ItemType* finish = open_gap(position.base(), this->memory.finish, 1, this->get_allocator());
 
-    for (auto it = this->end() - 1; it > position; it--)
-        *it = *(it - 1);
+    try {
+        this->memory.construct(position.base(), std::move(value));
+    } catch (...) {
+        close_raw_gap(position.base(), finish, 1, this->get_allocator());
+
+        throw;
+    }
 
-    *position = value;
+    this->memory.finish = finish;
 
     return position;
 }
 
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::fill_insert(ItemType* position, size_type count, const value_type& value) {
+    ItemType* finish = open_gap(position, this->memory.finish, count, this->get_allocator());
+
+    try {
+        uninitialized_fill(position, count, value, this->get_allocator());
+    } catch (...) {
+        close_raw_gap(position, finish, count, this->get_allocator());
+
+        throw;
+    }
+
+    this->memory.finish = finish;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, size_type count, const value_type& value) {
+    difference_type relative_position = position - this->begin();
+
+    if (count == 0)
+        return position;
+
+    // value may refer to an element of this Vector, which is moved around below.
+    value_type copy(value);
+
+    if (this->size() + count > this->capacity())
+        this->reserve(this->grow_capacity(this->size() + count));
+
+    this->fill_insert(this->memory.start + relative_position, count, copy);
+
+    return this->begin() + relative_position;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename IntegralType>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert_choose(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, IntegralType first, IntegralType last, std::true_type) {
+    return this->insert(position, static_cast<size_type>(first), static_cast<value_type>(last));
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename IteratorType>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert_choose(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, IteratorType first, IteratorType last, std::false_type) {
+    return this->insert_range_fill(position, first, last, typename IteratorCategory<IteratorType>::type());
+}
+
+/*
+ * Single pass ranges can not be measured without consuming them, so they are read into
+ * a buffer first, whose items are then moved into place.
+ */
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename InputIterator>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert_range_fill(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+    Vector<ItemType, Allocator, GrowthPolicy> buffer(this->get_allocator());
+
+    for ( ; first != last; first++)
+        buffer.push_back(*first);
+
+    return this->insert_range_fill(position, std::make_move_iterator(buffer.memory.start), std::make_move_iterator(buffer.memory.finish), forward_iterator_tag());
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename ForwardIterator>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert_range_fill(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+    difference_type relative_position = position - this->begin();
+    size_type count = iterator_distance(first, last);
+
+    if (count == 0)
+        return position;
+
+    if (this->size() + count > this->capacity())
+        this->reserve(this->grow_capacity(this->size() + count));
+
+    ItemType* gap = this->memory.start + relative_position;
+    ItemType* finish = open_gap(gap, this->memory.finish, count, this->get_allocator());
+
+    // finish only moves once the gap is filled, a throwing copy closes the gap again.
+    try {
+        uninitialized_copy(first, last, gap, this->get_allocator());
+    } catch (...) {
+        close_raw_gap(gap, finish, count, this->get_allocator());
+
+        throw;
+    }
+
+    this->memory.finish = finish;
+
+    return this->begin() + relative_position;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename IteratorType>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::insert(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, IteratorType first, IteratorType last) {
+    return this->insert_choose(position, first, last, std::is_integral<IteratorType>());
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+typename Vector<ItemType, Allocator, GrowthPolicy>::iterator Vector<ItemType, Allocator, GrowthPolicy>::emplace(typename Vector<ItemType, Allocator, GrowthPolicy>::iterator position, Args&&... args) {
+    if (position == this->end()) {
+        difference_type relative_position = position - this->begin();
+
+        this->emplace_back(std::forward<Args>(args)...);
+
+        return this->begin() + relative_position;
+    }
+
+    return this->insert(position, value_type(std::forward<Args>(args)...));
+}
+
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::clear() {
-    this->erase(this->begin(), this->end());
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::clear() {
+    destroy(this->memory.start, this->memory.finish, this->get_allocator());
+
+    this->memory.finish = this->memory.start;
 }
 
-template <typename ItemType, typename Allocator>
-bool Vector<ItemType, Allocator>::empty() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::empty() const {
     return this->begin() == this->end();
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::reference Vector<ItemType, Allocator>::operator[](size_type offset) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::reference Vector<ItemType, Allocator, GrowthPolicy>::operator[](size_type offset) {
     return *(this->begin() + offset);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::const_reference Vector<ItemType, Allocator>::operator[](size_type offset) const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_reference Vector<ItemType, Allocator, GrowthPolicy>::operator[](size_type offset) const {
     return *(this->begin() + offset);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::reference Vector<ItemType, Allocator>::at(size_type offset) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::reference Vector<ItemType, Allocator, GrowthPolicy>::at(size_type offset) {
     if (offset > this->size())
         throw std::out_of_range("std::out_of_range in Vector::at(size_type offset)");
 
     return *(this->begin() + offset);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::const_reference Vector<ItemType, Allocator>::at(size_type offset) const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_reference Vector<ItemType, Allocator, GrowthPolicy>::at(size_type offset) const {
     if (offset > this->size())
         throw std::out_of_range("std::out_of_range in Vector::at(size_type offset) const");
 
     return *(this->begin() + offset);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::reference Vector<ItemType, Allocator>::front() {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::reference Vector<ItemType, Allocator, GrowthPolicy>::front() {
     return *this->begin();
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::const_reference Vector<ItemType, Allocator>::front() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_reference Vector<ItemType, Allocator, GrowthPolicy>::front() const {
     return *this->begin();
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::reference Vector<ItemType, Allocator>::back() {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::reference Vector<ItemType, Allocator, GrowthPolicy>::back() {
     return *(this->end() - 1);
 }
 
-template <typename ItemType, typename Allocator>
-typename Vector<ItemType, Allocator>::const_reference Vector<ItemType, Allocator>::back() const {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::const_reference Vector<ItemType, Allocator, GrowthPolicy>::back() const {
     return *(this->end() - 1);
 }
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::reserve(size_type capacity) {
-    if (capacity > this->capacity()) {
-        if (capacity > this->max_size())
-            throw std::length_error("Parameter of Vector::reserve(size_type) exceeds Vector::max_size()");
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::reallocate(size_type capacity) {
+    ItemType* temp = nullptr;
+
+    if (expandable::value && this->memory.start != nullptr && capacity != 0) {
+        temp = this->memory_reallocate(this->memory.start, this->capacity(), capacity);
 
-        auto temp = this->memory.allocate(capacity);
+        if (temp != nullptr) {
+            size_type size = this->size();
+
+            this->memory.start = temp;
+            this->memory.finish = temp + size;
+            this->memory.storage_end = temp + capacity;
+
+            return;
+        }
+    }
+
+    if (capacity != 0) {
+        temp = this->memory_allocate(capacity);
 
         if (temp == nullptr)
             throw std::bad_alloc();
+    }
+
+    /*
+     * Items are copied rather than moved when their move constructor may throw, relocate()
+     * then leaves this Vector as it was and destroys the copies already made, only the new
+     * block is left to free.
+     */
+    try {
+        relocate(this->memory.start, this->memory.finish, temp, this->get_allocator());
+    } catch (...) {
+        this->memory_deallocate(temp, capacity);
+
+        throw;
+    }
 
-        size_type index = 0;
-        for (auto it = this->memory.start; it != this->memory.finish; it++, index++)
-            *(temp + index) = *it;
+    size_type size = this->size();
 
-        size_type size = this->size();
+    this->memory_deallocate(this->memory.start, this->capacity());
+    this->memory.start = temp;
 
-        this->memory.deallocate(this->memory.start, this->capacity());
-        this->memory.start = temp;
+    this->memory.storage_end = this->memory.start + capacity;
+    this->memory.finish = this->memory.start + size;
+}
 
-        this->memory.storage_end = this->memory.start + capacity;
-        this->memory.finish = this->memory.start + size;
+/*
+ * The requested capacity is rounded up by GrowthPolicy::round(), use reserve_exact()
+ * to allocate exactly capacity items.
+ */
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::reserve(size_type capacity) {
+    if (capacity > this->capacity()) {
+        if (capacity > this->max_size())
+            throw std::length_error("std::length_error in Vector::reserve(size_type), parameter exceeds Vector::max_size()");
+
+        this->reallocate(this->memory_round(capacity));
+    }
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::reserve_exact(size_type capacity) {
+    if (capacity > this->capacity()) {
+        if (capacity > this->max_size())
+            throw std::length_error("std::length_error in Vector::reserve_exact(size_type), parameter exceeds Vector::max_size()");
+
+        this->reallocate(capacity);
+    }
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::shrink_to_fit() {
+    if (this->capacity() > this->size())
+        this->reallocate(this->size());
+}
+
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::size_type Vector<ItemType, Allocator, GrowthPolicy>::next_capacity() const {
+    return this->memory_grow(this->capacity());
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::size_type Vector<ItemType, Allocator, GrowthPolicy>::grow_capacity(size_type required) const {
+    size_type capacity = this->next_capacity();
+
+    return (capacity < required) ? this->memory_round(required) : capacity;
+}
+
+/*
+ * The capacity push_back() would end with after growing to required items, so that
+ * repeated resize() calls take amortized constant time.
+ */
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+typename Vector<ItemType, Allocator, GrowthPolicy>::size_type Vector<ItemType, Allocator, GrowthPolicy>::resize_capacity(size_type required) const {
+    if (required > this->max_size())
+        throw std::length_error("std::length_error in Vector::resize(size_type), parameter exceeds Vector::max_size()");
+
+    size_type capacity = this->capacity();
+
+    while (capacity < required) {
+        size_type next = this->memory_grow(capacity);
+
+        if (next <= capacity || next > this->max_size())
+            return this->memory_round(required);
+
+        capacity = next;
     }
+
+    return capacity;
 }
 
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::resize_reserve(size_type size) {
+    if (size > this->capacity())
+        this->reserve(this->resize_capacity(size));
+}
 
-template <typename ItemType, typename Allocator>
-bool Vector<ItemType, Allocator>::alloc_memory_if_needed() {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::alloc_memory_if_needed() {
     if (this->memory.finish == this->memory.storage_end) {
-        if (this->size() == 0)
-            this->reserve(1);
-        else 
-            this->reserve(this->capacity() * 2);
+        this->reserve(this->next_capacity());
 
         return true;
     }
@@ -420,31 +859,181 @@ bool Vector<ItemType, Allocator>::alloc_memory_if_needed() {
     return false;
 }
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::push_back(const value_type& value) {
-    alloc_memory_if_needed();
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+void Vector<ItemType, Allocator, GrowthPolicy>::realloc_emplace_back(std::true_type, Args&&... args) {
+    // args may refer to an element of this Vector, which the reallocation can unmap.
+    value_type value(std::forward<Args>(args)...);
 
-    this->memory.construct(this->memory.finish++, value);
+    this->reserve(this->next_capacity());
+
+    this->memory.construct(this->memory.finish++, std::move(value));
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+void Vector<ItemType, Allocator, GrowthPolicy>::realloc_emplace_back(std::false_type, Args&&... args) {
+    size_type capacity = this->next_capacity();
+    size_type size = this->size();
+
+    if (capacity > this->max_size())
+        throw std::length_error("std::length_error in Vector::emplace_back(Args&&...), size exceeds Vector::max_size()");
+
+    auto temp = this->memory_allocate(capacity);
+
+    // The new element is built before relocating, since args may refer to an element of this Vector.
+    try {
+        this->memory.construct(temp + size, std::forward<Args>(args)...);
+    } catch (...) {
+        this->memory_deallocate(temp, capacity);
+
+        throw;
+    }
+
+    try {
+        relocate(this->memory.start, this->memory.finish, temp, this->get_allocator());
+    } catch (...) {
+        this->memory.destroy(temp + size);
+        this->memory_deallocate(temp, capacity);
+
+        throw;
+    }
+
+    this->memory_deallocate(this->memory.start, this->capacity());
+
+    this->memory.start = temp;
+    this->memory.finish = temp + size + 1;
+    this->memory.storage_end = temp + capacity;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::push_back(const value_type& value) {
+    this->emplace_back(value);
 }
 
-template <typename ItemType, typename Allocator>
-void Vector<ItemType, Allocator>::pop_back() {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::push_back(value_type&& value) {
+    this->emplace_back(std::move(value));
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+typename Vector<ItemType, Allocator, GrowthPolicy>::reference Vector<ItemType, Allocator, GrowthPolicy>::emplace_back(Args&&... args) {
+    if (this->memory.finish == this->memory.storage_end)
+        this->realloc_emplace_back(expandable(), std::forward<Args>(args)...);
+    else
+        this->memory.construct(this->memory.finish++, std::forward<Args>(args)...);
+
+    return this->back();
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::pop_back() {
     this->memory.destroy(--this->memory.finish);
 }
 
-template <typename ItemType, typename Allocator>
-bool Vector<ItemType, Allocator>::operator==(const Vector<ItemType, Allocator>& other) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::resize(size_type size) {
+    this->resize(size, value_type());
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::resize(size_type size, const value_type& value) {
+    if (size <= this->size()) {
+        destroy(this->memory.start + size, this->memory.finish, this->get_allocator());
+
+        this->memory.finish = this->memory.start + size;
+
+        return;
+    }
+
+    // value may refer to an element of this Vector, which the reallocation would free.
+    value_type copy(value);
+
+    this->resize_reserve(size);
+
+    uninitialized_fill(this->memory.finish, size - this->size(), copy, this->get_allocator());
+
+    this->memory.finish = this->memory.start + size;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::resize(size_type size, default_init_t) {
+    if (size <= this->size()) {
+        destroy(this->memory.start + size, this->memory.finish, this->get_allocator());
+
+        this->memory.finish = this->memory.start + size;
+
+        return;
+    }
+
+    this->resize_reserve(size);
+
+    uninitialized_default_fill(this->memory.finish, size - this->size());
+
+    this->memory.finish = this->memory.start + size;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::resize_uninitialized(size_type size) {
+    static_assert(std::is_trivially_default_constructible<ItemType>::value && std::is_trivially_destructible<ItemType>::value,
+        "Vector::resize_uninitialized() needs trivially constructible items");
+
+    this->resize(size, default_init);
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+void Vector<ItemType, Allocator, GrowthPolicy>::swap(Vector<ItemType, Allocator, GrowthPolicy>& other) noexcept {
+    /*
+     * The allocators follow their blocks, an allocator may not be able to free a block
+     * of another one which compares unequal (HugePageAllocator with another threshold,
+     * ArenaAllocator of another arena). Moves and assignments go through here too.
+     */
+    std::swap(static_cast<Allocator&>(this->memory), static_cast<Allocator&>(other.memory));
+    std::swap(this->memory.start, other.memory.start);
+    std::swap(this->memory.finish, other.memory.finish);
+    std::swap(this->memory.storage_end, other.memory.storage_end);
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::operator==(const Vector<ItemType, Allocator, GrowthPolicy>& other) const {
     if (this->size() != other.size())
         return false;
 
-    for (auto it = this->begin(), it_other = other.begin(); it != this->end(); it++, it_other++)
-        if (*it != *it_other)
-            return false;
+    const ItemType* start = this->memory.start;
 
-    return true;
+    return VectorCompare<ItemType>().equal(start, start + this->size(), static_cast<const ItemType*>(other.memory.start));
 }
 
-template <typename ItemType, typename Allocator>
-bool Vector<ItemType, Allocator>::operator!=(const Vector<ItemType, Allocator>& other) {
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::operator!=(const Vector<ItemType, Allocator, GrowthPolicy>& other) const {
     return !(*this == other);
 }
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+int Vector<ItemType, Allocator, GrowthPolicy>::compare(const Vector<ItemType, Allocator, GrowthPolicy>& other) const {
+    const ItemType* start = this->memory.start;
+    const ItemType* other_start = other.memory.start;
+
+    return VectorCompare<ItemType>().execute(start, start + this->size(), other_start, other_start + other.size());
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::operator<(const Vector<ItemType, Allocator, GrowthPolicy>& other) const {
+    return this->compare(other) < 0;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::operator>(const Vector<ItemType, Allocator, GrowthPolicy>& other) const {
+    return this->compare(other) > 0;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::operator<=(const Vector<ItemType, Allocator, GrowthPolicy>& other) const {
+    return this->compare(other) <= 0;
+}
+
+template <typename ItemType, typename Allocator, typename GrowthPolicy>
+bool Vector<ItemType, Allocator, GrowthPolicy>::operator>=(const Vector<ItemType, Allocator, GrowthPolicy>& other) const {
+    return this->compare(other) >= 0;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file work_stealing_deque.h
+ *
+ * The Chase-Lev deque: a stack for its owner thread, which other threads may steal from.
+ */
+
+#pragma once
+
+// Contains
+//      CACHE_LINE_SIZE
+#include "mem_tools.h"
+
+// Used for std::atomic and std::atomic_thread_fence().
+#include <atomic>
+
+// Used for std::allocator.
+#include <memory>
+
+// Used for std::is_trivially_copyable.
+#include <type_traits>
+
+// Used for int64_t.
+#include <cstdint>
+
+/**
+ * @brief Default number of slots of a new WorkStealingDeque
+ */
+constexpr size_t WORK_STEALING_DEQUE_CAPACITY = 64;
+
+/**
+ * @tparam ItemType the type of item stored, trivially copyable (a task pointer or index, typically)
+ * @tparam Allocator the allocator of the circular arrays
+ */
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
+/**
+ * @class WorkStealingDeque
+ *
+ * @brief Lock-free deque whose owner pushes and pops at the bottom while thieves take from the top
+ *
+ * Follows Chase and Lev, "Dynamic Circular Work-Stealing Deque", with the memory orders of
+ * Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory
+ * Models": push() needs a release fence only and pop() one full fence, so on x86 only pop()
+ * and steal() pay for a locked instruction, while ARM gets the barriers it needs and no more.
+ * The owner and the thieves only contend for the last item, through a compare_exchange on top.
+ *
+ * Items live in a power of two circular array indexed by the ever-growing top and bottom. A
+ * full array is replaced by one twice as large; a thief may still be reading the old one, so
+ * replaced arrays are kept until the deque is destroyed (they add up to less than the live one).
+ *
+ * push(), pop(), top() may only be called by the owner thread, steal() and empty() by anyone.
+ * Slots are read while a thief may be racing for them, hence the trivially copyable items.
+ */
+class WorkStealingDeque {
+    private:
+        static_assert(std::is_trivially_copyable<ItemType>::value, "WorkStealingDeque needs trivially copyable items");
+
+        typedef std::atomic<ItemType> Slot;
+
+        struct Ring {
+            size_t capacity;
+            Slot* slots;
+
+            /** @brief The array this one replaced */
+            Ring* previous;
+
+            Slot& slot(int64_t index) {
+                return this->slots[static_cast<size_t>(index) & (this->capacity - 1)];
+            }
+        };
+
+        typedef typename Allocator::template rebind<Slot>::other    SlotAllocator;
+        typedef typename Allocator::template rebind<Ring>::other    RingAllocator;
+
+        /** @brief Next index to steal, advanced by thieves and by the owner taking the last item */
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top_index;
+
+        /** @brief Next index to push to, written by the owner only */
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom_index;
+
+        std::atomic<Ring*> ring;
+
+        SlotAllocator slot_allocator;
+        RingAllocator ring_allocator;
+
+        Ring* make_ring(size_t capacity, Ring* previous);
+
+        /** @brief Copies [top, bottom) to an array twice as large and publishes it */
+        Ring* grow(Ring* current, int64_t top, int64_t bottom);
+
+    public:
+        typedef ItemType    value_type;
+        typedef Allocator   allocator_type;
+
+        /**
+         * @brief Builds an empty deque of @b capacity slots, rounded up to a power of two
+         */
+        explicit WorkStealingDeque(size_t capacity = WORK_STEALING_DEQUE_CAPACITY, const allocator_type& allocator = allocator_type());
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        /** @brief Frees the arrays, no thread may be using the deque */
+        ~WorkStealingDeque();
+
+        /**
+         * @brief Checks if the deque holds no items, a snapshot when other threads are active
+         */
+        bool empty() const;
+
+        /**
+         * @brief Number of items, a snapshot when other threads are active
+         */
+        size_t size() const;
+
+        /**
+         * @brief Pushes @b value at the bottom, owner only
+         */
+        void push(const ItemType& value);
+
+        /**
+         * @brief Takes the most recently pushed item into @b value, owner only
+         *
+         * @return false if the deque was empty, or a thief took the last item
+         */
+        bool pop(ItemType& value);
+
+        /**
+         * @brief The item pop() would return, owner only, the deque must not be empty
+         *
+         * A thief may still take it when it is the last one.
+         */
+        ItemType top() const;
+
+        /**
+         * @brief Takes the oldest item into @b value, callable from any thread
+         *
+         * @return false if the deque was empty, or another thread won the race for the item
+         */
+        bool steal(ItemType& value);
+};
+
+template <typename ItemType, typename Allocator>
+WorkStealingDeque<ItemType, Allocator>::WorkStealingDeque(size_t capacity, const allocator_type& allocator) :
+    slot_allocator(allocator), ring_allocator(allocator) {
+    size_t rounded = 1;
+
+    while (rounded < capacity)
+        rounded *= 2;
+
+    this->top_index.store(0, std::memory_order_relaxed);
+    this->bottom_index.store(0, std::memory_order_relaxed);
+    this->ring.store(this->make_ring(rounded, nullptr), std::memory_order_relaxed);
+}
+
+template <typename ItemType, typename Allocator>
+WorkStealingDeque<ItemType, Allocator>::~WorkStealingDeque() {
+    for (Ring* current = this->ring.load(std::memory_order_relaxed); current != nullptr; ) {
+        Ring* previous = current->previous;
+
+        this->slot_allocator.deallocate(current->slots, current->capacity);
+        this->ring_allocator.deallocate(current, 1);
+
+        current = previous;
+    }
+}
+
+template <typename ItemType, typename Allocator>
+typename WorkStealingDeque<ItemType, Allocator>::Ring* WorkStealingDeque<ItemType, Allocator>::make_ring(size_t capacity, Ring* previous) {
+    Ring* fresh = this->ring_allocator.allocate(1);
+
+    try {
+        fresh->slots = this->slot_allocator.allocate(capacity);
+    } catch (...) {
+        this->ring_allocator.deallocate(fresh, 1);
+
+        throw;
+    }
+
+    // Slot is trivially constructible and destructible, its storage needs no construction.
+    fresh->capacity = capacity;
+    fresh->previous = previous;
+
+    return fresh;
+}
+
+template <typename ItemType, typename Allocator>
+typename WorkStealingDeque<ItemType, Allocator>::Ring* WorkStealingDeque<ItemType, Allocator>::grow(Ring* current, int64_t top, int64_t bottom) {
+    Ring* fresh = this->make_ring(2 * current->capacity, current);
+
+    for (int64_t index = top; index < bottom; index++)
+        fresh->slot(index).store(current->slot(index).load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    // Thieves reading the new array must see the copied slots.
+    this->ring.store(fresh, std::memory_order_release);
+
+    return fresh;
+}
+
+template <typename ItemType, typename Allocator>
+bool WorkStealingDeque<ItemType, Allocator>::empty() const {
+    return this->size() == 0;
+}
+
+template <typename ItemType, typename Allocator>
+size_t WorkStealingDeque<ItemType, Allocator>::size() const {
+    int64_t bottom = this->bottom_index.load(std::memory_order_relaxed);
+    int64_t top = this->top_index.load(std::memory_order_relaxed);
+
+    return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+}
+
+template <typename ItemType, typename Allocator>
+void WorkStealingDeque<ItemType, Allocator>::push(const ItemType& value) {
+    int64_t bottom = this->bottom_index.load(std::memory_order_relaxed);
+    int64_t top = this->top_index.load(std::memory_order_acquire);
+    Ring* current = this->ring.load(std::memory_order_relaxed);
+
+    if (bottom - top > static_cast<int64_t>(current->capacity) - 1)
+        current = this->grow(current, top, bottom);
+
+    current->slot(bottom).store(value, std::memory_order_relaxed);
+
+    // Publishes the slot to the thieves which will see the new bottom.
+    std::atomic_thread_fence(std::memory_order_release);
+
+    this->bottom_index.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <typename ItemType, typename Allocator>
+bool WorkStealingDeque<ItemType, Allocator>::pop(ItemType& value) {
+    int64_t bottom = this->bottom_index.load(std::memory_order_relaxed) - 1;
+    Ring* current = this->ring.load(std::memory_order_relaxed);
+
+    this->bottom_index.store(bottom, std::memory_order_relaxed);
+
+    // The claim on the bottom item has to be visible before top is read, or a thief and
+    // the owner could both take it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int64_t top = this->top_index.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        this->bottom_index.store(bottom + 1, std::memory_order_relaxed);
+
+        return false;
+    }
+
+    value = current->slot(bottom).load(std::memory_order_relaxed);
+
+    if (top < bottom)
+        return true;
+
+    // Last item: race the thieves for it through top.
+    bool won = this->top_index.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+
+    this->bottom_index.store(bottom + 1, std::memory_order_relaxed);
+
+    return won;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType WorkStealingDeque<ItemType, Allocator>::top() const {
+    int64_t bottom = this->bottom_index.load(std::memory_order_relaxed);
+
+    return this->ring.load(std::memory_order_relaxed)->slot(bottom - 1).load(std::memory_order_relaxed);
+}
+
+template <typename ItemType, typename Allocator>
+bool WorkStealingDeque<ItemType, Allocator>::steal(ItemType& value) {
+    int64_t top = this->top_index.load(std::memory_order_acquire);
+
+    // Pairs with the fence of pop(), see there.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int64_t bottom = this->bottom_index.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+        return false;
+
+    Ring* current = this->ring.load(std::memory_order_acquire);
+    ItemType item = current->slot(top).load(std::memory_order_relaxed);
+
+    if (!this->top_index.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    value = item;
+
+    return true;
+}
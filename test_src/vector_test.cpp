@@ -5,7 +5,40 @@
 // Used for range iterators
 #include <vector>
 
+// Used for the serialization tests.
+#include <sstream>
+#include <string>
+#include <cstring>
+
+// Used for std::istream_iterator in the single pass range tests.
+#include <iterator>
+
+// Used for std::runtime_error in the exception safety tests.
+#include <stdexcept>
+
 #include "vector.h"
+#include "small_vector.h"
+#include "pair.h"
+#include "arena.h"
+#include "tree.h"
+#include "key_tree.h"
+#include "map.h"
+#include "parallel.h"
+#include "sort.h"
+#include "simd_search.h"
+#include "mapped_vector.h"
+#include "serialize.h"
+#include "concurrent_vector.h"
+#include "stable_vector.h"
+#include "deque.h"
+#include "queue.h"
+#include "soa_vector.h"
+#include "concurrent_stack.h"
+#include "work_stealing_deque.h"
+#include "static_vector.h"
+#include "ring_queue.h"
+#include "mmap_allocator.h"
+#include "stack.h"
 
 class Dummy {
     private:
@@ -38,6 +71,44 @@ std::ostream& operator<<(std::ostream& stream, const Dummy& dummy) {
     return stream;
 }
 
+// Counts how many times any instance has been copied.
+class CopyCounter {
+    private:
+        int id = 0;
+
+    public:
+        static size_t copies;
+
+        CopyCounter() : id(0) {}
+        CopyCounter(int new_id) : id(new_id) {}
+
+        CopyCounter(const CopyCounter &other) : id(other.id) {
+            copies++;
+        }
+
+        CopyCounter(CopyCounter &&other) noexcept : id(other.id) {}
+
+        CopyCounter& operator=(const CopyCounter &other) {
+            this->id = other.id;
+
+            copies++;
+
+            return *this;
+        }
+
+        CopyCounter& operator=(CopyCounter &&other) noexcept {
+            this->id = other.id;
+
+            return *this;
+        }
+
+        int get_id() const {
+            return this->id;
+        }
+};
+
+size_t CopyCounter::copies = 0;
+
 template <typename ItemType>
 void default_constructor_test() {
     std::cout << "Vector() -> ";
@@ -145,6 +216,7 @@ void range_constructor_test() {
     Vector<ItemType> vec_(vector.cbegin(), vector.cend());
 
     assert(vec_.size() == vector.size());
+    assert(vec_.capacity() == vector.size());
 
     // Assuming that std::vector has the same capacity() grow scale.
     //
@@ -212,6 +284,38 @@ void copy_constructor_test() {
     std::cout << "SUCCESS" << std::endl;
 }
 
+template <typename ItemType>
+void move_constructor_test() {
+    std::cout << "Vector(Vector&& other) -> ";
+
+    Vector<ItemType> vec;
+
+    for (size_t index = 0; index < 100; index++)
+        vec.push_back(ItemType(index));
+
+    size_t capacity = vec.capacity();
+
+    Vector<ItemType> moved(std::move(vec));
+
+    assert(moved.size() == 100);
+    assert(moved.capacity() == capacity);
+
+    for (size_t index = 0; index < moved.size(); index++)
+        assert(moved[index] == ItemType(index));
+
+    assert(vec.size() == 0);
+    assert(vec.capacity() == 0);
+    assert(vec.begin() == vec.end());
+
+    Vector<ItemType> vec_;
+
+    Vector<ItemType> moved_(std::move(vec_));
+
+    assert(moved_.size() == 0 && moved_.capacity() == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
 template <typename ItemType>
 void constructor_tests() {
     default_constructor_test<ItemType>();
@@ -219,6 +323,7 @@ void constructor_tests() {
     count_constructor_test<ItemType>();
     range_constructor_test<ItemType>();
     copy_constructor_test<ItemType>();
+    move_constructor_test<ItemType>();
 
     std::cout << std::endl;
 }
@@ -267,6 +372,36 @@ void copy_assignment_operator_test() {
     std::cout << std::endl;
 }
 
+template <typename ItemType>
+void move_assignment_operator_test() {
+    std::cout << "Vector::operator=(Vector&& other) -> ";
+
+    Vector<ItemType> vec;
+
+    vec.push_back(ItemType(10));
+    vec.push_back(ItemType(20));
+    vec.push_back(ItemType(30));
+
+    Vector<ItemType> moved;
+
+    moved.push_back(ItemType(100));
+
+    moved = std::move(vec);
+
+    assert(moved.size() == 3);
+    assert(moved[0] == ItemType(10) && moved[1] == ItemType(20) && moved[2] == ItemType(30));
+
+    assert(vec.size() == 0);
+    assert(vec.begin() == vec.end());
+
+    vec = std::move(moved);
+
+    assert(vec.size() == 3 && moved.size() == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+    std::cout << std::endl;
+}
+
 template <typename ItemType>
 void count_and_value_assign_test() {
     std::cout << "Vector::assign(size_t count, const ItemType& value) -> ";
@@ -283,7 +418,7 @@ void count_and_value_assign_test() {
     vec.assign(size_t(10), item);
 
     assert(vec.size() == 10);
-    assert(vec.capacity() > 10);
+    assert(vec.capacity() == 10);
 
     for (auto it = vec.cbegin(); it != vec.cend(); it++)
         assert(*it == item);
@@ -318,6 +453,7 @@ void range_assign_test() {
     vec.assign(vector.cbegin(), vector.cend());
 
     assert(vec.size() == vector.size() && vec.size() == 3);
+    assert(vec.capacity() == 3);
 
     // Assuming that std::vector::capacity() has the same scaling
     //
@@ -328,6 +464,13 @@ void range_assign_test() {
     for (auto it_ = vec.cbegin(), it = vector.cbegin(); it_ != vec.cend(), it != vector.cend(); it_++, it++)
         assert(*it_ == *it);
 
+    vector.pop_back();
+
+    vec.assign(vector.cbegin(), vector.cend());
+
+    assert(vec.size() == 2 && vec.capacity() == 3);
+    assert(vec[0] == vector[0] && vec[1] == vector[1]);
+
     std::cout << "SUCCESS" << std::endl;
 }
 
@@ -561,11 +704,11 @@ void element_access_tests() {
 
 template <typename ItemType>
 void iterator_default_constructor_test() {
-    std::cout << "Vector::Iterator() -> ";
+    std::cout << "Vector::iterator() -> ";
 
-    typename Vector<ItemType>::Iterator it;
+    typename Vector<ItemType>::iterator it;
 
-    typename Vector<ItemType>::Iterator it_;
+    typename Vector<ItemType>::iterator it_;
 
     assert(it == it_);
 
@@ -574,10 +717,10 @@ void iterator_default_constructor_test() {
 
 template <typename ItemType>
 void iterator_copy_constructor_test() {
-    std::cout << "Vector::Iterator(const Iterator& other) -> ";
+    std::cout << "Vector::iterator(const Iterator& other) -> ";
 
-    typename Vector<ItemType>::Iterator it;
-    typename Vector<ItemType>::Iterator copy(it);
+    typename Vector<ItemType>::iterator it;
+    typename Vector<ItemType>::iterator copy(it);
 
     assert(it == copy);
 
@@ -594,7 +737,7 @@ void iterator_constructor_tests() {
 
 template <typename ItemType>
 void iterator_copy_assignment_operator_test() {
-    std::cout << "Vector::Iterator::operator=(const Iterator& other) -> ";
+    std::cout << "Vector::iterator::operator=(const Iterator& other) -> ";
 
     Vector<ItemType> vec;
 
@@ -604,7 +747,7 @@ void iterator_copy_assignment_operator_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::Iterator it = vec.begin();
+    typename Vector<ItemType>::iterator it = vec.begin();
 
     assert(it == vec.begin());
     assert(*it == vec[0]);
@@ -616,7 +759,7 @@ void iterator_copy_assignment_operator_test() {
 
 template <typename ItemType>
 void iterator_prefix_increment_test() {
-    std::cout << "Vector::Iterator::operator++(int) -> ";
+    std::cout << "Vector::iterator::operator++(int) -> ";
 
     Vector<ItemType> vec;
 
@@ -626,7 +769,7 @@ void iterator_prefix_increment_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::Iterator it = vec.begin();
+    typename Vector<ItemType>::iterator it = vec.begin();
 
     for (size_t index = 0; it != vec.end(); ++it, index++)
         assert(*it == vec[index]);
@@ -640,7 +783,7 @@ void iterator_prefix_increment_test() {
 
 template <typename ItemType>
 void iterator_postfix_increment_test() {
-    std::cout << "Vector::Iterator::operator++() -> ";
+    std::cout << "Vector::iterator::operator++() -> ";
 
     ItemType item(10);
     Vector<ItemType> vec;
@@ -651,7 +794,7 @@ void iterator_postfix_increment_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::Iterator it = vec.begin();
+    typename Vector<ItemType>::iterator it = vec.begin();
 
     for (size_t index = 0; it != vec.end(); it++, index++)
         assert(*it == vec[index]);
@@ -665,7 +808,7 @@ void iterator_postfix_increment_test() {
 
 template <typename ItemType>
 void iterator_increment_and_assign_test() {
-    std::cout << "Vector::Iterator::operator+=(ptrdiff_t x) -> ";
+    std::cout << "Vector::iterator::operator+=(ptrdiff_t x) -> ";
 
     ItemType item(10);
     Vector<ItemType> vec;
@@ -676,7 +819,7 @@ void iterator_increment_and_assign_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::Iterator it = vec.begin();
+    typename Vector<ItemType>::iterator it = vec.begin();
 
     for (size_t index = 0; it != vec.end(); it += 1, index++)
         assert(*it == vec[index]);
@@ -709,7 +852,7 @@ void iterator_increment_tests() {
 
 template <typename ItemType>
 void iterator_prefix_decrement_test() {
-    std::cout << "Vector::Iterator::operator--(int) -> ";
+    std::cout << "Vector::iterator::operator--(int) -> ";
 
     Vector<ItemType> vec;
 
@@ -719,7 +862,7 @@ void iterator_prefix_decrement_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::Iterator it = vec.end();
+    typename Vector<ItemType>::iterator it = vec.end();
 
     --it;
     for (size_t index = vec.size() - 1; it != vec.begin(); --it, --index)
@@ -734,7 +877,7 @@ void iterator_prefix_decrement_test() {
 
 template <typename ItemType>
 void iterator_postfix_decrement_test() {
-    std::cout << "Vector::Iterator::operator--() -> ";
+    std::cout << "Vector::iterator::operator--() -> ";
 
     Vector<ItemType> vec;
 
@@ -744,7 +887,7 @@ void iterator_postfix_decrement_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::Iterator it = vec.end();
+    typename Vector<ItemType>::iterator it = vec.end();
 
     it--;
     for (size_t index = vec.size() - 1; it != vec.begin(); it--, index--)
@@ -759,7 +902,7 @@ void iterator_postfix_decrement_test() {
 
 template <typename ItemType>
 void iterator_decrement_and_assign_test() {
-    std::cout << "Vector::Iterator::operator-=(ptrdiff_t x) -> ";
+    std::cout << "Vector::iterator::operator-=(ptrdiff_t x) -> ";
 
     Vector<ItemType> vec;
 
@@ -769,7 +912,7 @@ void iterator_decrement_and_assign_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::Iterator it = vec.end();
+    typename Vector<ItemType>::iterator it = vec.end();
 
     it -= 1;
     for (size_t index = vec.size() - 1; it != vec.begin(); it -= 1, index -= 1)
@@ -802,7 +945,7 @@ void iterator_decrement_tests() {
 
 template <typename ItemType>
 void iterator_substraction_test() {
-    std::cout << "Vector::Iterator::operator-(const Iterator &iterator) const ->";
+    std::cout << "Vector::iterator::operator-(const Iterator &iterator) const ->";
 
     Vector<ItemType> vec;
 
@@ -830,7 +973,7 @@ void iterator_substraction_test() {
 
 // Run only for Dummy class.
 void dummy_iterator_return_pointer_operator_test() {
-    std::cout << "Vector::Iterator::operator->() -> ";
+    std::cout << "Vector::iterator::operator->() -> ";
 
     Vector<Dummy> vec;
 
@@ -849,7 +992,7 @@ void dummy_iterator_return_pointer_operator_test() {
 
 template <typename ItemType>
 void iterator_return_reference_operator_test() {
-    std::cout << "Vector::Iterator::operator*() -> ";
+    std::cout << "Vector::iterator::operator*() -> ";
 
     Vector<ItemType> vec;
 
@@ -868,7 +1011,7 @@ void iterator_return_reference_operator_test() {
 
 template <typename ItemType>
 void iterator_offset_dereference_operator_test() {
-    std::cout << "Vector::Iterator::operator[](ptrdiff_t index) const -> ";
+    std::cout << "Vector::iterator::operator[](ptrdiff_t index) const -> ";
 
     Vector<ItemType> vec;
 
@@ -908,10 +1051,10 @@ void iterator_access_tests(bool is_dummy) {
 
 template <typename ItemType>
 void iterator_equal_test() {
-    std::cout << "Vector::Iterator::operator==(const Iterator &iterator) const -> ";
+    std::cout << "Vector::iterator::operator==(const Iterator &iterator) const -> ";
 
-    typename Vector<ItemType>::Iterator it;
-    typename Vector<ItemType>::Iterator it_;
+    typename Vector<ItemType>::iterator it;
+    typename Vector<ItemType>::iterator it_;
 
     assert(it == it_);
 
@@ -937,10 +1080,10 @@ void iterator_equal_test() {
 
 template <typename ItemType>
 void iterator_not_equal_test() {
-    std::cout << "Vector::Iterator::operator!=(const Iterator &iterator) const -> ";
+    std::cout << "Vector::iterator::operator!=(const Iterator &iterator) const -> ";
 
-    typename Vector<ItemType>::Iterator it;
-    typename Vector<ItemType>::Iterator it_;
+    typename Vector<ItemType>::iterator it;
+    typename Vector<ItemType>::iterator it_;
 
     assert(!(it != it_));
 
@@ -968,10 +1111,10 @@ void iterator_not_equal_test() {
 
 template <typename ItemType>
 void iterator_less_test() {
-    std::cout << "Vector::Iterator::operator<(const Iterator &iterator) const -> ";
+    std::cout << "Vector::iterator::operator<(const Iterator &iterator) const -> ";
 
-    typename Vector<ItemType>::Iterator it;
-    typename Vector<ItemType>::Iterator it_;
+    typename Vector<ItemType>::iterator it;
+    typename Vector<ItemType>::iterator it_;
 
     assert(!(it < it_) && !(it_ < it));
 
@@ -996,10 +1139,10 @@ void iterator_less_test() {
 
 template <typename ItemType>
 void iterator_greater_test() {
-    std::cout << "Vector::Iterator::operator>(const Iterator &iterator) const -> ";
+    std::cout << "Vector::iterator::operator>(const Iterator &iterator) const -> ";
 
-    typename Vector<ItemType>::Iterator it;
-    typename Vector<ItemType>::Iterator it_;
+    typename Vector<ItemType>::iterator it;
+    typename Vector<ItemType>::iterator it_;
 
     assert(!(it > it_) && !(it_ > it));
 
@@ -1024,10 +1167,10 @@ void iterator_greater_test() {
 
 template <typename ItemType>
 void iterator_less_or_equal_test() {
-    std::cout << "Vector::Iterator::operator<=(const Iterator &iterator) const -> ";
+    std::cout << "Vector::iterator::operator<=(const Iterator &iterator) const -> ";
 
-    typename Vector<ItemType>::Iterator it;
-    typename Vector<ItemType>::Iterator it_;
+    typename Vector<ItemType>::iterator it;
+    typename Vector<ItemType>::iterator it_;
 
     assert(it <= it_ && it_ <= it);
 
@@ -1052,10 +1195,10 @@ void iterator_less_or_equal_test() {
 
 template <typename ItemType>
 void iterator_greater_or_equal_test() {
-    std::cout << "Vector::Iterator::operator>=(const Iterator &iterator) const -> ";
+    std::cout << "Vector::iterator::operator>=(const Iterator &iterator) const -> ";
 
-    typename Vector<ItemType>::Iterator it;
-    typename Vector<ItemType>::Iterator it_;
+    typename Vector<ItemType>::iterator it;
+    typename Vector<ItemType>::iterator it_;
 
     assert(it >= it_ && it_ >= it);
 
@@ -1109,11 +1252,11 @@ void iterator_test(bool is_dummy) {
 
 template <typename ItemType>
 void const_iterator_default_constructor_test() {
-    std::cout << "Vector::ConstIterator() -> ";
+    std::cout << "Vector::const_iterator() -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
+    typename Vector<ItemType>::const_iterator it;
 
-    typename Vector<ItemType>::ConstIterator it_;
+    typename Vector<ItemType>::const_iterator it_;
 
     assert(it == it_);
 
@@ -1122,10 +1265,10 @@ void const_iterator_default_constructor_test() {
 
 template <typename ItemType>
 void const_iterator_copy_constructor_test() {
-    std::cout << "Vector::ConstIterator(const ConstIterator& other) -> ";
+    std::cout << "Vector::const_iterator(const ConstIterator& other) -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
-    typename Vector<ItemType>::ConstIterator copy(it);
+    typename Vector<ItemType>::const_iterator it;
+    typename Vector<ItemType>::const_iterator copy(it);
 
     assert(it == copy);
 
@@ -1142,7 +1285,7 @@ void const_iterator_constructor_tests() {
 
 template <typename ItemType>
 void const_iterator_copy_assignment_operator_test() {
-    std::cout << "Vector::ConstIterator::operator=(const ConstIterator& other) -> ";
+    std::cout << "Vector::const_iterator::operator=(const ConstIterator& other) -> ";
 
     Vector<ItemType> vec;
 
@@ -1152,7 +1295,7 @@ void const_iterator_copy_assignment_operator_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::ConstIterator it = vec.cbegin();
+    typename Vector<ItemType>::const_iterator it = vec.cbegin();
 
     assert(it == vec.cbegin());
     assert(*it == vec[0]);
@@ -1164,7 +1307,7 @@ void const_iterator_copy_assignment_operator_test() {
 
 template <typename ItemType>
 void const_iterator_prefix_increment_test() {
-    std::cout << "Vector::ConstIterator::operator++(int) -> ";
+    std::cout << "Vector::const_iterator::operator++(int) -> ";
 
     Vector<ItemType> vec;
 
@@ -1174,7 +1317,7 @@ void const_iterator_prefix_increment_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::ConstIterator it = vec.cbegin();
+    typename Vector<ItemType>::const_iterator it = vec.cbegin();
 
     for (size_t index = 0; it != vec.cend(); ++it, index++)
         assert(*it == vec[index]);
@@ -1188,7 +1331,7 @@ void const_iterator_prefix_increment_test() {
 
 template <typename ItemType>
 void const_iterator_postfix_increment_test() {
-    std::cout << "Vector::ConstIterator::operator++() -> ";
+    std::cout << "Vector::const_iterator::operator++() -> ";
 
     Vector<ItemType> vec;
 
@@ -1198,7 +1341,7 @@ void const_iterator_postfix_increment_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::ConstIterator it = vec.cbegin();
+    typename Vector<ItemType>::const_iterator it = vec.cbegin();
 
     for (size_t index = 0; it != vec.cend(); it++, index++)
         assert(*it == vec[index]);
@@ -1212,7 +1355,7 @@ void const_iterator_postfix_increment_test() {
 
 template <typename ItemType>
 void const_iterator_increment_and_assign_test() {
-    std::cout << "Vector::Iterator::operator+=(ptrdiff_t x) -> ";
+    std::cout << "Vector::iterator::operator+=(ptrdiff_t x) -> ";
 
     Vector<ItemType> vec;
 
@@ -1222,7 +1365,7 @@ void const_iterator_increment_and_assign_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::ConstIterator it = vec.cbegin();
+    typename Vector<ItemType>::const_iterator it = vec.cbegin();
 
     for (size_t index = 0; it != vec.cend(); it += 1, index++)
         assert(*it == vec[index]);
@@ -1255,7 +1398,7 @@ void const_iterator_increment_tests() {
 
 template <typename ItemType>
 void const_iterator_prefix_decrement_test() {
-    std::cout << "Vector::ConstIterator::operator--(int) -> ";
+    std::cout << "Vector::const_iterator::operator--(int) -> ";
 
     Vector<ItemType> vec;
 
@@ -1265,7 +1408,7 @@ void const_iterator_prefix_decrement_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::ConstIterator it = vec.cend();
+    typename Vector<ItemType>::const_iterator it = vec.cend();
 
     --it;
     for (size_t index = vec.size() - 1; it != vec.cbegin(); --it, --index)
@@ -1280,7 +1423,7 @@ void const_iterator_prefix_decrement_test() {
 
 template <typename ItemType>
 void const_iterator_postfix_decrement_test() {
-    std::cout << "Vector::ConstIterator::operator--() -> ";
+    std::cout << "Vector::const_iterator::operator--() -> ";
 
     Vector<ItemType> vec;
 
@@ -1290,7 +1433,7 @@ void const_iterator_postfix_decrement_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::ConstIterator it = vec.cend();
+    typename Vector<ItemType>::const_iterator it = vec.cend();
 
     it--;
     for (size_t index = vec.size() - 1; it != vec.cbegin(); it--, index--)
@@ -1305,7 +1448,7 @@ void const_iterator_postfix_decrement_test() {
 
 template <typename ItemType>
 void const_iterator_decrement_and_assign_test() {
-    std::cout << "Vector::ConstIterator::operator-=(ptrdiff_t x) -> ";
+    std::cout << "Vector::const_iterator::operator-=(ptrdiff_t x) -> ";
 
     Vector<ItemType> vec;
 
@@ -1315,7 +1458,7 @@ void const_iterator_decrement_and_assign_test() {
     vec.push_back(ItemType(40));
     vec.push_back(ItemType(50));
 
-    typename Vector<ItemType>::ConstIterator it = vec.cend();
+    typename Vector<ItemType>::const_iterator it = vec.cend();
 
     it -= 1;
     for (size_t index = vec.size() - 1; it != vec.cbegin(); it -= 1, index -= 1)
@@ -1348,7 +1491,7 @@ void const_iterator_decrement_tests() {
 
 template <typename ItemType>
 void const_iterator_substraction_test() {
-    std::cout << "Vector::ConstIterator::operator-(const ConstIterator &iterator) const ->";
+    std::cout << "Vector::const_iterator::operator-(const ConstIterator &iterator) const ->";
 
     Vector<ItemType> vec;
 
@@ -1376,7 +1519,7 @@ void const_iterator_substraction_test() {
 
 // Run only for Dummy class.
 void const_dummy_iterator_return_pointer_operator_test() {
-    std::cout << "Vector::ConstIterator::operator->() -> ";
+    std::cout << "Vector::const_iterator::operator->() -> ";
 
     Vector<Dummy> vec;
 
@@ -1395,7 +1538,7 @@ void const_dummy_iterator_return_pointer_operator_test() {
 
 template <typename ItemType>
 void const_iterator_return_reference_operator_test() {
-    std::cout << "Vector::ConstIterator::operator*() -> ";
+    std::cout << "Vector::const_iterator::operator*() -> ";
 
     Vector<ItemType> vec;
 
@@ -1414,7 +1557,7 @@ void const_iterator_return_reference_operator_test() {
 
 template <typename ItemType>
 void const_iterator_offset_dereference_operator_test() {
-    std::cout << "Vector::Iterator::operator[](ptrdiff_t index) const -> ";
+    std::cout << "Vector::iterator::operator[](ptrdiff_t index) const -> ";
 
     Vector<ItemType> vec;
 
@@ -1454,10 +1597,10 @@ void const_iterator_access_tests(bool is_dummy) {
 
 template <typename ItemType>
 void const_iterator_equal_test() {
-    std::cout << "Vector::ConstIterator::operator==(const ConstIterator &iterator) const -> ";
+    std::cout << "Vector::const_iterator::operator==(const ConstIterator &iterator) const -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
-    typename Vector<ItemType>::ConstIterator it_;
+    typename Vector<ItemType>::const_iterator it;
+    typename Vector<ItemType>::const_iterator it_;
 
     assert(it == it_);
 
@@ -1483,10 +1626,10 @@ void const_iterator_equal_test() {
 
 template <typename ItemType>
 void const_iterator_not_equal_test() {
-    std::cout << "Vector::ConstIterator::operator!=(const ConstIterator &iterator) const -> ";
+    std::cout << "Vector::const_iterator::operator!=(const ConstIterator &iterator) const -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
-    typename Vector<ItemType>::ConstIterator it_;
+    typename Vector<ItemType>::const_iterator it;
+    typename Vector<ItemType>::const_iterator it_;
 
     assert(!(it != it_));
 
@@ -1514,10 +1657,10 @@ void const_iterator_not_equal_test() {
 
 template <typename ItemType>
 void const_iterator_less_test() {
-    std::cout << "Vector::ConstIterator::operator<(const ConstIterator &iterator) const -> ";
+    std::cout << "Vector::const_iterator::operator<(const ConstIterator &iterator) const -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
-    typename Vector<ItemType>::ConstIterator it_;
+    typename Vector<ItemType>::const_iterator it;
+    typename Vector<ItemType>::const_iterator it_;
 
     assert(!(it < it_) && !(it_ < it));
 
@@ -1542,10 +1685,10 @@ void const_iterator_less_test() {
 
 template <typename ItemType>
 void const_iterator_greater_test() {
-    std::cout << "Vector::ConstIterator::operator>(const ConstIterator &iterator) const -> ";
+    std::cout << "Vector::const_iterator::operator>(const ConstIterator &iterator) const -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
-    typename Vector<ItemType>::ConstIterator it_;
+    typename Vector<ItemType>::const_iterator it;
+    typename Vector<ItemType>::const_iterator it_;
 
     assert(!(it > it_) && !(it_ > it));
 
@@ -1570,10 +1713,10 @@ void const_iterator_greater_test() {
 
 template <typename ItemType>
 void const_iterator_less_or_equal_test() {
-    std::cout << "Vector::ConstIterator::operator<=(const ConstIterator &iterator) const -> ";
+    std::cout << "Vector::const_iterator::operator<=(const ConstIterator &iterator) const -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
-    typename Vector<ItemType>::ConstIterator it_;
+    typename Vector<ItemType>::const_iterator it;
+    typename Vector<ItemType>::const_iterator it_;
 
     assert(it <= it_ && it_ <= it);
 
@@ -1598,10 +1741,10 @@ void const_iterator_less_or_equal_test() {
 
 template <typename ItemType>
 void const_iterator_greater_or_equal_test() {
-    std::cout << "Vector::ConstIterator::operator>=(const Iterator &iterator) const -> ";
+    std::cout << "Vector::const_iterator::operator>=(const Iterator &iterator) const -> ";
 
-    typename Vector<ItemType>::ConstIterator it;
-    typename Vector<ItemType>::ConstIterator it_;
+    typename Vector<ItemType>::const_iterator it;
+    typename Vector<ItemType>::const_iterator it_;
 
     assert(it >= it_ && it_ >= it);
 
@@ -1667,7 +1810,7 @@ void begin_test() {
     auto it = vec.begin();
 
     assert(vec.begin() == vec.end());
-    assert(vec.begin() == typename Vector<ItemType>::Iterator());
+    assert(vec.begin() == typename Vector<ItemType>::iterator());
 
     vec.push_back(10);
     vec.push_back(20);
@@ -1679,7 +1822,7 @@ void begin_test() {
     it = vec.begin();
 
     assert(vec.begin() != vec.end());
-    assert(vec.begin() != typename Vector<ItemType>::Iterator());
+    assert(vec.begin() != typename Vector<ItemType>::iterator());
 
     assert(*vec.begin() == vec[0]);
     assert(vec.begin() == vec.end() - vec.size());
@@ -1695,7 +1838,7 @@ void cbegin_test() {
     auto it = vec.cbegin();
 
     assert(vec.cbegin() == vec.cend());
-    assert(vec.cbegin() == typename Vector<ItemType>::ConstIterator());
+    assert(vec.cbegin() == typename Vector<ItemType>::const_iterator());
 
     vec.push_back(10);
     vec.push_back(20);
@@ -1707,7 +1850,7 @@ void cbegin_test() {
     it = vec.cbegin();
 
     assert(vec.cbegin() != vec.cend());
-    assert(vec.cbegin() != typename Vector<ItemType>::ConstIterator());
+    assert(vec.cbegin() != typename Vector<ItemType>::const_iterator());
 
     assert(*vec.cbegin() == vec[0]);
     assert(vec.cbegin() == vec.cend() - vec.size());
@@ -1729,7 +1872,7 @@ void end_test() {
     auto it = vec.end();
 
     assert(vec.end() == vec.begin());
-    assert(vec.end() == typename Vector<ItemType>::Iterator());
+    assert(vec.end() == typename Vector<ItemType>::iterator());
 
     vec.push_back(10);
     vec.push_back(20);
@@ -1741,7 +1884,7 @@ void end_test() {
     it = vec.end();
 
     assert(vec.end() != vec.begin());
-    assert(vec.end() != typename Vector<ItemType>::Iterator());
+    assert(vec.end() != typename Vector<ItemType>::iterator());
 
     assert(*(--vec.end()) == vec[vec.size() - 1]);
     assert(vec.end() == vec.begin() + vec.size());
@@ -1757,7 +1900,7 @@ void cend_test() {
     auto it = vec.cend();
 
     assert(vec.cend() == vec.cbegin());
-    assert(vec.cend() == typename Vector<ItemType>::ConstIterator());
+    assert(vec.cend() == typename Vector<ItemType>::const_iterator());
 
     vec.push_back(10);
     vec.push_back(20);
@@ -1769,7 +1912,7 @@ void cend_test() {
     it = vec.cend();
 
     assert(vec.cend() != vec.cbegin());
-    assert(vec.cend() != typename Vector<ItemType>::ConstIterator());
+    assert(vec.cend() != typename Vector<ItemType>::const_iterator());
 
     assert(*(--vec.cend()) == vec[vec.size() - 1]);
     assert(vec.cend() == vec.cbegin() + vec.size());
@@ -1913,12 +2056,96 @@ void reserve_test() {
     std::cout << "SUCCESS" << std::endl;
 }
 
+template <typename ItemType>
+void reserve_exact_test() {
+    std::cout << "Vector::reserve_exact(size_t capacity) -> ";
+
+    Vector<ItemType, std::allocator<ItemType>, SizeClassGrowth> vec;
+
+    vec.reserve_exact(3);
+
+    assert(vec.capacity() == 3);
+
+    vec.reserve_exact(2);
+
+    assert(vec.capacity() == 3);
+
+    vec.reserve(5);
+
+    assert(vec.capacity() == SizeClassGrowth::round(5, sizeof(ItemType)));
+    assert(vec.capacity() * sizeof(ItemType) % 16 == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void shrink_to_fit_test() {
+    std::cout << "Vector::shrink_to_fit() -> ";
+
+    Vector<ItemType> vec;
+
+    for (size_t index = 0; index < 100; index++)
+        vec.push_back(ItemType(index));
+
+    vec.shrink_to_fit();
+
+    assert(vec.size() == 100 && vec.capacity() == 100);
+
+    for (size_t index = 0; index < 100; index++)
+        assert(vec[index] == ItemType(index));
+
+    vec.clear();
+    vec.shrink_to_fit();
+
+    assert(vec.size() == 0 && vec.capacity() == 0);
+
+    vec.push_back(ItemType(10));
+
+    assert(vec.size() == 1 && vec[0] == ItemType(10));
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void growth_policy_test() {
+    std::cout << "Vector growth policies -> ";
+
+    Vector<ItemType, std::allocator<ItemType>, OneAndHalfGrowth> vec;
+
+    size_t expected[] = { 1, 2, 3, 4, 6, 9, 13, 19, 28, 42, 63, 94, 141 };
+    size_t step = 0;
+
+    for (size_t index = 0; index < 100; index++) {
+        vec.push_back(ItemType(index));
+
+        if (vec.capacity() != expected[step])
+            step++;
+
+        assert(vec.capacity() == expected[step]);
+    }
+
+    Vector<ItemType, std::allocator<ItemType>, PageGrowth<>> vec_;
+
+    for (size_t index = 0; index < 5000; index++)
+        vec_.push_back(ItemType(index));
+
+    assert(vec_.capacity() * sizeof(ItemType) % 4096 == 0);
+
+    for (size_t index = 0; index < 5000; index++)
+        assert(vec_[index] == ItemType(index));
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
 template <typename ItemType>
 void capacity_tests() {
     empty_test<ItemType>();
     size_test<ItemType>();
     capacity_test<ItemType>();
     reserve_test<ItemType>();
+    reserve_exact_test<ItemType>();
+    shrink_to_fit_test<ItemType>();
+    growth_policy_test<ItemType>();
 }
 
 template <typename ItemType>
@@ -2131,10 +2358,35 @@ void erase_range() {
     std::cout << "SUCCESS" << std::endl;
 }
 
+template <typename ItemType>
+void erase_capacity_test() {
+    std::cout << "Vector::erase() keeps the storage -> ";
+
+    Vector<ItemType> vec;
+
+    for (size_t index = 0; index < 64; index++)
+        vec.push_back(ItemType(index));
+
+    auto data = &vec[0];
+
+    vec.erase(vec.begin() + 10);
+    vec.erase(vec.begin() + 20, vec.begin() + 40);
+
+    assert(vec.size() == 43);
+    assert(vec.capacity() == 64);
+    assert(&vec[0] == data);
+
+    assert(vec[9] == ItemType(9) && vec[10] == ItemType(11));
+    assert(vec[19] == ItemType(20) && vec[20] == ItemType(41));
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
 template <typename ItemType>
 void erase_tests() {
     erase_test<ItemType>();
     erase_range<ItemType>();
+    erase_capacity_test<ItemType>();
 
     std::cout << std::endl;
 }
@@ -2168,181 +2420,1283 @@ void push_back_test() {
 }
 
 template <typename ItemType>
-void pop_back_test() {
-    std::cout << "Vector::pop_back() -> ";
+void emplace_back_test() {
+    std::cout << "Vector::emplace_back(Args&&... args) -> ";
 
     Vector<ItemType> vec;
 
-    vec.push_back(ItemType(10));
+    auto& item = vec.emplace_back(10);
 
-    vec.pop_back();
+    assert(item == ItemType(10));
+    assert(vec.size() == 1);
 
-    assert(vec.empty() == true);
-    assert(vec.size() == 0);
+    for (size_t index = 1; index < 100; index++)
+        vec.emplace_back(index);
 
-    for (size_t index = 0; index < 100; index++)
-        vec.push_back(ItemType(index));
+    for (size_t index = 1; index < 100; index++)
+        assert(vec[index] == ItemType(index));
 
-    size_t count = 100;
-    while (count--) {
-        vec.pop_back();
+    // The argument aliases an element which is relocated by the growth.
+    while (vec.size() != vec.capacity())
+        vec.emplace_back(vec.back());
 
-        assert(vec.size() == count);
-    }
+    vec.emplace_back(vec[0]);
+
+    assert(vec.back() == ItemType(10));
 
     std::cout << "SUCCESS" << std::endl;
 }
 
 template <typename ItemType>
-void resize_test() {
-    std::cout << "Vector::resize(size_t count, const ItemType& value) -> ";
+void emplace_test() {
+    std::cout << "Vector::emplace(Iterator position, Args&&... args) -> ";
 
     Vector<ItemType> vec;
 
-    vec.resize(100, ItemType(10));
+    auto pos = vec.emplace(vec.begin(), 20);
 
-    assert(vec.size() == 100);
-    assert(vec.capacity() > 100);
+    assert(*pos == ItemType(20));
 
-    for (auto it = vec.cbegin(); it != vec.cend(); it++)
-        assert(*it == ItemType(10));
+    pos = vec.emplace(vec.begin(), 10);
 
-    vec.resize(10, ItemType(10));
+    assert(*pos == ItemType(10));
 
-    assert(vec.size() == 10);
+    pos = vec.emplace(vec.end(), 40);
 
-    for (auto it = vec.cbegin(); it != vec.cend(); it++)
-        assert(*it == ItemType(10));
+    assert(*pos == ItemType(40));
 
-    std::cout << "SUCCESS" << std::endl;
-}
+    pos = vec.emplace(vec.begin() + 2, 30);
 
-template <typename ItemType>
-void swap_test() {
-    std::cout << "Vector::swap(const Vector& other) -> ";
+    assert(*pos == ItemType(30));
+    assert(vec.size() == 4);
 
-    Vector<ItemType> vec;
-    
-    vec.push_back(ItemType(10));
-    vec.push_back(ItemType(20));
-    vec.push_back(ItemType(30));
+    for (size_t index = 0; index < vec.size(); index++)
+        assert(vec[index] == ItemType((index + 1) * 10));
 
-    Vector<ItemType> vec_;
+    std::cout << "SUCCESS" << std::endl;
+}
 
-    vec_.push_back(ItemType(100));
-    vec_.push_back(ItemType(200));
+// Run only once, the element type is fixed.
+void relocation_copy_test() {
+    std::cout << "Vector relocation copies -> ";
 
-    vec.swap(vec_);
+    Vector<CopyCounter> vec;
 
-    assert(vec.size() == 2 && vec_.size() == 3);
+    CopyCounter::copies = 0;
 
-    assert(vec[0] == ItemType(100) && vec[1] == ItemType(200));
-    assert(vec_[0] == ItemType(10) && vec_[1] == ItemType(20) && vec_[2] == ItemType(30));
+    for (size_t index = 0; index < 1000; index++)
+        vec.push_back(CopyCounter(index));
 
-    std::cout << "SUCCESS" << std::endl;
-}
+    for (size_t index = 0; index < 1000; index++)
+        vec.emplace_back(index);
 
-template <typename ItemType>
-void modifiers_tests() {
-    clear_test<ItemType>();
+    vec.insert(vec.begin(), CopyCounter(-1));
+    vec.erase(vec.begin());
 
-    insert_tests<ItemType>();
-    erase_tests<ItemType>();
+    // Growth and shifting relocate the elements by moving them.
+    assert(CopyCounter::copies == 0);
 
-    push_back_test<ItemType>();
-    pop_back_test<ItemType>();
+    for (size_t index = 0; index < 1000; index++)
+        assert(vec[index].get_id() == int(index));
 
-    std::cout << std::endl;
-    
-    resize_test<ItemType>();
-    swap_test<ItemType>();
-    
-    std::cout << std::endl;
+    std::cout << "SUCCESS" << std::endl;
 }
 
-template <typename ItemType>
-void equal_test() {
-    std::cout << "Vector::operator==(const Vector& other) -> ";
+// Run only once, the element type is fixed.
+void trivially_relocatable_test() {
+    std::cout << "Vector relocation of trivially relocatable types -> ";
 
-    Vector<ItemType> vec;
-    Vector<ItemType> vec_;
+    assert((is_trivially_relocatable<Pair<int, int>>::value == true));
+    assert((is_trivially_relocatable<Pair<int, CopyCounter>>::value == false));
 
-    assert(vec == vec_);
+    Vector<Pair<int, int>> vec;
 
-    vec.push_back(10);
-    vec_.push_back(10);
+    for (int index = 0; index < 100; index++)
+        vec.emplace_back(index, -index);
 
-    assert(vec == vec_);
+    vec.insert(vec.begin() + 10, Pair<int, int>(1000, 1000));
+
+    assert(vec[10].first == 1000 && vec[11].first == 10);
 
     vec.erase(vec.begin());
-    vec_.erase(vec_.begin());
 
-    assert(vec == vec_);
+    assert(vec.size() == 100);
+    assert(vec[0].first == 1 && vec[0].second == -1);
+    assert(vec[9].first == 1000 && vec[99].first == 99);
 
     std::cout << "SUCCESS" << std::endl;
 }
 
-template <typename ItemType>
-void not_equal_test() {
-    std::cout << "Vector::operator!=(const Vector& other) -> ";
+void simd_compare_test() {
+    std::cout << "Vector comparison of integral items -> ";
 
-    Vector<ItemType> vec;
-    Vector<ItemType> vec_;
+    Vector<uint8_t> bytes(size_t(1000), uint8_t(0));
+    Vector<uint8_t> bytes_(bytes);
 
-    assert(!(vec != vec_));
+    assert(bytes == bytes_ && bytes <= bytes_ && bytes >= bytes_);
 
-    vec.push_back(10);
-    vec_.push_back(10);
+    for (size_t index = 0; index < bytes.size(); index += 37) {
+        bytes_[index] = 200;
 
-    assert(!(vec != vec_));
+        assert(bytes != bytes_ && bytes < bytes_ && bytes_ > bytes);
 
-    vec.erase(vec.begin());
-    vec_.erase(vec_.begin());
+        bytes_[index] = 0;
+    }
 
-    assert(!(vec != vec_));
+    Vector<int> keys(size_t(100), 5);
+    Vector<int> keys_(keys);
+
+    keys_[77] = -1;
+
+    assert(keys_ < keys && keys > keys_);
+
+    keys_[77] = 5;
+    keys_.pop_back();
+
+    assert(keys_ < keys && keys_ != keys);
 
     std::cout << "SUCCESS" << std::endl;
 }
 
-template <typename ItemType>
-void less_test() {
-    std::cout << "Vector::operator<(const Vector& other) -> ";
-
-    Vector<ItemType> vec;
-    Vector<ItemType> vec_;
+void parallel_algorithms_test() {
+    std::cout << "Parallel algorithms over Vector -> ";
 
-    assert(!(vec < vec_) && !(vec_ < vec));
+    ThreadPool pool(3);
 
-    vec.push_back(10);
-    vec_.push_back(20);
+    Vector<long> vec;
+    Vector<long> vec_;
 
-    assert(vec < vec_);
+    vec.resize(100000);
+    vec_.resize(100000);
 
-    vec.erase(vec.begin());
-    vec.push_back(100);
+    parallel_fill(vec.begin(), vec.end(), 2L, 0, pool);
+    parallel_transform(vec.begin(), vec.end(), vec_.begin(), [](long item) { return item * 3; }, 1000, pool);
+    parallel_for_each(vec_.begin(), vec_.end(), [](long& item) { item++; }, 0, pool);
 
-    assert(vec_ < vec);
+    assert(parallel_reduce(vec_.begin(), vec_.end(), 10L, [](long first, long second) { return first + second; }, 0, pool) == 700010);
 
-    vec.clear();
+    parallel_copy(vec_.begin(), vec_.end(), vec.begin(), 0, pool);
 
-    assert(vec < vec_);
+    assert(vec == vec_);
 
     std::cout << "SUCCESS" << std::endl;
 }
 
-template <typename ItemType>
-void greater_test() {
-    std::cout << "Vector::operator>(const Vector& other) -> ";
+void simd_search_test() {
+    std::cout << "Searching Vector of arithmetic items -> ";
 
-    Vector<ItemType> vec;
-    Vector<ItemType> vec_;
+    Vector<int16_t> vec;
 
-    assert(!(vec > vec_) && !(vec_ > vec));
+    for (int index = 0; index < 1000; index++)
+        vec.push_back(int16_t(index % 100));
 
-    vec.push_back(10);
-    vec_.push_back(20);
+    assert(simd_find(vec.begin(), vec.end(), 42) == vec.begin() + 42);
+    assert(simd_find(vec.begin() + 43, vec.end(), 42) == vec.begin() + 142);
+    assert(simd_find(vec.begin(), vec.end(), 100) == vec.end());
+    assert(simd_count(vec.begin(), vec.end(), 7) == 10);
+    assert(simd_contains(vec.begin(), vec.end(), 99) && !simd_contains(vec.begin(), vec.end(), -1));
 
-    assert(vec_ > vec);
+    vec[500] = -3;
+    vec[700] = -3;
+    vec[900] = 300;
+
+    assert(simd_min_element(vec.begin(), vec.end()) == vec.begin() + 500);
+    assert(simd_max_element(vec.begin(), vec.end()) == vec.begin() + 900);
+
+    Vector<double> reals;
+
+    for (int index = 0; index < 100; index++)
+        reals.push_back(index * 0.5);
+
+    reals[0] = 0.0 / 0.0;
+
+    Pair<Vector<double>::iterator, Vector<double>::iterator> extremes = simd_minmax(reals.begin(), reals.end());
+
+    assert(*extremes.first == 0.5 && *extremes.second == 49.5);
+    assert(simd_minmax(reals.end(), reals.end()).first == reals.end());
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void mapped_vector_test() {
+    std::cout << "MappedVector persisted to a file -> ";
+
+    const std::string path = "/tmp/mapped_vector_test.bin";
+
+    unlink(path.c_str());
+
+    {
+        MappedVector<uint32_t> vec(path);
+
+        assert(vec.empty() == true);
+
+        for (uint32_t index = 0; index < 10000; index++)
+            vec.push_back(index * 3);
+
+        assert(vec.size() == 10000 && vec.capacity() >= 10000);
+
+        vec.sync();
+    }
+
+    {
+        const MappedVector<uint32_t> vec(path, true);
+
+        assert(vec.size() == 10000);
+        assert(vec.front() == 0 && vec.back() == 29997 && vec.at(5000) == 15000);
+
+        uint32_t expected = 0;
+
+        for (auto it = vec.begin(); it != vec.end(); it++, expected += 3)
+            assert(*it == expected);
+    }
+
+    {
+        MappedVector<uint32_t> vec(path);
+
+        vec.resize(5);
+        vec.shrink_to_fit();
+        vec.push_back(vec[4]);
+
+        assert(vec.size() == 6 && vec[5] == 12);
+    }
+
+    unlink(path.c_str());
+
+    {
+        // Items larger than a page leave an empty vector without capacity.
+        struct Block {
+            uint32_t words[2048];
+        };
+
+        MappedVector<Block> vec(path);
+
+        vec.shrink_to_fit();
+
+        assert(vec.capacity() == 0);
+
+        Block block;
+
+        block.words[0] = 1;
+        block.words[2047] = 2;
+
+        vec.push_back(block);
+        vec.push_back(vec[0]);
+
+        assert(vec.size() == 2 && vec.capacity() >= 2 && vec[1].words[0] == 1 && vec[1].words[2047] == 2);
+    }
+
+    bool thrown = false;
+
+    try {
+        MappedVector<uint64_t> vec(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+
+    assert(thrown == true);
+
+    unlink(path.c_str());
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+struct StringCodec {
+    void encode(const std::string& item, Vector<char>& bytes) {
+        uint32_t size = static_cast<uint32_t>(item.size());
+
+        bytes.insert(bytes.end(), reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size) + sizeof(size));
+        bytes.insert(bytes.end(), item.begin(), item.end());
+    }
+
+    const char* decode(const char* first, const char* last, std::string& item) {
+        uint32_t size;
+
+        if (last - first < static_cast<ptrdiff_t>(sizeof(size)))
+            return nullptr;
+
+        memcpy(&size, first, sizeof(size));
+        first += sizeof(size);
+
+        item.assign(first, size);
+
+        return first + size;
+    }
+};
+
+void serialize_test() {
+    std::cout << "Vector binary snapshots -> ";
+
+    Vector<double> vec;
+
+    for (int index = 0; index < 5000; index++)
+        vec.push_back(index * 0.25);
+
+    std::stringstream stream;
+
+    write_to(stream, vec);
+
+    Vector<double> vec_(size_t(3), 1.0);
+
+    read_from(stream, vec_);
+
+    assert(vec_ == vec);
+
+    const std::string path = "/tmp/serialize_test.bin";
+
+    int descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    write_to(descriptor, vec);
+    lseek(descriptor, 0, SEEK_SET);
+
+    Vector<double> vec_fd;
+
+    read_from(descriptor, vec_fd);
+
+    assert(vec_fd == vec);
+
+    close(descriptor);
+    unlink(path.c_str());
+
+    Vector<std::string> words;
+
+    for (int index = 0; index < 20000; index++)
+        words.push_back(std::string(index % 13, 'a' + index % 26));
+
+    std::stringstream chunks;
+
+    write_to(chunks, words, StringCodec());
+
+    Vector<std::string> words_;
+
+    read_from(chunks, words_, StringCodec());
+
+    assert(words_.size() == words.size() && words_[19999] == words[19999] && words_[12] == words[12]);
+
+    bool thrown = false;
+
+    try {
+        Vector<float> floats;
+
+        stream.clear();
+        stream.seekg(0);
+
+        read_from(stream, floats);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+
+    assert(thrown == true);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void concurrent_vector_test() {
+    std::cout << "ConcurrentVector appended from many threads -> ";
+
+    ConcurrentVector<int> vec;
+    Vector<std::thread> threads;
+
+    for (int thread = 0; thread < 4; thread++)
+        threads.emplace_back([&vec, thread]() {
+            for (int index = 0; index < 10000; index++)
+                vec.push_back(thread * 10000 + index);
+
+            Pair<ConcurrentVector<int>::iterator, ConcurrentVector<int>::iterator> range = vec.grow_by(100);
+
+            for (auto it = range.first; it != range.second; it++)
+                *it = -1;
+        });
+
+    for (auto it = threads.begin(); it != threads.end(); it++)
+        it->join();
+
+    assert(vec.size() == 40400);
+
+    Vector<bool> seen(size_t(40000), false);
+    size_t filler = 0;
+
+    for (auto it = vec.begin(); it != vec.end(); it++) {
+        if (*it == -1) {
+            filler++;
+        } else {
+            assert(seen[*it] == false);
+
+            seen[*it] = true;
+        }
+    }
+
+    assert(filler == 400);
+
+    int& first = vec[0];
+
+    vec.grow_by(100000, 7);
+
+    assert(&first == &vec[0] && vec.at(140399) == 7);
+
+    // Readers running alongside the appends only see constructed items.
+    struct Twice {
+        int value;
+        int twice;
+
+        Twice(int value) noexcept : value(value), twice(2 * value) {}
+    };
+
+    ConcurrentVector<Twice> checked;
+    std::atomic<bool> done(false);
+
+    std::thread reader([&checked, &done]() {
+        while (done.load() == false) {
+            size_t size = checked.size();
+
+            for (size_t index = 0; index < size; index++)
+                assert(checked.at(index).twice == 2 * checked[index].value);
+
+            for (auto it = checked.begin(); it != checked.end(); it++)
+                assert(it->twice == 2 * it->value);
+
+            std::this_thread::yield();
+        }
+    });
+
+    threads.clear();
+
+    for (int thread = 0; thread < 3; thread++)
+        threads.emplace_back([&checked, thread]() {
+            for (int index = 0; index < 20000; index++)
+                checked.emplace_back(thread * 20000 + index);
+        });
+
+    for (auto it = threads.begin(); it != threads.end(); it++)
+        it->join();
+
+    done.store(true);
+    reader.join();
+
+    assert(checked.size() == 60000);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void stable_vector_test() {
+    std::cout << "StableVector keeps items in place -> ";
+
+    StableVector<long, 64> vec;
+
+    vec.push_back(1);
+
+    long* first = &vec.front();
+
+    for (long index = 1; index < 10000; index++)
+        vec.push_back(vec[index - 1] + 1);
+
+    assert(first == &vec[0] && vec.size() == 10000 && vec.back() == 10000);
+    assert(vec.capacity() == 10048);
+
+    long sum = 0;
+
+    for (auto it = vec.begin(); it != vec.end(); it++)
+        sum += *it;
+
+    assert(sum == 50005000);
+
+    StableVector<long, 64> copy(vec);
+
+    assert(copy == vec);
+
+    copy.resize(100);
+    copy.shrink_to_fit();
+
+    assert(copy.size() == 100 && copy.capacity() == 128 && copy != vec);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void deque_test() {
+    std::cout << "Deque, and Stack and Queue on top of it -> ";
+
+    Deque<int, 8> deque;
+
+    for (int index = 0; index < 100; index++) {
+        deque.push_back(index);
+        deque.push_front(-index - 1);
+    }
+
+    assert(deque.size() == 200 && deque.front() == -100 && deque.back() == 99);
+
+    for (size_t index = 0; index < deque.size(); index++)
+        assert(deque[index] == static_cast<int>(index) - 100);
+
+    int* middle = &deque[100];
+
+    for (int index = 0; index < 50; index++) {
+        deque.pop_front();
+        deque.pop_back();
+    }
+
+    assert(middle == &deque[50] && *middle == 0 && deque.end() - deque.begin() == 100);
+
+    Stack<int, Deque<int>> stack;
+
+    for (int index = 0; index < 1000; index++)
+        stack.push(index);
+
+    stack.pop();
+
+    assert(stack.size() == 999 && stack.top() == 998);
+
+    // Deque has no reserve(), the Stack does without it.
+    Vector<int> more;
+
+    for (int index = 0; index < 100; index++)
+        more.push_back(1000 + index);
+
+    stack.reserve(2000);
+    stack.push_range(more.begin(), more.end());
+
+    assert(stack.size() == 1099 && stack.top() == 1099);
+
+    std::istringstream numbers("7 8 9");
+    Stack<int> vector_stack;
+
+    vector_stack.push_range(std::istream_iterator<int>(numbers), std::istream_iterator<int>());
+    vector_stack.push_range(more.begin(), more.end());
+
+    assert(vector_stack.size() == 103 && vector_stack.top() == 1099);
+
+    Queue<int> queue;
+
+    for (int index = 0; index < 1000; index++)
+        queue.push(index);
+
+    for (int index = 0; index < 500; index++) {
+        assert(queue.front() == index);
+
+        queue.pop();
+    }
+
+    assert(queue.size() == 500 && queue.front() == 500 && queue.back() == 999);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void soa_vector_test() {
+    std::cout << "SoAVector stores one array per field -> ";
+
+    SoAVector<int, double, char> records;
+
+    for (int index = 0; index < 1000; index++)
+        records.emplace_back(index, index * 2.0, char('a' + index % 26));
+
+    records.push_back(std::make_tuple(-1, 0.5, 'z'));
+
+    assert(records.size() == 1001 && records.capacity() >= 1001);
+    assert(std::get<0>(records.back()) == -1 && std::get<2>(records[27]) == 'b');
+
+    ColumnSpan<double> values = records.column<1>();
+
+    assert(values.size() == 1001 && &values[1] == values.data() + 1);
+
+    double sum = 0;
+
+    for (auto it = values.begin(); it != values.end(); it++)
+        sum += *it;
+
+    assert(sum == 999000.5);
+
+    for (auto it = records.begin(); it != records.end(); it++)
+        std::get<0>(*it) *= 2;
+
+    assert(records.column<0>()[500] == 1000);
+
+    SoAVector<int, double, char> copy(records);
+
+    copy.pop_back();
+
+    assert(copy.size() == 1000 && std::get<1>(copy.at(999)) == 1998.0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void concurrent_stack_test() {
+    std::cout << "ConcurrentStack pushed and popped from many threads -> ";
+
+    ConcurrentStack<int> stack;
+    Vector<std::thread> threads;
+    std::atomic<long> popped_sum(0);
+    std::atomic<int> popped_count(0);
+
+    for (int thread = 0; thread < 4; thread++)
+        threads.emplace_back([&, thread]() {
+            long sum = 0;
+            int count = 0;
+            int value;
+
+            for (int index = 0; index < 10000; index++) {
+                stack.push(thread * 10000 + index);
+
+                if (index % 2 == 1 && stack.pop(value)) {
+                    sum += value;
+                    count++;
+                }
+            }
+
+            popped_sum += sum;
+            popped_count += count;
+        });
+
+    for (auto it = threads.begin(); it != threads.end(); it++)
+        it->join();
+
+    Vector<int> rest(size_t(40000), 0);
+    auto rest_end = stack.pop_all(rest.begin());
+
+    long sum = popped_sum;
+
+    for (auto it = rest.begin(); it != rest_end; it++)
+        sum += *it;
+
+    assert(stack.empty() && popped_count + int(rest_end - rest.begin()) == 40000);
+    assert(sum == 40000L * 39999 / 2);
+
+    int values[] = {1, 2, 3};
+    int value;
+
+    stack.push_range(values, values + 3);
+
+    assert(stack.top() == 3);
+    assert(stack.pop(value) && value == 3 && stack.pop(value) && value == 2);
+    assert(stack.pop() && !stack.pop() && stack.empty());
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void stack_move_test() {
+    std::cout << "Stack moves, emplaces and transfers ranges -> ";
+
+    Stack<std::string> stack;
+    std::string frame(100, 'f');
+    const char* data = frame.data();
+
+    stack.reserve(16);
+    stack.push(std::move(frame));
+    stack.emplace(size_t(3), 'e');
+
+    assert(stack.size() == 2 && stack.top() == "eee");
+    assert(stack.pop_value() == "eee" && stack.top().data() == data);
+
+    std::string values[] = {"a", "b", "c"};
+
+    stack.push_range(values, values + 3);
+
+    Stack<std::string> moved(std::move(stack));
+
+    assert(stack.empty() && moved.size() == 4 && moved.top() == "c");
+
+    std::string out[3];
+
+    assert(moved.pop_n(2, out) == out + 2 && out[0] == "c" && out[1] == "b");
+
+    Stack<std::string> copied(moved);
+
+    stack = std::move(moved);
+    moved = copied;
+
+    assert(stack.size() == 2 && moved.size() == 2 && stack.top() == "a" && moved.top() == "a");
+    assert(stack.pop_value() == "a" && stack.top().data() == data);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void work_stealing_deque_test() {
+    std::cout << "WorkStealingDeque popped by its owner and stolen from -> ";
+
+    WorkStealingDeque<int> deque(4);
+    static std::atomic<int> taken[50000];
+    std::atomic<bool> done(false);
+    Vector<std::thread> thieves;
+
+    for (int index = 0; index < 50000; index++)
+        taken[index].store(0);
+
+    for (int thread = 0; thread < 3; thread++)
+        thieves.emplace_back([&]() {
+            int value;
+
+            while (!done.load() || !deque.empty())
+                if (deque.steal(value))
+                    taken[value]++;
+        });
+
+    int value;
+
+    for (int index = 0; index < 50000; index++) {
+        deque.push(index);
+
+        if (index % 3 == 2 && deque.pop(value))
+            taken[value]++;
+    }
+
+    while (deque.pop(value))
+        taken[value]++;
+
+    done.store(true);
+
+    for (auto it = thieves.begin(); it != thieves.end(); it++)
+        it->join();
+
+    for (int index = 0; index < 50000; index++)
+        assert(taken[index].load() == 1);
+
+    assert(deque.empty() && !deque.steal(value) && !deque.pop(value));
+
+    deque.push(1);
+    deque.push(2);
+
+    assert(deque.top() == 2 && deque.size() == 2);
+    assert(deque.steal(value) && value == 1 && deque.pop(value) && value == 2);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+constexpr int static_vector_constexpr_sum() {
+    StaticVector<int, 8> vec = {4, 1, 3};
+
+    vec.insert(vec.begin() + 1, 2, 7);
+    vec.erase(vec.begin());
+    vec.push_back(5);
+
+    StaticStack<int, 4> stack;
+
+    stack.push(vec.front());
+    stack.push(vec.back());
+
+    int sum = stack.pop_value() * 100 + stack.top();
+
+    for (auto it = vec.begin(); it != vec.end(); it++)
+        sum += *it;
+
+    return sum;
+}
+
+void static_vector_test() {
+    std::cout << "StaticVector and StaticStack keep items inline -> ";
+
+    static_assert(static_vector_constexpr_sum() == 500 + 7 + 7 + 7 + 1 + 3 + 5, "constexpr StaticVector");
+
+    StaticVector<std::string, 6> vec(size_t(2), std::string("b"));
+
+    vec.insert(vec.begin(), std::string("a"));
+    vec.emplace(vec.end(), size_t(2), 'c');
+
+    std::string more[] = {"x", "y"};
+
+    vec.insert(vec.begin() + 1, more, more + 2);
+
+    assert(vec.size() == 6 && vec.full());
+    assert(vec[0] == "a" && vec[1] == "x" && vec[2] == "y" && vec[3] == "b" && vec.back() == "cc");
+
+    bool thrown = false;
+
+    try {
+        vec.push_back("z");
+    } catch (const std::length_error&) {
+        thrown = true;
+    }
+
+    assert(thrown && vec.size() == 6);
+
+    vec.erase(vec.begin() + 1, vec.begin() + 3);
+
+    StaticVector<std::string, 6> copy(vec);
+    StaticVector<std::string, 6> other = {"q"};
+
+    other.swap(copy);
+
+    assert(other == vec && copy.size() == 1 && copy[0] == "q" && vec < copy);
+
+    vec.assign(size_t(3), std::string("r"));
+    other = std::move(vec);
+
+    assert(other.size() == 3 && other.at(2) == "r");
+
+    StaticStack<std::string, 4> stack;
+
+    stack.emplace(size_t(3), 's');
+    stack.push("t");
+
+    assert(stack.pop_value() == "t" && stack.top() == "sss" && sizeof(stack) < 4 * sizeof(std::string) + 2 * sizeof(size_t));
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename Mode>
+void ring_queue_threads_test(int producers, int consumers) {
+    RingQueue<long, Mode> queue(64);
+    Vector<std::thread> threads;
+    std::atomic<long> sum(0);
+    std::atomic<int> remaining(producers * 20000);
+
+    for (int thread = 0; thread < producers; thread++)
+        threads.emplace_back([&, thread]() {
+            long batch[8];
+
+            long last = (thread + 1) * 20000L;
+
+            for (long next = thread * 20000L; next < last; ) {
+                for (int index = 0; index < 8; index++)
+                    batch[index] = next + index;
+
+                size_t count = (next % 3 == 0 && last - next >= 8) ? 8 : 1;
+
+                size_t pushed = (count == 1) ? queue.try_push(batch[0]) : queue.push_n(batch, count);
+
+                if (pushed == 0)
+                    std::this_thread::yield();
+
+                next += pushed;
+            }
+        });
+
+    for (int thread = 0; thread < consumers; thread++)
+        threads.emplace_back([&]() {
+            long batch[8];
+
+            while (remaining.load() > 0) {
+                size_t popped = queue.pop_n(8, batch);
+
+                if (popped == 0)
+                    std::this_thread::yield();
+
+                for (size_t index = 0; index < popped; index++)
+                    sum += batch[index];
+
+                remaining -= int(popped);
+            }
+        });
+
+    for (auto it = threads.begin(); it != threads.end(); it++)
+        it->join();
+
+    long total = producers * 20000L;
+
+    assert(queue.empty() && sum.load() == total * (total - 1) / 2);
+}
+
+void ring_queue_test() {
+    std::cout << "RingQueue single threaded, SPSC and MPMC -> ";
+
+    RingQueue<std::string> local(5);
+    std::string value;
+
+    assert(local.capacity() == 8 && local.empty());
+
+    for (int index = 0; index < 8; index++)
+        assert(local.try_emplace(size_t(index + 1), 'a'));
+
+    assert(!local.try_push("full") && local.size() == 8);
+    assert(local.try_pop(value) && value == "a" && local.try_push("tail"));
+
+    std::string out[8];
+
+    assert(local.pop_n(8, out) == 8 && out[0] == "aa" && out[7] == "tail" && !local.try_pop(value));
+
+    std::string more[] = {"x", "y", "z"};
+
+    assert(local.push_n(more, 3) == 3 && local.pop_n(2, out) == 2 && out[1] == "y");
+
+    ring_queue_threads_test<SingleProducerSingleConsumer>(1, 1);
+    ring_queue_threads_test<MultiProducerMultiConsumer>(2, 2);
+
+    RingQueue<std::string, MultiProducerMultiConsumer> shared(2);
+
+    assert(shared.try_push(more[0]) && shared.try_emplace(size_t(2), 'w') && !shared.try_push("full"));
+    assert(shared.try_pop(value) && value == "x" && shared.size() == 1);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void sort_test() {
+    std::cout << "Sorting Vector -> ";
+
+    ThreadPool pool(3);
+
+    Vector<Pair<int, int>> vec;
+
+    for (int index = 0; index < 100000; index++)
+        vec.emplace_back((index * 7919) % 1000, index);
+
+    Vector<Pair<int, int>> vec_(vec);
+
+    auto by_key = [](const Pair<int, int>& first, const Pair<int, int>& second) { return first.first < second.first; };
+
+    parallel_stable_sort(vec.begin(), vec.end(), by_key, pool);
+
+    for (size_t index = 1; index < vec.size(); index++)
+        assert(vec[index - 1].first < vec[index].first ||
+            (vec[index - 1].first == vec[index].first && vec[index - 1].second < vec[index].second));
+
+    parallel_sort(vec_.begin(), vec_.end(), by_key, pool);
+
+    for (size_t index = 1; index < vec_.size(); index++)
+        assert(vec_[index - 1].first <= vec_[index].first);
+
+    // Items whose moved-from state compares differently, a merge reading a moved-from run would misplace them.
+    Vector<std::string> words;
+
+    for (int index = 0; index < 50000; index++) {
+        std::string digits = std::to_string((index * 7919) % 50000);
+
+        words.push_back("sorted-item-" + std::string(5 - digits.size(), '0') + digits);
+    }
+
+    Vector<std::string> words_(words);
+
+    parallel_stable_sort(words.begin(), words.end(), Less<std::string>(), pool);
+    parallel_sort(words_.begin(), words_.end(), Less<std::string>(), pool);
+
+    for (int index = 0; index < 50000; index++) {
+        std::string digits = std::to_string(index);
+        std::string expected = "sorted-item-" + std::string(5 - digits.size(), '0') + digits;
+
+        assert(words[index] == expected && words_[index] == expected);
+    }
+
+    Vector<int> small;
+
+    for (int index = 0; index < 100; index++)
+        small.push_back(100 - index);
+
+    introsort(small.begin(), small.end());
+
+    for (int index = 0; index < 100; index++)
+        assert(small[index] == index + 1);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void arena_allocator_test() {
+    std::cout << "Vector with ArenaAllocator -> ";
+
+    Arena arena(64);
+
+    for (int round = 0; round < 2; round++) {
+        {
+            Vector<int, ArenaAllocator<int>> vec{ArenaAllocator<int>(arena)};
+
+            for (int index = 0; index < 1000; index++)
+                vec.push_back(index);
+
+            Vector<int, ArenaAllocator<int>> copy(vec);
+
+            assert(copy.get_allocator() == vec.get_allocator());
+            assert(copy.size() == 1000 && copy[999] == 999);
+        }
+
+        arena.reset();
+    }
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void tree_arena_allocator_test() {
+    std::cout << "Tree, KeyTree and Map with ArenaAllocator -> ";
+
+    typedef ArenaAllocator<Pair<int, int>> PairAllocator;
+
+    const int values[] = {50, 25, 75, 10, 30, 60, 90};
+
+    Arena arena(64);
+
+    for (int round = 0; round < 2; round++) {
+        {
+            Tree<int, ArenaAllocator<int>> tree{ArenaAllocator<int>(arena)};
+
+            for (int value : values)
+                tree.insert(value);
+
+            Tree<int, ArenaAllocator<int>> tree_copy(tree);
+
+            assert(tree_copy.get_allocator() == tree.get_allocator());
+
+            int count = 0;
+            for (auto it = tree_copy.cbegin(); it != tree_copy.cend(); it++)
+                count++;
+
+            assert(count == 7);
+
+            tree_copy.erase(10);
+            tree_copy.erase(75);
+
+            assert(tree_copy.search(10) == nullptr && tree_copy.search(75) == nullptr);
+            assert(tree_copy.search(90) != nullptr && tree.search(10) != nullptr);
+
+            tree = tree_copy;
+
+            assert(tree.search(75) == nullptr && tree.search(60) != nullptr);
+
+            KeyTree<int, int, NodeCompare<int>, ArenaAllocator<int>> key_tree{ArenaAllocator<int>(arena)};
+
+            for (int value : values)
+                key_tree.insert(value, 2 * value);
+
+            KeyTree<int, int, NodeCompare<int>, ArenaAllocator<int>> key_tree_copy(key_tree);
+
+            assert(key_tree_copy.search(30)->value == 60);
+
+            key_tree_copy.erase(30);
+
+            assert(key_tree_copy.search(30) == nullptr && key_tree.search(30) != nullptr);
+
+            key_tree = key_tree_copy;
+
+            assert(key_tree.search(30) == nullptr && key_tree.search(90)->value == 180);
+
+            Map<int, int, NodeCompare<int>, PairAllocator> map{PairAllocator(arena)};
+
+            for (int value : values)
+                map[value] = value + 1;
+
+            Map<int, int, NodeCompare<int>, PairAllocator> map_copy(map);
+
+            assert(map_copy.size() == 7 && map_copy.at(60) == 61);
+            assert(map_copy.erase(60) == 1 && map_copy.count(60) == 0 && map.count(60) == 1);
+
+            assert(&(map = map_copy) == &map);
+            assert(map.size() == 6 && map.count(60) == 0 && map.at(90) == 91);
+        }
+
+        arena.reset();
+    }
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void pop_back_test() {
+    std::cout << "Vector::pop_back() -> ";
+
+    Vector<ItemType> vec;
+
+    vec.push_back(ItemType(10));
+
+    vec.pop_back();
+
+    assert(vec.empty() == true);
+    assert(vec.size() == 0);
+
+    for (size_t index = 0; index < 100; index++)
+        vec.push_back(ItemType(index));
+
+    size_t count = 100;
+    while (count--) {
+        vec.pop_back();
+
+        assert(vec.size() == count);
+    }
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void resize_test() {
+    std::cout << "Vector::resize(size_t count, const ItemType& value) -> ";
+
+    Vector<ItemType> vec;
+
+    vec.resize(100, ItemType(10));
+
+    assert(vec.size() == 100);
+    assert(vec.capacity() > 100);
+
+    for (auto it = vec.cbegin(); it != vec.cend(); it++)
+        assert(*it == ItemType(10));
+
+    vec.resize(10, ItemType(10));
+
+    assert(vec.size() == 10);
+
+    for (auto it = vec.cbegin(); it != vec.cend(); it++)
+        assert(*it == ItemType(10));
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void default_init_resize_test() {
+    std::cout << "Vector::resize(size_t count, default_init_t) -> ";
+
+    Vector<ItemType> vec;
+
+    vec.resize(50);
+
+    assert(vec.size() == 50);
+
+    for (auto it = vec.cbegin(); it != vec.cend(); it++)
+        assert(*it == ItemType());
+
+    vec.resize(100, default_init);
+
+    assert(vec.size() == 100 && vec.capacity() >= 100);
+
+    vec[99] = ItemType(10);
+
+    assert(vec[0] == ItemType() && vec[99] == ItemType(10));
+
+    vec.resize(20, default_init);
+
+    assert(vec.size() == 20);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void resize_uninitialized_test() {
+    std::cout << "Vector::resize_uninitialized(size_t count) -> ";
+
+    Vector<char> buffer;
+
+    buffer.resize_uninitialized(4096);
+
+    assert(buffer.size() == 4096 && buffer.capacity() >= 4096);
+
+    for (size_t index = 0; index < buffer.size(); index++)
+        buffer[index] = char(index % 100);
+
+    buffer.resize_uninitialized(10);
+
+    assert(buffer.size() == 10 && buffer[9] == 9);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void swap_test() {
+    std::cout << "Vector::swap(const Vector& other) -> ";
+
+    Vector<ItemType> vec;
+    
+    vec.push_back(ItemType(10));
+    vec.push_back(ItemType(20));
+    vec.push_back(ItemType(30));
+
+    Vector<ItemType> vec_;
+
+    vec_.push_back(ItemType(100));
+    vec_.push_back(ItemType(200));
+
+    vec.swap(vec_);
+
+    assert(vec.size() == 2 && vec_.size() == 3);
+
+    assert(vec[0] == ItemType(100) && vec[1] == ItemType(200));
+    assert(vec_[0] == ItemType(10) && vec_[1] == ItemType(20) && vec_[2] == ItemType(30));
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void modifiers_tests() {
+    clear_test<ItemType>();
+
+    insert_tests<ItemType>();
+    erase_tests<ItemType>();
+
+    push_back_test<ItemType>();
+    emplace_back_test<ItemType>();
+    emplace_test<ItemType>();
+    pop_back_test<ItemType>();
+
+    std::cout << std::endl;
+    
+    resize_test<ItemType>();
+    default_init_resize_test<ItemType>();
+    swap_test<ItemType>();
+    
+    std::cout << std::endl;
+}
+
+template <typename ItemType>
+void equal_test() {
+    std::cout << "Vector::operator==(const Vector& other) -> ";
+
+    Vector<ItemType> vec;
+    Vector<ItemType> vec_;
+
+    assert(vec == vec_);
+
+    vec.push_back(10);
+    vec_.push_back(10);
+
+    assert(vec == vec_);
+
+    vec.erase(vec.begin());
+    vec_.erase(vec_.begin());
+
+    assert(vec == vec_);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void not_equal_test() {
+    std::cout << "Vector::operator!=(const Vector& other) -> ";
+
+    Vector<ItemType> vec;
+    Vector<ItemType> vec_;
+
+    assert(!(vec != vec_));
+
+    vec.push_back(10);
+    vec_.push_back(10);
+
+    assert(!(vec != vec_));
+
+    vec.erase(vec.begin());
+    vec_.erase(vec_.begin());
+
+    assert(!(vec != vec_));
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void less_test() {
+    std::cout << "Vector::operator<(const Vector& other) -> ";
+
+    Vector<ItemType> vec;
+    Vector<ItemType> vec_;
+
+    assert(!(vec < vec_) && !(vec_ < vec));
+
+    vec.push_back(10);
+    vec_.push_back(20);
+
+    assert(vec < vec_);
+
+    vec.erase(vec.begin());
+    vec.push_back(100);
+
+    assert(vec_ < vec);
+
+    vec.clear();
+
+    assert(vec < vec_);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+template <typename ItemType>
+void greater_test() {
+    std::cout << "Vector::operator>(const Vector& other) -> ";
+
+    Vector<ItemType> vec;
+    Vector<ItemType> vec_;
+
+    assert(!(vec > vec_) && !(vec_ > vec));
+
+    vec.push_back(10);
+    vec_.push_back(20);
+
+    assert(vec_ > vec);
 
     vec.erase(vec.begin());
     vec.push_back(100);
@@ -2432,11 +3786,478 @@ void compare_tests() {
     greater_or_equal_test<ItemType>();
 }
 
+void insert_input_range_test() {
+    std::cout << "Vector::insert from a single pass range -> ";
+
+    std::istringstream stream("one two three");
+    Vector<std::string> vec;
+
+    vec.push_back("zero");
+    vec.push_back("four");
+
+    auto it = vec.insert(vec.begin() + 1, std::istream_iterator<std::string>(stream), std::istream_iterator<std::string>());
+
+    assert(it == vec.begin() + 1 && vec.size() == 5);
+    assert(vec[0] == "zero" && vec[1] == "one" && vec[2] == "two" && vec[3] == "three" && vec[4] == "four");
+
+    std::istringstream empty("");
+
+    vec.insert(vec.end(), std::istream_iterator<std::string>(empty), std::istream_iterator<std::string>());
+
+    assert(vec.size() == 5);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+/*
+ * Counts its live instances, its copy constructor throws once copies_left reaches 0 and its
+ * move constructor is not noexcept, so growing a Vector of them copies.
+ */
+struct ThrowingCopy {
+    static int live;
+    static int copies_left;
+
+    int value;
+
+    ThrowingCopy(int value) : value(value) {
+        live++;
+    }
+
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copies_left-- == 0)
+            throw std::runtime_error("copy");
+
+        live++;
+    }
+
+    ThrowingCopy(ThrowingCopy&& other) : value(other.value) {
+        live++;
+    }
+
+    ThrowingCopy& operator=(const ThrowingCopy& other) = default;
+    ThrowingCopy& operator=(ThrowingCopy&& other) = default;
+
+    ~ThrowingCopy() {
+        live--;
+    }
+};
+
+int ThrowingCopy::live = 0;
+int ThrowingCopy::copies_left = -1;
+
+void reallocate_exception_safety_test() {
+    std::cout << "Vector growth when an item copy throws -> ";
+
+    {
+        Vector<ThrowingCopy> vec;
+
+        for (int i = 0; vec.size() < 2 || vec.size() != vec.capacity(); i++)
+            vec.emplace_back(i);
+
+        size_t size = vec.size();
+        size_t capacity = vec.capacity();
+
+        // The new item is built, then the second relocated copy throws.
+        ThrowingCopy::copies_left = 2;
+
+        bool thrown = false;
+
+        try {
+            vec.push_back(vec[0]);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+
+        assert(thrown && vec.size() == size && vec.capacity() == capacity);
+        assert(ThrowingCopy::live == static_cast<int>(size));
+
+        // Building the new item throws.
+        ThrowingCopy::copies_left = 0;
+        thrown = false;
+
+        try {
+            vec.push_back(vec[0]);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+
+        assert(thrown && vec.size() == size && ThrowingCopy::live == static_cast<int>(size));
+
+        ThrowingCopy::copies_left = 1;
+        thrown = false;
+
+        try {
+            vec.reserve(2 * capacity);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+
+        assert(thrown && vec.size() == size && vec.capacity() == capacity);
+        assert(ThrowingCopy::live == static_cast<int>(size));
+
+        for (size_t i = 0; i < size; i++)
+            assert(vec[i].value == static_cast<int>(i));
+
+        ThrowingCopy::copies_left = -1;
+
+        vec.reserve(2 * capacity);
+
+        assert(vec.capacity() >= 2 * capacity && ThrowingCopy::live == static_cast<int>(size));
+    }
+
+    assert(ThrowingCopy::live == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void small_vector_test() {
+    std::cout << "SmallVector inline and heap storage -> ";
+
+    typedef SmallVector<std::string, 4> Small;
+
+    Small vec;
+
+    assert(vec.capacity() == 4 && vec.empty());
+
+    for (int i = 0; i < 4; i++)
+        vec.push_back(std::to_string(i));
+
+    assert(vec.capacity() == 4);
+
+    // Growing past the inline buffer moves the items to the heap.
+    vec.push_back(vec[0]);
+
+    assert(vec.size() == 5 && vec.capacity() > 4);
+    assert(vec[0] == "0" && vec[3] == "3" && vec[4] == "0");
+
+    vec.resize(2);
+    vec.shrink_to_fit();
+
+    assert(vec.size() == 2 && vec.capacity() == 4 && vec[1] == "1");
+
+    // Moves and swaps across the inline/heap boundary.
+    Small heap;
+
+    for (int i = 0; i < 10; i++)
+        heap.push_back(std::to_string(i));
+
+    Small moved(std::move(heap));
+
+    assert(moved.size() == 10 && heap.empty() && heap.capacity() == 4);
+
+    heap = std::move(vec);
+
+    assert(heap.size() == 2 && heap[0] == "0" && vec.empty());
+
+    heap.swap(moved);
+
+    assert(heap.size() == 10 && heap[9] == "9" && moved.size() == 2 && moved[1] == "1");
+
+    moved.swap(heap);
+
+    assert(moved.size() == 10 && heap.size() == 2);
+
+    heap = moved;
+
+    assert(heap == moved && heap.size() == 10);
+
+    // Range inserts, from a forward range and from a single pass one.
+    Small inserted;
+
+    inserted.push_back("a");
+    inserted.push_back("e");
+
+    std::vector<std::string> middle = {"b", "c"};
+
+    inserted.insert(inserted.begin() + 1, middle.begin(), middle.end());
+
+    std::istringstream stream("d");
+
+    auto it = inserted.insert(inserted.begin() + 3, std::istream_iterator<std::string>(stream), std::istream_iterator<std::string>());
+
+    assert(it == inserted.begin() + 3 && inserted.size() == 5);
+    assert(inserted[0] == "a" && inserted[1] == "b" && inserted[2] == "c" && inserted[3] == "d" && inserted[4] == "e");
+
+    inserted.resize(7, "f");
+
+    assert(inserted.size() == 7 && inserted[6] == "f");
+
+    // Comparisons.
+    Small shorter(inserted.begin(), inserted.begin() + 3);
+
+    assert(shorter < inserted && inserted > shorter && shorter <= inserted && inserted >= shorter);
+    assert(inserted <= inserted && inserted >= inserted && !(inserted < inserted));
+
+    SmallVector<int, 8> bytes;
+
+    bytes.resize_uninitialized(20);
+
+    assert(bytes.size() == 20 && bytes.capacity() >= 20);
+
+    bytes.resize(3);
+
+    assert(bytes.size() == 3);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+// MmapAllocator counting the calls Vector makes to reallocate().
+struct CountingMmapAllocator : public MmapAllocator<int> {
+    static int reallocations;
+
+    int* reallocate(int* start, size_t size, size_t new_size) {
+        reallocations++;
+
+        return MmapAllocator<int>::reallocate(start, size, new_size);
+    }
+};
+
+int CountingMmapAllocator::reallocations = 0;
+
+void mmap_allocator_reallocate_test() {
+    std::cout << "Vector growth through MmapAllocator::reallocate -> ";
+
+    Vector<int, CountingMmapAllocator> vec;
+
+    for (int i = 0; i < (1 << 20); i++)
+        vec.push_back(i);
+
+    // Every growth after the first block goes through mremap().
+    assert(CountingMmapAllocator::reallocations >= 3);
+
+    for (int i = 0; i < (1 << 20); i++)
+        assert(vec[i] == i);
+
+    int reallocations = CountingMmapAllocator::reallocations;
+
+    vec.reserve(vec.capacity() * 4);
+
+    assert(CountingMmapAllocator::reallocations == reallocations + 1);
+    assert(vec.size() == (1 << 20) && vec.front() == 0 && vec.back() == (1 << 20) - 1);
+
+    vec.shrink_to_fit();
+
+    assert(vec.capacity() == vec.size() && vec[12345] == 12345 && vec.back() == (1 << 20) - 1);
+
+    // Empty vectors hold no mapping, copying one maps nothing.
+    Vector<int, MmapAllocator<int>> empty;
+    Vector<int, MmapAllocator<int>> empty_copy(empty);
+
+    assert(empty_copy.empty());
+
+    empty_copy.push_back(1);
+    empty_copy = empty;
+
+    assert(empty_copy.empty());
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+// Whether the page at address is mapped, mincore() fails with ENOMEM on unmapped ranges.
+bool is_mapped(void* address) {
+    unsigned char resident;
+
+    return mincore(address, page_size(), &resident) == 0;
+}
+
+void huge_page_allocator_test() {
+    std::cout << "HugePageAllocator small and huge blocks -> ";
+
+    HugePageAllocator<int> allocator(1 << 16);
+
+    // Below the threshold blocks come from operator new, from it on they are aligned mappings.
+    int* small = allocator.allocate(100);
+    int* huge = allocator.allocate(1 << 14);
+
+    assert(reinterpret_cast<uintptr_t>(huge) % HUGE_PAGE_SIZE == 0);
+
+    small[99] = 1;
+    huge[(1 << 14) - 1] = 2;
+
+    allocator.deallocate(small, 100);
+    allocator.deallocate(huge, 1 << 14);
+
+    assert(is_mapped(huge) == false);
+
+    // A Vector grows from small blocks into huge ones, then through mremap().
+    Vector<int, HugePageAllocator<int>> low(allocator);
+
+    for (int i = 0; i < (1 << 20); i++)
+        low.push_back(i);
+
+    assert(reinterpret_cast<uintptr_t>(&low.front()) % HUGE_PAGE_SIZE == 0);
+
+    for (int i = 0; i < (1 << 20); i++)
+        assert(low[i] == i);
+
+    // Moving between unequal allocators takes the allocator along with the block.
+    Vector<int, HugePageAllocator<int>> high;
+
+    high.push_back(7);
+
+    assert(high.get_allocator() != low.get_allocator());
+
+    Vector<int, HugePageAllocator<int>> moved(std::move(low));
+
+    assert(moved.get_allocator() == allocator && moved.size() == (1 << 20));
+
+    high.swap(moved);
+
+    assert(high.get_allocator() == allocator && moved.get_allocator() != allocator);
+    assert(high.size() == (1 << 20) && moved.size() == 1 && moved[0] == 7);
+
+    int* block = &high.front();
+
+    moved = std::move(high);
+
+    assert(moved.get_allocator() == allocator && &moved.front() == block && moved.back() == (1 << 20) - 1);
+
+    moved.clear();
+    moved.shrink_to_fit();
+
+    assert(is_mapped(block) == false);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void soa_vector_exception_safety_test() {
+    std::cout << "SoAVector growth when a field copy throws -> ";
+
+    {
+        SoAVector<std::string, ThrowingCopy, int> vec;
+
+        for (int i = 0; vec.size() < 2 || vec.size() != vec.capacity(); i++)
+            vec.emplace_back(std::to_string(i), i, i);
+
+        size_t size = vec.size();
+        size_t capacity = vec.capacity();
+
+        std::string* strings = vec.column<0>().data();
+        int* ints = vec.column<2>().data();
+
+        ThrowingCopy::copies_left = 1;
+
+        bool thrown = false;
+
+        try {
+            vec.reserve(2 * capacity);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+
+        assert(thrown && vec.size() == size && vec.capacity() == capacity);
+        assert(ThrowingCopy::live == static_cast<int>(size));
+        assert(vec.column<0>().data() == strings && vec.column<2>().data() == ints);
+
+        // The columns before and after the throwing one are untouched.
+        for (size_t i = 0; i < size; i++)
+            assert(std::get<0>(vec[i]) == std::to_string(i) && std::get<1>(vec[i]).value == static_cast<int>(i) && std::get<2>(vec[i]) == static_cast<int>(i));
+
+        ThrowingCopy::copies_left = -1;
+
+        vec.emplace_back("last", -1, -1);
+
+        assert(vec.size() == size + 1 && std::get<0>(vec[0]) == "0" && std::get<1>(vec.back()).value == -1);
+        assert(ThrowingCopy::live == static_cast<int>(size + 1));
+    }
+
+    assert(ThrowingCopy::live == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+/*
+ * Inserts into the middle of vec while an item copy throws, and checks nothing changed.
+ */
+template <typename VectorType>
+void insert_exception_safety_check(VectorType& vec) {
+    for (int i = 0; i < 5; i++)
+        vec.emplace_back(i);
+
+    // Room for every insert below, so the gap is opened in place.
+    vec.reserve(32);
+
+    ThrowingCopy values[] = {ThrowingCopy(10), ThrowingCopy(11), ThrowingCopy(12)};
+    int live = ThrowingCopy::live;
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool thrown = false;
+
+        // The second copy of the range throws, then the third copy of the filled value.
+        ThrowingCopy::copies_left = (attempt == 0) ? 1 : 2;
+
+        try {
+            if (attempt == 0)
+                vec.insert(vec.begin() + 1, values, values + 3);
+            else
+                vec.insert(vec.begin() + 1, 3, values[0]);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+
+        assert(thrown && vec.size() == 5 && ThrowingCopy::live == live);
+
+        for (int i = 0; i < 5; i++)
+            assert(vec[i].value == i);
+    }
+
+    ThrowingCopy::copies_left = -1;
+
+    vec.insert(vec.begin() + 1, values, values + 3);
+
+    assert(vec.size() == 8 && vec[1].value == 10 && vec[3].value == 12 && vec[4].value == 1);
+}
+
+void insert_exception_safety_test() {
+    std::cout << "Vector::insert when an item copy throws -> ";
+
+    {
+        Vector<ThrowingCopy> vec;
+
+        insert_exception_safety_check(vec);
+    }
+
+    assert(ThrowingCopy::live == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void small_vector_insert_exception_safety_test() {
+    std::cout << "SmallVector::insert when an item copy throws -> ";
+
+    {
+        SmallVector<ThrowingCopy, 4> heap;
+        SmallVector<ThrowingCopy, 64> inline_items;
+
+        insert_exception_safety_check(heap);
+        insert_exception_safety_check(inline_items);
+    }
+
+    assert(ThrowingCopy::live == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
+void static_vector_insert_exception_safety_test() {
+    std::cout << "StaticVector::insert when an item copy throws -> ";
+
+    {
+        StaticVector<ThrowingCopy, 32> vec;
+
+        insert_exception_safety_check(vec);
+    }
+
+    assert(ThrowingCopy::live == 0);
+
+    std::cout << "SUCCESS" << std::endl;
+}
+
 template <typename ItemType>
 void run_test(bool is_dummy) {
     constructor_tests<ItemType>();
 
     copy_assignment_operator_test<ItemType>();
+    move_assignment_operator_test<ItemType>();
 
     assign_test<ItemType>();
     
@@ -2450,6 +4271,38 @@ void run_test(bool is_dummy) {
 
     modifiers_tests<ItemType>();
 
+    if (is_dummy == true) {
+        relocation_copy_test();
+        trivially_relocatable_test();
+        simd_compare_test();
+        resize_uninitialized_test();
+        arena_allocator_test();
+        tree_arena_allocator_test();
+        parallel_algorithms_test();
+        sort_test();
+        simd_search_test();
+        mapped_vector_test();
+        serialize_test();
+        concurrent_vector_test();
+        stable_vector_test();
+        deque_test();
+        soa_vector_test();
+        concurrent_stack_test();
+        stack_move_test();
+        work_stealing_deque_test();
+        static_vector_test();
+        ring_queue_test();
+        insert_input_range_test();
+        reallocate_exception_safety_test();
+        small_vector_test();
+        mmap_allocator_reallocate_test();
+        huge_page_allocator_test();
+        soa_vector_exception_safety_test();
+        insert_exception_safety_test();
+        small_vector_insert_exception_safety_test();
+        static_vector_insert_exception_safety_test();
+    }
+
     compare_tests<ItemType>();
 
     std::cout << std::endl;